@@ -0,0 +1,473 @@
+#include "../../client/source/modules/crypt.h"
+#include "../../client/source/modules/network.h"
+#include "../../client/source/modules/io.h"
+#include "../../client/source/modules/crc32c.h"
+#include "../../client/source/modules/log.h"
+#include <cryptopp/hex.h>
+#include <cryptopp/sha.h>
+#include <cryptopp/osrng.h>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <new>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+/**
+ * @file main.cpp
+ * @brief Микробенчмарки горячих путей клиента.
+ * @details Этот файл содержит замеры времени на операцию, пропускной способности
+ * и количества выделений памяти на операцию для чтения и записи файлов,
+ * криптографических операций и кодека обмена векторами через loopback.
+ * Результаты выводятся в формате JSON.
+ * @date 17.10.2026
+ * @version 1.0
+ * @authors Косов Р. С.
+ * @copyright ИБСТ ПГУ
+ */
+
+/// Счётчик выделений памяти во всей программе.
+static std::atomic<uint64_t> allocations(0);
+
+/**
+ * @brief Глобальный оператор выделения памяти с подсчётом вызовов.
+ * @param size Размер блока.
+ * @return Указатель на выделенный блок.
+ */
+void *operator new(size_t size)
+{
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    void *ptr = std::malloc(size ? size : 1);
+    if (ptr == nullptr)
+        throw std::bad_alloc();
+    return ptr;
+}
+
+/**
+ * @brief Глобальный оператор освобождения памяти.
+ * @param ptr Указатель на блок.
+ */
+void operator delete(void *ptr) noexcept
+{
+    std::free(ptr);
+}
+
+/**
+ * @brief Глобальный оператор освобождения памяти с размером.
+ * @param ptr Указатель на блок.
+ */
+void operator delete(void *ptr, size_t) noexcept
+{
+    std::free(ptr);
+}
+
+/**
+ * @brief Результат одного бенчмарка.
+ */
+struct BenchResult
+{
+    std::string name; ///< Имя бенчмарка.
+    uint64_t iterations; ///< Количество выполненных операций.
+    double ns_per_op; ///< Время на операцию в наносекундах.
+    double bytes_per_sec; ///< Пропускная способность в байтах в секунду.
+    double allocs_per_op; ///< Количество выделений памяти на операцию.
+};
+
+/**
+ * @brief Класс для запуска бенчмарков и сбора результатов.
+ */
+class BenchRunner
+{
+public:
+    /**
+     * @brief Конструктор класса BenchRunner.
+     * @param min_seconds Минимальная длительность замера одного бенчмарка.
+     * @param filter Подстрока имени: запускаются только подходящие бенчмарки.
+     */
+    BenchRunner(double min_seconds, const std::string &filter)
+        : min_seconds(min_seconds), filter(filter) {}
+
+    /**
+     * @brief Метод для замера одной операции.
+     * @details Операция повторяется, пока суммарное время не превысит минимальную
+     * длительность.
+     * @param name Имя бенчмарка.
+     * @param bytes_per_op Объём данных, обрабатываемый одной операцией.
+     * @param op Замеряемая операция.
+     */
+    void run(const std::string &name, uint64_t bytes_per_op, const std::function<void()> &op)
+    {
+        if (!this->filter.empty() && name.find(this->filter) == std::string::npos)
+            return;
+
+        // Прогрев
+        op();
+
+        typedef std::chrono::steady_clock clock;
+        uint64_t iterations = 0;
+        uint64_t allocs_before = allocations.load();
+        clock::time_point start = clock::now();
+        clock::duration elapsed(0);
+        while (std::chrono::duration<double>(elapsed).count() < this->min_seconds)
+        {
+            op();
+            ++iterations;
+            elapsed = clock::now() - start;
+        }
+        uint64_t allocs = allocations.load() - allocs_before;
+
+        double seconds = std::chrono::duration<double>(elapsed).count();
+        BenchResult result;
+        result.name = name;
+        result.iterations = iterations;
+        result.ns_per_op = seconds * 1e9 / iterations;
+        result.bytes_per_sec = bytes_per_op * iterations / seconds;
+        result.allocs_per_op = static_cast<double>(allocs) / iterations;
+        this->results.push_back(result);
+
+        std::cerr << name << ": " << result.ns_per_op << " ns/op, "
+                  << result.bytes_per_sec / 1e6 << " MB/s, "
+                  << result.allocs_per_op << " allocs/op\n";
+    }
+
+    /**
+     * @brief Метод для формирования отчёта в формате JSON.
+     * @return Отчёт со всеми результатами.
+     */
+    std::string json() const
+    {
+        std::ostringstream out;
+        out.precision(12);
+        out << "{\n  \"benchmarks\": [\n";
+        for (size_t i = 0; i < this->results.size(); ++i)
+        {
+            const BenchResult &r = this->results[i];
+            out << "    {\"name\": \"" << r.name
+                << "\", \"iterations\": " << r.iterations
+                << ", \"ns_per_op\": " << r.ns_per_op
+                << ", \"bytes_per_sec\": " << r.bytes_per_sec
+                << ", \"allocs_per_op\": " << r.allocs_per_op << "}"
+                << (i + 1 < this->results.size() ? ",\n" : "\n");
+        }
+        out << "  ]\n}\n";
+        return out.str();
+    }
+
+private:
+    double min_seconds; ///< Минимальная длительность замера.
+    std::string filter; ///< Фильтр имён бенчмарков.
+    std::vector<BenchResult> results; ///< Собранные результаты.
+};
+
+/**
+ * @brief Форма входного файла для бенчмарков ввода-вывода.
+ */
+struct Shape
+{
+    const char *name; ///< Имя формы.
+    uint32_t count; ///< Количество векторов.
+    uint32_t size; ///< Размер каждого вектора.
+};
+
+/**
+ * @brief Функция для создания входного файла генератором filer.
+ * @param filer Путь к исполняемому файлу filer.
+ * @param shape Форма входного файла.
+ * @param path Путь к создаваемому файлу.
+ * @param file_type Формат файла (bin, bin2 или txt).
+ * @return true, если файл создан.
+ */
+bool generate_input(const std::string &filer, const Shape &shape, const std::string &path,
+                    const std::string &file_type = "bin")
+{
+    std::string command = filer + " -dt uint32_t -ft " + file_type + " -n " + std::to_string(shape.count) +
+                          " -s " + std::to_string(shape.size) + " --seed 1 -p " + path + " > /dev/null";
+    return std::system(command.c_str()) == 0;
+}
+
+/**
+ * @brief Функция для полного приёма заданного количества байтов.
+ * @param fd Дескриптор сокета.
+ * @param buffer Буфер для данных.
+ * @param length Количество байтов.
+ * @return false, если соединение закрыто.
+ */
+bool recv_all(int fd, void *buffer, size_t length)
+{
+    char *ptr = static_cast<char *>(buffer);
+    while (length > 0)
+    {
+        ssize_t got = ::recv(fd, ptr, length, 0);
+        if (got <= 0)
+            return false;
+        ptr += got;
+        length -= got;
+    }
+    return true;
+}
+
+/**
+ * @brief Функция простого сервера для замера кодека через loopback.
+ * @details Принимает одно подключение без аутентификации и отвечает на каждый
+ * вектор суммой его значений.
+ * @param listen_fd Дескриптор слушающего сокета.
+ */
+void loopback_server(int listen_fd)
+{
+    int fd = accept(listen_fd, nullptr, nullptr);
+    if (fd < 0)
+        return;
+
+    std::vector<uint32_t> values;
+    std::vector<uint32_t> results;
+    uint32_t count;
+    while (recv_all(fd, &count, sizeof(count)))
+    {
+        results.resize(count);
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            uint32_t size;
+            if (!recv_all(fd, &size, sizeof(size)))
+                break;
+            values.resize(size);
+            if (!recv_all(fd, values.data(), size * sizeof(uint32_t)))
+                break;
+            uint32_t sum = 0;
+            for (uint32_t v : values)
+                sum += v;
+            results[i] = sum;
+        }
+        ::send(fd, results.data(), results.size() * sizeof(uint32_t), MSG_NOSIGNAL);
+    }
+    ::close(fd);
+}
+
+/**
+ * @brief Функция построения пары соль - хеш прежним способом.
+ * @details Генератор создаётся (и инициализируется из ОС) на каждый вызов, хеш
+ * вычисляется через цепочку фильтров с конкатенацией строк. Используется как
+ * точка отсчёта для CryptManager::get_batch().
+ * @param password Пароль.
+ * @return Сообщение соль + хеш.
+ */
+std::string legacy_pair(const std::string &password)
+{
+    CryptoPP::byte salt[8];
+    CryptoPP::AutoSeededRandomPool prng;
+    prng.GenerateBlock(salt, sizeof(salt));
+    std::string salt_hex;
+    CryptoPP::ArraySource(salt, sizeof(salt), true,
+                          new CryptoPP::HexEncoder(new CryptoPP::StringSink(salt_hex), true));
+
+    CryptoPP::SHA1 hash_func;
+    std::string hash_hex;
+    CryptoPP::StringSource(salt_hex + password, true,
+                           new CryptoPP::HashFilter(hash_func,
+                                                    new CryptoPP::HexEncoder(new CryptoPP::StringSink(hash_hex), true)));
+    return salt_hex + hash_hex;
+}
+
+/**
+ * @brief Функция для печати справки.
+ */
+void print_help()
+{
+    std::cout << "Usage: bench [options]\n"
+              << "Options:\n"
+              << "  -o PATH     Path to JSON report (default: stdout)\n"
+              << "  -t SECONDS  Minimal duration of each benchmark (default: 0.5)\n"
+              << "  -f FILTER   Run only benchmarks whose name contains FILTER\n"
+              << "  -g PATH     Path to filer executable (default: ../../filer/build/filer)\n"
+              << "  -h          Show this help message and exit\n";
+}
+
+/**
+ * @brief Главная функция бенчмарков.
+ * @param argc Количество аргументов командной строки.
+ * @param argv Аргументы командной строки.
+ * @return Код завершения программы. 0 - успешное завершение, 1 - ошибка.
+ */
+int main(int argc, char *argv[])
+{
+    std::string output_path;
+    std::string filter;
+    std::string filer = "../../filer/build/filer";
+    double min_seconds = 0.5;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        if (std::strcmp(argv[i], "-o") == 0 && i + 1 < argc)
+            output_path = argv[++i];
+        else if (std::strcmp(argv[i], "-t") == 0 && i + 1 < argc)
+            min_seconds = std::stod(argv[++i]);
+        else if (std::strcmp(argv[i], "-f") == 0 && i + 1 < argc)
+            filter = argv[++i];
+        else if (std::strcmp(argv[i], "-g") == 0 && i + 1 < argc)
+            filer = argv[++i];
+        else if (std::strcmp(argv[i], "-h") == 0)
+        {
+            print_help();
+            return 0;
+        }
+        else
+        {
+            print_help();
+            return 1;
+        }
+    }
+
+    // Журнал пишется в stdout: он исказил бы отчёт и добавил форматирование сообщений к замерам
+    Logger::setLevel(LogLevel::OFF);
+
+    BenchRunner runner(min_seconds, filter);
+
+    try
+    {
+        // Чтение и запись файлов разных форм
+        const Shape shapes[] = {
+            {"many_small", 100000, 8},
+            {"square", 1000, 1000},
+            {"few_large", 4, 250000},
+        };
+        for (const Shape &shape : shapes)
+        {
+            std::string in_path = std::string("./bench_") + shape.name + ".bin";
+            std::string out_path = std::string("./bench_") + shape.name + ".out";
+            if (!generate_input(filer, shape, in_path))
+            {
+                std::cerr << "Error: failed to generate input with \"" << filer << "\"\n";
+                return 1;
+            }
+
+            uint64_t in_bytes = (1 + static_cast<uint64_t>(shape.count) * (shape.size + 1)) * sizeof(uint32_t);
+            IOManager io_man("./config/vclient.conf", in_path, out_path);
+            runner.run(std::string("io.read/") + shape.name, in_bytes, [&]
+                       { io_man.read(); });
+
+            std::vector<uint32_t> results(shape.count, 42);
+            runner.run(std::string("io.write/") + shape.name, results.size() * sizeof(uint32_t), [&]
+                       { io_man.write(results); });
+
+            // Разбор текстового формата порциями по 1 МиБ
+            std::string txt_path = std::string("./bench_") + shape.name + ".txt";
+            if (!generate_input(filer, shape, txt_path, "txt"))
+            {
+                std::cerr << "Error: failed to generate input with \"" << filer << "\"\n";
+                return 1;
+            }
+            std::ifstream txt_file(txt_path, std::ios::binary | std::ios::ate);
+            uint64_t txt_bytes = static_cast<uint64_t>(txt_file.tellg());
+            IOManager txt_man("./config/vclient.conf", txt_path, out_path);
+            VectorBatch txt_chunk;
+            runner.run(std::string("io.read_text/") + shape.name, txt_bytes, [&]
+                       {
+                           VectorReader reader = txt_man.reader(1 << 20);
+                           while (reader.next(txt_chunk))
+                               ;
+                       });
+
+            std::remove(in_path.c_str());
+            std::remove(out_path.c_str());
+            std::remove(txt_path.c_str());
+        }
+
+        // Контрольные суммы формата v2: SSE4.2 против табличного алгоритма
+        std::vector<char> crc_block(1 << 20, 'x');
+        runner.run("crc32c/1MiB", crc_block.size(), [&]
+                   { crc32c(crc_block.data(), crc_block.size()); });
+        runner.run("crc32c.software/1MiB", crc_block.size(), [&]
+                   { crc32cSoftware(crc_block.data(), crc_block.size()); });
+
+        // Криптографические операции
+        runner.run("crypt.get_salt", 16, []
+                   { CryptManager::get_salt(); });
+        std::string salt = CryptManager::get_salt();
+        runner.run("crypt.get_hash", salt.size() + 8, [&]
+                   { CryptManager::get_hash(salt, "P@ssW0rd"); });
+
+        char salt_buffer[SALT_HEX_LENGTH];
+        char hash_buffer[HASH_HEX_LENGTH];
+        runner.run("crypt.get_salt_buffer", 16, [&]
+                   { CryptManager::get_salt(salt_buffer); });
+        runner.run("crypt.get_hash_buffer", salt.size() + 8, [&]
+                   { CryptManager::get_hash(salt.data(), salt.size(), "P@ssW0rd", 8, hash_buffer); });
+
+        // Пакет пар соль - хеш на 64 сессии против построения каждой пары заново
+        const size_t BATCH_SIZE = 64;
+        std::vector<SaltHash> tokens(BATCH_SIZE);
+        runner.run("crypt.get_batch/64", BATCH_SIZE * (16 + 8), [&]
+                   { CryptManager::get_batch("P@ssW0rd", tokens.data(), tokens.size()); });
+        runner.run("crypt.legacy_pairs/64", BATCH_SIZE * (16 + 8), []
+                   {
+            for (size_t i = 0; i < BATCH_SIZE; ++i)
+                legacy_pair("P@ssW0rd");
+        });
+
+        // Кодек обмена векторами через loopback
+        int listen_fd = ::socket(AF_INET, SOCK_STREAM, 0);
+        struct sockaddr_in addr;
+        std::memset(&addr, 0, sizeof(addr));
+        addr.sin_family = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        socklen_t addr_length = sizeof(addr);
+        if (bind(listen_fd, (struct sockaddr *)&addr, sizeof(addr)) < 0 ||
+            listen(listen_fd, 1) < 0 ||
+            getsockname(listen_fd, (struct sockaddr *)&addr, &addr_length) < 0)
+        {
+            std::cerr << "Error: failed to open loopback socket\n";
+            return 1;
+        }
+        std::thread server(loopback_server, listen_fd);
+
+        NetworkManager net_man("127.0.0.1", ntohs(addr.sin_port));
+        net_man.conn();
+        const Shape codec_shapes[] = {
+            {"many_small", 4096, 8},
+            {"square", 256, 256},
+        };
+        for (const Shape &shape : codec_shapes)
+        {
+            VectorBatch batch(std::vector<std::vector<uint32_t>>(shape.count, std::vector<uint32_t>(shape.size, 7)));
+            uint64_t wire_bytes = sizeof(uint32_t) + batch.size() * sizeof(uint32_t) + batch.bytes();
+            runner.run(std::string("codec.exchange/") + shape.name, wire_bytes, [&]
+                       {
+                net_man.begin(batch.size());
+                net_man.exchange(batch); });
+        }
+        net_man.close();
+        server.join();
+        ::close(listen_fd);
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+
+    // Вывод отчёта
+    if (output_path.empty())
+    {
+        std::cout << runner.json();
+    }
+    else
+    {
+        std::ofstream report(output_path);
+        if (!report.is_open())
+        {
+            std::cerr << "Error: failed to open report file \"" << output_path << "\"\n";
+            return 1;
+        }
+        report << runner.json();
+    }
+    return 0;
+}
@@ -23,9 +23,11 @@ int main(int argc, char* argv[]) {
         UserInterface ui(argc, argv);
         ui.run();
     } catch (const BasicClientError& e) {
+        Logger::instance().flush();
         std::cerr << "Error: " << e.what() << "\n";
         return 1;
     } catch (const std::exception& e) {
+        Logger::instance().flush();
         std::cerr << "Unexpected error: " << e.what() << "\n";
         return 1;
     }
@@ -0,0 +1,218 @@
+#include "batch.h"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <utility>
+#include <sys/mman.h>
+
+// Размер большой страницы памяти (2 МиБ)
+static const size_t HUGE_PAGE_SIZE = 2 * 1024 * 1024;
+
+template <typename T>
+bool BasicVectorView<T>::operator==(const std::vector<T> &other) const
+{
+    return this->size == other.size() &&
+           std::equal(this->begin(), this->end(), other.begin());
+}
+
+// Конструктор
+template <typename T>
+BasicVectorBatch<T>::BasicVectorBatch(bool huge_pages)
+    : arena(nullptr),
+      arena_capacity(0),
+      huge_pages(huge_pages),
+      arena_mapped(false),
+      offsets(1, 0) {}
+
+// Конструктор из набора векторов
+template <typename T>
+BasicVectorBatch<T>::BasicVectorBatch(const std::vector<std::vector<T>> &vectors)
+    : BasicVectorBatch(false)
+{
+    size_t num_values = 0;
+    for (const auto &vec : vectors)
+        num_values += vec.size();
+
+    this->reserve(vectors.size(), num_values);
+    for (const auto &vec : vectors)
+        this->push_back(vec.data(), vec.size());
+}
+
+// Конструктор перемещения
+template <typename T>
+BasicVectorBatch<T>::BasicVectorBatch(BasicVectorBatch &&other)
+    : arena(other.arena),
+      arena_capacity(other.arena_capacity),
+      huge_pages(other.huge_pages),
+      arena_mapped(other.arena_mapped),
+      offsets(std::move(other.offsets))
+{
+    other.arena = nullptr;
+    other.arena_capacity = 0;
+    other.arena_mapped = false;
+    other.offsets.assign(1, 0);
+}
+
+// Оператор перемещающего присваивания
+template <typename T>
+BasicVectorBatch<T> &BasicVectorBatch<T>::operator=(BasicVectorBatch &&other)
+{
+    if (this != &other)
+    {
+        this->release();
+        this->arena = other.arena;
+        this->arena_capacity = other.arena_capacity;
+        this->huge_pages = other.huge_pages;
+        this->arena_mapped = other.arena_mapped;
+        this->offsets = std::move(other.offsets);
+
+        other.arena = nullptr;
+        other.arena_capacity = 0;
+        other.arena_mapped = false;
+        other.offsets.assign(1, 0);
+    }
+    return *this;
+}
+
+// Деструктор
+template <typename T>
+BasicVectorBatch<T>::~BasicVectorBatch()
+{
+    this->release();
+}
+
+// Метод для резервирования памяти
+template <typename T>
+void BasicVectorBatch<T>::reserve(size_t num_vectors, size_t num_values)
+{
+    this->offsets.reserve(num_vectors + 1);
+    if (num_values > this->arena_capacity)
+        this->grow(num_values);
+}
+
+// Метод для добавления вектора без инициализации значений
+template <typename T>
+T *BasicVectorBatch<T>::append(uint32_t size)
+{
+    size_t begin = this->offsets.back();
+    size_t end = begin + size;
+    if (end > this->arena_capacity)
+        this->grow(std::max(end, this->arena_capacity * 2));
+
+    this->offsets.push_back(end);
+    return this->arena + begin;
+}
+
+// Метод для добавления вектора с копированием значений
+template <typename T>
+void BasicVectorBatch<T>::push_back(const T *values, uint32_t size)
+{
+    T *dest = this->append(size);
+    if (size > 0)
+        std::memcpy(dest, values, size * sizeof(T));
+}
+
+// Метод для очистки порции
+template <typename T>
+void BasicVectorBatch<T>::clear()
+{
+    this->offsets.resize(1);
+}
+
+template <typename T>
+size_t BasicVectorBatch<T>::size() const
+{
+    return this->offsets.size() - 1;
+}
+
+template <typename T>
+bool BasicVectorBatch<T>::empty() const
+{
+    return this->offsets.size() == 1;
+}
+
+template <typename T>
+size_t BasicVectorBatch<T>::values() const
+{
+    return this->offsets.back();
+}
+
+template <typename T>
+size_t BasicVectorBatch<T>::bytes() const
+{
+    return this->offsets.back() * sizeof(T);
+}
+
+// Оператор доступа к вектору
+template <typename T>
+BasicVectorView<T> BasicVectorBatch<T>::operator[](size_t i) const
+{
+    BasicVectorView<T> view;
+    view.data = this->arena + this->offsets[i];
+    view.size = static_cast<uint32_t>(this->offsets[i + 1] - this->offsets[i]);
+    return view;
+}
+
+// Метод для увеличения буфера значений
+template <typename T>
+void BasicVectorBatch<T>::grow(size_t num_values)
+{
+    size_t used = this->offsets.back();
+    size_t new_bytes = num_values * sizeof(T);
+    T *new_arena = nullptr;
+    bool new_mapped = false;
+
+    // Большие буферы размещаются через mmap с подсказкой о больших страницах
+    if (this->huge_pages && new_bytes >= HUGE_PAGE_SIZE)
+    {
+        new_bytes = (new_bytes + HUGE_PAGE_SIZE - 1) / HUGE_PAGE_SIZE * HUGE_PAGE_SIZE;
+        void *mem = mmap(nullptr, new_bytes, PROT_READ | PROT_WRITE,
+                         MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (mem != MAP_FAILED)
+        {
+            madvise(mem, new_bytes, MADV_HUGEPAGE);
+            new_arena = static_cast<T *>(mem);
+            new_mapped = true;
+        }
+    }
+
+    if (new_arena == nullptr)
+    {
+        new_bytes = num_values * sizeof(T);
+        new_arena = static_cast<T *>(std::malloc(new_bytes));
+        if (new_arena == nullptr)
+            throw std::bad_alloc();
+    }
+
+    if (used > 0)
+        std::memcpy(new_arena, this->arena, used * sizeof(T));
+
+    this->release();
+    this->arena = new_arena;
+    this->arena_capacity = new_bytes / sizeof(T);
+    this->arena_mapped = new_mapped;
+}
+
+// Метод для освобождения буфера значений
+template <typename T>
+void BasicVectorBatch<T>::release()
+{
+    if (this->arena == nullptr)
+        return;
+
+    if (this->arena_mapped)
+        munmap(this->arena, this->arena_capacity * sizeof(T));
+    else
+        std::free(this->arena);
+
+    this->arena = nullptr;
+    this->arena_capacity = 0;
+    this->arena_mapped = false;
+}
+
+// Явное инстанцирование для поддерживаемых типов данных
+#define INSTANTIATE_BATCH(T)            \
+    template struct BasicVectorView<T>; \
+    template class BasicVectorBatch<T>;
+FOR_EACH_DATA_TYPE(INSTANTIATE_BATCH)
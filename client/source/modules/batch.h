@@ -0,0 +1,186 @@
+#ifndef VECTOR_BATCH_H
+#define VECTOR_BATCH_H
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include "types.h"
+
+/**
+* @file batch.h
+* @brief Определения классов для плоского хранения порции векторов.
+* @details Этот файл содержит определения классов для хранения множества векторов
+* в одном непрерывном буфере значений с массивом смещений (формат CSR).
+* @date 17.10.2026
+* @version 1.0
+* @authors Косов Р. С.
+* @copyright ИБСТ ПГУ
+*/
+
+/**
+* @brief Невладеющее представление одного вектора.
+* @tparam T Тип значений вектора.
+*/
+template <typename T>
+struct BasicVectorView
+{
+    const T *data; ///< Указатель на первое значение вектора.
+    uint32_t size; ///< Количество значений в векторе.
+
+    /**
+    * @brief Метод для получения начала вектора.
+    * @return Указатель на первое значение.
+    */
+    const T *begin() const { return data; }
+
+    /**
+    * @brief Метод для получения конца вектора.
+    * @return Указатель за последним значением.
+    */
+    const T *end() const { return data + size; }
+
+    /**
+    * @brief Оператор доступа к значению вектора.
+    * @param i Индекс значения.
+    * @return Значение вектора.
+    */
+    T operator[](size_t i) const { return data[i]; }
+
+    /**
+    * @brief Оператор сравнения с обычным вектором.
+    * @param other Вектор для сравнения.
+    * @return true, если значения совпадают.
+    */
+    bool operator==(const std::vector<T> &other) const;
+};
+
+/**
+* @brief Класс для хранения порции векторов в одном непрерывном буфере.
+* @details Все значения хранятся подряд в одном буфере, границы векторов
+* задаются массивом смещений. Порция требует O(1) выделений памяти,
+* при повторном использовании (clear()) память не освобождается.
+* Буфер может быть размещён в больших страницах памяти.
+* @tparam T Тип значений векторов.
+*/
+template <typename T>
+class BasicVectorBatch
+{
+public:
+    /**
+    * @brief Конструктор класса BasicVectorBatch.
+    * @param huge_pages Размещать ли буфер значений в больших страницах памяти.
+    */
+    explicit BasicVectorBatch(bool huge_pages = false);
+
+    /**
+    * @brief Конструктор класса BasicVectorBatch из набора векторов.
+    * @param vectors Векторы, копируемые в порцию.
+    */
+    BasicVectorBatch(const std::vector<std::vector<T>> &vectors);
+
+    /**
+    * @brief Конструктор перемещения.
+    * @param other Перемещаемая порция.
+    */
+    BasicVectorBatch(BasicVectorBatch &&other);
+
+    /**
+    * @brief Оператор перемещающего присваивания.
+    * @param other Перемещаемая порция.
+    * @return Ссылка на текущую порцию.
+    */
+    BasicVectorBatch &operator=(BasicVectorBatch &&other);
+
+    BasicVectorBatch(const BasicVectorBatch &) = delete;
+    BasicVectorBatch &operator=(const BasicVectorBatch &) = delete;
+
+    /**
+    * @brief Деструктор класса BasicVectorBatch.
+    */
+    ~BasicVectorBatch();
+
+    /**
+    * @brief Метод для резервирования памяти.
+    * @param num_vectors Ожидаемое количество векторов.
+    * @param num_values Ожидаемое суммарное количество значений.
+    */
+    void reserve(size_t num_vectors, size_t num_values);
+
+    /**
+    * @brief Метод для добавления вектора без инициализации значений.
+    * @details Возвращённый указатель действителен до следующего изменения порции.
+    * @param size Количество значений в векторе.
+    * @return Указатель на место для значений нового вектора.
+    */
+    T *append(uint32_t size);
+
+    /**
+    * @brief Метод для добавления вектора с копированием значений.
+    * @param values Значения вектора.
+    * @param size Количество значений.
+    */
+    void push_back(const T *values, uint32_t size);
+
+    /**
+    * @brief Метод для очистки порции без освобождения памяти.
+    */
+    void clear();
+
+    /**
+    * @brief Метод для получения количества векторов.
+    * @return Количество векторов.
+    */
+    size_t size() const;
+
+    /**
+    * @brief Метод для проверки порции на пустоту.
+    * @return true, если в порции нет векторов.
+    */
+    bool empty() const;
+
+    /**
+    * @brief Метод для получения суммарного количества значений.
+    * @return Количество значений во всех векторах.
+    */
+    size_t values() const;
+
+    /**
+    * @brief Метод для получения объёма значений в байтах.
+    * @return Объём значений.
+    */
+    size_t bytes() const;
+
+    /**
+    * @brief Оператор доступа к вектору порции.
+    * @param i Индекс вектора.
+    * @return Представление вектора.
+    */
+    BasicVectorView<T> operator[](size_t i) const;
+
+private:
+    T *arena; ///< Буфер значений.
+    size_t arena_capacity; ///< Вместимость буфера (в значениях).
+    bool huge_pages; ///< Флаг размещения буфера в больших страницах.
+    bool arena_mapped; ///< Флаг выделения буфера через mmap.
+    std::vector<size_t> offsets; ///< Смещения векторов (на один элемент больше количества векторов).
+
+    /**
+    * @brief Метод для увеличения буфера значений.
+    * @param num_values Требуемая вместимость (в значениях).
+    * @throw std::bad_alloc Если не удалось выделить память.
+    */
+    void grow(size_t num_values);
+
+    /**
+    * @brief Метод для освобождения буфера значений.
+    */
+    void release();
+};
+
+/// Представление вектора из значений uint32_t.
+typedef BasicVectorView<uint32_t> VectorView;
+
+/// Порция векторов из значений uint32_t.
+typedef BasicVectorBatch<uint32_t> VectorBatch;
+
+#endif // VECTOR_BATCH_H
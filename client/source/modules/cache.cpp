@@ -0,0 +1,304 @@
+#include "cache.h"
+#include "log.h"
+#include <algorithm>
+#include <cstring>
+#include <vector>
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Сигнатура файла кеша
+static const char CACHE_MAGIC[8] = {'V', 'C', 'C', 'A', 'C', 'H', 'E', '1'};
+
+// Константы смешивания хеша
+static const uint64_t P0 = 0xa0761d6478bd642full;
+static const uint64_t P1 = 0xe7037ed1a0b428dbull;
+static const uint64_t P2 = 0x8ebc6af09c88c6e3ull;
+static const uint64_t P3 = 0x589965cc75374cc3ull;
+
+// Функция для перемножения с свёрткой старшей половины произведения
+static inline uint64_t mum(uint64_t a, uint64_t b)
+{
+    unsigned __int128 r = static_cast<unsigned __int128>(a) * b;
+    return static_cast<uint64_t>(r) ^ static_cast<uint64_t>(r >> 64);
+}
+
+// Функция для чтения 8 байтов без требований к выравниванию
+static inline uint64_t load64(const unsigned char *p)
+{
+    uint64_t value;
+    std::memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+// Конструктор
+ResultCache::ResultCache(const std::string &path, size_t max_bytes)
+    : path(path),
+      fd(-1),
+      base(nullptr),
+      length(0),
+      header(nullptr),
+      table(nullptr),
+      mask(0),
+      hit_count(0),
+      miss_count(0),
+      eviction_count(0)
+{
+    this->fd = ::open(path.c_str(), O_RDWR | O_CREAT, 0644);
+    if (this->fd < 0)
+        throw IOError("Failed to open cache file \"" + path + "\"", "ResultCache.ResultCache()");
+    if (flock(this->fd, LOCK_EX | LOCK_NB) < 0)
+    {
+        ::close(this->fd);
+        throw IOError("Cache file \"" + path + "\" is used by another process", "ResultCache.ResultCache()");
+    }
+
+    // Наибольшая степень двойки ячеек, помещающаяся в ограничение
+    uint64_t slots = MIN_SLOTS;
+    while (sizeof(Header) + slots * 2 * sizeof(Slot) <= max_bytes)
+        slots *= 2;
+
+    struct stat st;
+    Header stored;
+    bool valid = fstat(this->fd, &st) == 0 &&
+                 static_cast<size_t>(st.st_size) >= sizeof(Header) &&
+                 pread(this->fd, &stored, sizeof(stored), 0) == static_cast<ssize_t>(sizeof(stored)) &&
+                 std::memcmp(stored.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC)) == 0 &&
+                 stored.slots >= MIN_SLOTS && (stored.slots & (stored.slots - 1)) == 0 &&
+                 static_cast<size_t>(st.st_size) == sizeof(Header) + stored.slots * sizeof(Slot);
+
+    try
+    {
+        if (valid && stored.slots == slots)
+        {
+            this->map(slots, false);
+        }
+        else if (valid)
+        {
+            // Ограничение изменилось - записи переносятся в таблицу нового размера
+            this->map(stored.slots, false);
+            std::vector<Slot> entries;
+            for (uint64_t i = 0; i < stored.slots; ++i)
+            {
+                const Slot &slot = this->table[i];
+                if (slot.check != 0 && slot.check == checkOf(slot.hi, slot.lo, slot.result))
+                    entries.push_back(slot);
+            }
+            uint64_t clock = this->header->clock;
+            this->unmap();
+            this->map(slots, true);
+            this->header->clock = clock;
+
+            // Сначала вставляются старые записи, чтобы при вытеснении оставались новые
+            uint32_t now = static_cast<uint32_t>(clock);
+            std::sort(entries.begin(), entries.end(), [now](const Slot &a, const Slot &b)
+                      { return now - a.stamp > now - b.stamp; });
+            for (const Slot &slot : entries)
+                this->insert(CacheKey{slot.hi, slot.lo}, slot.result, slot.stamp);
+            this->eviction_count.store(0);
+            LOG_INFO("ResultCache.ResultCache()", "Cache resized: slots=" << stored.slots << " -> " << slots
+                                                                          << " kept=" << this->header->entries);
+        }
+        else
+        {
+            if (st.st_size > 0)
+                LOG_WARN("ResultCache.ResultCache()", "Cache file \"" << path << "\" is damaged and is recreated");
+            this->map(slots, true);
+        }
+    }
+    catch (...)
+    {
+        this->unmap();
+        ::close(this->fd);
+        throw;
+    }
+}
+
+// Деструктор
+ResultCache::~ResultCache()
+{
+    this->unmap();
+    ::close(this->fd);
+}
+
+// Метод для отображения файла заданного размера
+void ResultCache::map(uint64_t slots, bool fresh)
+{
+    this->length = sizeof(Header) + slots * sizeof(Slot);
+    if (fresh && (ftruncate(this->fd, 0) < 0 || ftruncate(this->fd, this->length) < 0))
+        throw IOError("Failed to resize cache file \"" + this->path + "\"", "ResultCache.map()");
+
+    void *mapped = mmap(nullptr, this->length, PROT_READ | PROT_WRITE, MAP_SHARED, this->fd, 0);
+    if (mapped == MAP_FAILED)
+        throw IOError("Failed to map cache file \"" + this->path + "\"", "ResultCache.map()");
+
+    this->base = static_cast<char *>(mapped);
+    this->header = reinterpret_cast<Header *>(this->base);
+    this->table = reinterpret_cast<Slot *>(this->base + sizeof(Header));
+    this->mask = slots - 1;
+    if (fresh)
+    {
+        std::memcpy(this->header->magic, CACHE_MAGIC, sizeof(CACHE_MAGIC));
+        this->header->slots = slots;
+        this->header->entries = 0;
+        this->header->clock = 0;
+    }
+}
+
+// Метод для снятия отображения
+void ResultCache::unmap()
+{
+    if (this->base != nullptr)
+        munmap(this->base, this->length);
+    this->base = nullptr;
+    this->header = nullptr;
+    this->table = nullptr;
+}
+
+// Метод для вычисления ключа вектора
+CacheKey ResultCache::key(DataType type, const void *data, size_t bytes)
+{
+    const unsigned char *p = static_cast<const unsigned char *>(data);
+    uint64_t seed = mum((static_cast<uint64_t>(type) + 1) ^ P0, OPERATION ^ P1);
+    uint64_t a = seed ^ P2;
+    uint64_t b = (seed + bytes) ^ P3;
+
+    // Две независимые полосы по 8 байтов за шаг
+    size_t left = bytes;
+    for (; left >= 16; left -= 16, p += 16)
+    {
+        uint64_t w0 = load64(p);
+        uint64_t w1 = load64(p + 8);
+        a = mum(w0 ^ a, w1 ^ P0);
+        b = mum(w1 ^ b, w0 ^ P1);
+    }
+    if (left > 0)
+    {
+        unsigned char tail[16] = {0};
+        std::memcpy(tail, p, left);
+        a = mum(load64(tail) ^ a, load64(tail + 8) ^ P0 ^ left);
+        b = mum(load64(tail + 8) ^ b, load64(tail) ^ P1 ^ left);
+    }
+
+    CacheKey key;
+    key.hi = mum(a ^ P2, b ^ bytes ^ P3);
+    key.lo = mum(b ^ P0, a ^ P1) ^ key.hi;
+    return key;
+}
+
+// Метод для вычисления контрольного слова ячейки
+uint32_t ResultCache::checkOf(uint64_t hi, uint64_t lo, uint64_t result)
+{
+    return static_cast<uint32_t>(mum(hi ^ P0, lo ^ result ^ P1)) | 1u;
+}
+
+// Метод для поиска результатов порции векторов
+size_t ResultCache::find(const CacheKey *keys, size_t count, uint64_t *results, bool *found)
+{
+    std::lock_guard<std::mutex> lock(this->mutex);
+    uint32_t stamp = static_cast<uint32_t>(++this->header->clock);
+    size_t hits = 0;
+    for (size_t i = 0; i < count; ++i)
+    {
+        found[i] = false;
+        uint64_t index = keys[i].lo & this->mask;
+        for (size_t p = 0; p < PROBE_WINDOW; ++p)
+        {
+            Slot &slot = this->table[(index + p) & this->mask];
+            if (slot.check == 0)
+                break;
+            if (slot.hi == keys[i].hi && slot.lo == keys[i].lo &&
+                slot.check == checkOf(slot.hi, slot.lo, slot.result))
+            {
+                results[i] = slot.result;
+                found[i] = true;
+                // Отметка пишется только при изменении, чтобы не загрязнять страницы
+                if (slot.stamp != stamp)
+                    slot.stamp = stamp;
+                ++hits;
+                break;
+            }
+        }
+    }
+    this->hit_count.fetch_add(hits, std::memory_order_relaxed);
+    this->miss_count.fetch_add(count - hits, std::memory_order_relaxed);
+    return hits;
+}
+
+// Метод для сохранения результатов порции векторов
+void ResultCache::store(const CacheKey *keys, const uint64_t *results, size_t count)
+{
+    std::lock_guard<std::mutex> lock(this->mutex);
+    uint32_t stamp = static_cast<uint32_t>(this->header->clock);
+    for (size_t i = 0; i < count; ++i)
+        this->insert(keys[i], results[i], stamp);
+}
+
+// Метод для вставки записи
+void ResultCache::insert(const CacheKey &key, uint64_t result, uint32_t stamp)
+{
+    uint64_t index = key.lo & this->mask;
+    Slot *victim = nullptr;
+    uint32_t victim_age = 0;
+    for (size_t p = 0; p < PROBE_WINDOW; ++p)
+    {
+        Slot &slot = this->table[(index + p) & this->mask];
+        if (slot.check == 0)
+        {
+            victim = &slot;
+            ++this->header->entries;
+            break;
+        }
+        if (slot.hi == key.hi && slot.lo == key.lo)
+        {
+            victim = &slot;
+            break;
+        }
+
+        // Повреждённая ячейка вытесняется первой
+        uint32_t age = slot.check == checkOf(slot.hi, slot.lo, slot.result) ? stamp - slot.stamp : UINT32_MAX;
+        if (victim == nullptr || age > victim_age)
+        {
+            victim = &slot;
+            victim_age = age;
+        }
+        if (p + 1 == PROBE_WINDOW)
+            this->eviction_count.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // Контрольное слово пишется последним
+    victim->check = 0;
+    victim->hi = key.hi;
+    victim->lo = key.lo;
+    victim->result = result;
+    victim->stamp = stamp;
+    victim->check = checkOf(key.hi, key.lo, result);
+}
+
+uint64_t ResultCache::hits() const
+{
+    return this->hit_count.load(std::memory_order_relaxed);
+}
+
+uint64_t ResultCache::misses() const
+{
+    return this->miss_count.load(std::memory_order_relaxed);
+}
+
+uint64_t ResultCache::evictions() const
+{
+    return this->eviction_count.load(std::memory_order_relaxed);
+}
+
+uint64_t ResultCache::size() const
+{
+    std::lock_guard<std::mutex> lock(this->mutex);
+    return this->header->entries;
+}
+
+uint64_t ResultCache::capacity() const
+{
+    return this->mask + 1;
+}
@@ -0,0 +1,197 @@
+#ifndef RESULT_CACHE_H
+#define RESULT_CACHE_H
+
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+#include <mutex>
+#include <string>
+#include "errors.h"
+#include "types.h"
+
+/**
+* @file cache.h
+* @brief Определения класса дискового кеша результатов.
+* @details Результат вектора определяется только типом значений, операцией сервера
+* и байтами вектора, поэтому кеш адресуется 128-битным хешем этих данных.
+* Таблица с открытой адресацией хранится в файле, отображённом в память:
+* заголовок и ячейки по 32 байта (ключ, результат, отметка использования,
+* контрольное слово). Ключ ищется в окне из PROBE_WINDOW соседних ячеек;
+* если при вставке окно заполнено, вытесняется ячейка, дольше всех
+* не использовавшаяся. Размер файла ограничен при создании, при смене
+* ограничения записи переносятся в таблицу нового размера.
+* Файл блокируется flock, чтобы его не изменяли одновременно два процесса.
+* @date 17.10.2026
+* @version 1.0
+* @authors Косов Р. С.
+* @copyright ИБСТ ПГУ
+*/
+
+/**
+* @brief Ключ кеша - 128-битный хеш типа, операции и байтов вектора.
+*/
+struct CacheKey
+{
+    uint64_t hi; ///< Старшая половина хеша.
+    uint64_t lo; ///< Младшая половина хеша.
+};
+
+/**
+* @brief Класс дискового кеша результатов векторов.
+* @details Методы потокобезопасны: поиск и вставка порции выполняются
+* под одним мьютексом, хеши вычисляются до его захвата.
+*/
+class ResultCache
+{
+public:
+    /// Идентификатор операции сервера (сумма с насыщением), входит в ключ.
+    static const uint32_t OPERATION = 1;
+
+    /// Количество ячеек, просматриваемых при поиске ключа.
+    static const size_t PROBE_WINDOW = 8;
+
+    /// Наименьшее количество ячеек таблицы.
+    static const size_t MIN_SLOTS = 64;
+
+    /**
+    * @brief Конструктор класса ResultCache.
+    * @details Открывает или создаёт файл кеша. Повреждённый файл создаётся заново.
+    * @param path Путь к файлу кеша.
+    * @param max_bytes Наибольший размер файла в байтах.
+    * @throw IOError Если файл не удалось открыть, отобразить или он занят другим процессом.
+    */
+    ResultCache(const std::string &path, size_t max_bytes);
+
+    /**
+    * @brief Деструктор класса ResultCache.
+    */
+    ~ResultCache();
+
+    ResultCache(const ResultCache &) = delete;
+    ResultCache &operator=(const ResultCache &) = delete;
+
+    /**
+    * @brief Метод для вычисления ключа вектора.
+    * @param type Тип значений вектора.
+    * @param data Значения вектора.
+    * @param bytes Размер значений в байтах.
+    * @return Ключ кеша.
+    */
+    static CacheKey key(DataType type, const void *data, size_t bytes);
+
+    /**
+    * @brief Метод для поиска результатов порции векторов.
+    * @param keys Ключи векторов.
+    * @param count Количество векторов.
+    * @param results Найденные результаты (биты значения типа T в младших байтах).
+    * @param found Признаки найденных результатов.
+    * @return Количество найденных результатов.
+    */
+    size_t find(const CacheKey *keys, size_t count, uint64_t *results, bool *found);
+
+    /**
+    * @brief Метод для сохранения результатов порции векторов.
+    * @param keys Ключи векторов.
+    * @param results Результаты (биты значения типа T в младших байтах).
+    * @param count Количество векторов.
+    */
+    void store(const CacheKey *keys, const uint64_t *results, size_t count);
+
+    /**
+    * @brief Метод для получения количества найденных результатов.
+    * @return Количество попаданий с момента открытия.
+    */
+    uint64_t hits() const;
+
+    /**
+    * @brief Метод для получения количества ненайденных результатов.
+    * @return Количество промахов с момента открытия.
+    */
+    uint64_t misses() const;
+
+    /**
+    * @brief Метод для получения количества вытесненных записей.
+    * @return Количество вытеснений с момента открытия.
+    */
+    uint64_t evictions() const;
+
+    /**
+    * @brief Метод для получения количества записей.
+    * @return Количество занятых ячеек.
+    */
+    uint64_t size() const;
+
+    /**
+    * @brief Метод для получения вместимости таблицы.
+    * @return Количество ячеек.
+    */
+    uint64_t capacity() const;
+
+private:
+    /**
+    * @brief Заголовок файла кеша.
+    */
+    struct Header
+    {
+        char magic[8]; ///< Сигнатура "VCCACHE1".
+        uint64_t slots; ///< Количество ячеек (степень двойки).
+        uint64_t entries; ///< Количество занятых ячеек.
+        uint64_t clock; ///< Счётчик для отметок использования.
+        uint64_t reserved[4]; ///< Зарезервировано.
+    };
+
+    /**
+    * @brief Ячейка таблицы.
+    */
+    struct Slot
+    {
+        uint64_t hi; ///< Старшая половина ключа.
+        uint64_t lo; ///< Младшая половина ключа.
+        uint64_t result; ///< Результат.
+        uint32_t stamp; ///< Отметка последнего использования.
+        uint32_t check; ///< Контрольное слово (0 - ячейка пуста).
+    };
+
+    std::string path; ///< Путь к файлу кеша.
+    int fd; ///< Дескриптор файла.
+    char *base; ///< Начало отображения.
+    size_t length; ///< Размер отображения.
+    Header *header; ///< Заголовок в отображении.
+    Slot *table; ///< Ячейки в отображении.
+    uint64_t mask; ///< Маска номера ячейки.
+    mutable std::mutex mutex; ///< Мьютекс таблицы.
+    std::atomic<uint64_t> hit_count; ///< Количество попаданий.
+    std::atomic<uint64_t> miss_count; ///< Количество промахов.
+    std::atomic<uint64_t> eviction_count; ///< Количество вытеснений.
+
+    /**
+    * @brief Метод для вычисления контрольного слова ячейки.
+    * @param hi Старшая половина ключа.
+    * @param lo Младшая половина ключа.
+    * @param result Результат.
+    * @return Ненулевое контрольное слово.
+    */
+    static uint32_t checkOf(uint64_t hi, uint64_t lo, uint64_t result);
+
+    /**
+    * @brief Метод для отображения файла заданного размера.
+    * @param slots Количество ячеек.
+    * @param fresh Создавать ли таблицу заново.
+    */
+    void map(uint64_t slots, bool fresh);
+
+    /**
+    * @brief Метод для снятия отображения.
+    */
+    void unmap();
+
+    /**
+    * @brief Метод для вставки записи (вызывается под мьютексом).
+    * @param key Ключ.
+    * @param result Результат.
+    * @param stamp Отметка использования.
+    */
+    void insert(const CacheKey &key, uint64_t result, uint32_t stamp);
+};
+
+#endif // RESULT_CACHE_H
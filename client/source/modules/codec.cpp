@@ -0,0 +1,415 @@
+#include "codec.h"
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <cstring>
+#include <poll.h>
+#include <sys/socket.h>
+
+// Конструктор кольцевого буфера
+RecvRing::RecvRing(size_t capacity)
+    : buffer(capacity),
+      mask(capacity - 1),
+      head(0),
+      tail(0) {}
+
+// Метод для получения свободного непрерывного участка
+char *RecvRing::space(size_t &length)
+{
+    size_t free_bytes = this->buffer.size() - (this->tail - this->head);
+    size_t index = this->tail & this->mask;
+    length = std::min(free_bytes, this->buffer.size() - index);
+    return this->buffer.data() + index;
+}
+
+void RecvRing::commit(size_t length)
+{
+    this->tail += length;
+}
+
+// Метод для извлечения готовых результатов
+template <typename T>
+size_t RecvRing::pop(T *results, size_t count)
+{
+    size_t n = std::min((this->tail - this->head) / sizeof(T), count);
+    size_t bytes = n * sizeof(T);
+    size_t index = this->head & this->mask;
+    size_t first = std::min(bytes, this->buffer.size() - index);
+
+    std::memcpy(results, this->buffer.data() + index, first);
+    if (bytes > first)
+        std::memcpy(reinterpret_cast<char *>(results) + first, this->buffer.data(), bytes - first);
+
+    this->head += bytes;
+    return n;
+}
+
+size_t RecvRing::readable() const
+{
+    return this->tail - this->head;
+}
+
+// Конструктор кодека
+WireCodec::WireCodec()
+    : socket(-1),
+      pending_count(0),
+      count_pending(false),
+      counters(),
+      gathered(0) {}
+
+void WireCodec::attach(int socket)
+{
+    this->socket = socket;
+    this->ring = RecvRing();
+    std::lock_guard<std::mutex> lock(this->sent_mutex);
+    this->sent_at.clear();
+}
+
+// Метод для начала передачи
+void WireCodec::begin(uint32_t num_vectors)
+{
+    this->reset();
+    this->round(num_vectors);
+}
+
+void WireCodec::reset()
+{
+    this->counters = SyscallStats();
+}
+
+// Метод для начала очередного раунда передачи
+void WireCodec::round(uint32_t num_vectors)
+{
+    this->pending_count = num_vectors;
+    this->count_pending = true;
+
+    // Без векторов количество больше не с чем объединить - отправляется сразу
+    if (num_vectors == 0)
+    {
+        size_t received = 0;
+        this->gathered = 0;
+        this->vector_ends.clear();
+        this->iov.clear();
+        this->iov.push_back({&this->pending_count, sizeof(this->pending_count)});
+        this->count_pending = false;
+        this->flush<uint32_t>(nullptr, 0, received);
+    }
+}
+
+// Метод для сборки массива iovec для порции векторов
+template <typename T>
+void WireCodec::gather(const BasicVectorBatch<T> &chunk)
+{
+    this->headers.resize(chunk.size());
+    this->iov.clear();
+    this->iov.reserve(chunk.size() * 2 + 1);
+    this->gathered = chunk.size();
+
+    if (this->count_pending)
+    {
+        this->iov.push_back({&this->pending_count, sizeof(this->pending_count)});
+        this->count_pending = false;
+    }
+    this->mark<T>(this->iov.size() * sizeof(uint32_t), chunk, chunk.size());
+
+    for (size_t i = 0; i < chunk.size(); ++i)
+    {
+        BasicVectorView<T> vec = chunk[i];
+        this->headers[i] = vec.size;
+        this->iov.push_back({&this->headers[i], sizeof(uint32_t)});
+        if (vec.size > 0)
+            this->iov.push_back({const_cast<T *>(vec.data), vec.size * sizeof(T)});
+    }
+}
+
+// Метод для сборки массива iovec для порции из отображённого файла
+template <typename T>
+void WireCodec::gather(const BasicMappedChunk<T> &chunk)
+{
+    this->iov.clear();
+    this->gathered = chunk.views.size();
+
+    if (this->count_pending)
+    {
+        this->iov.push_back({&this->pending_count, sizeof(this->pending_count)});
+        this->count_pending = false;
+    }
+    this->mark<T>(this->iov.size() * sizeof(uint32_t), chunk.views, chunk.views.size());
+
+    // Записи файла уже имеют формат передачи
+    this->iov.push_back({const_cast<char *>(chunk.wire), chunk.wire_bytes});
+}
+
+// Метод для сборки массива iovec для выбранных векторов
+template <typename T>
+void WireCodec::gather(const std::vector<BasicVectorView<T>> &views)
+{
+    this->headers.resize(views.size());
+    this->iov.clear();
+    this->iov.reserve(views.size() * 2 + 1);
+    this->gathered = views.size();
+
+    if (this->count_pending)
+    {
+        this->iov.push_back({&this->pending_count, sizeof(this->pending_count)});
+        this->count_pending = false;
+    }
+    this->mark<T>(this->iov.size() * sizeof(uint32_t), views, views.size());
+
+    for (size_t i = 0; i < views.size(); ++i)
+    {
+        this->headers[i] = views[i].size;
+        this->iov.push_back({&this->headers[i], sizeof(uint32_t)});
+        if (views[i].size > 0)
+            this->iov.push_back({const_cast<T *>(views[i].data), views[i].size * sizeof(T)});
+    }
+}
+
+// Метод для запоминания концов записей векторов при сборе метрик
+template <typename T, typename Sizes>
+void WireCodec::mark(size_t header_bytes, const Sizes &sizes, size_t count)
+{
+    this->vector_ends.clear();
+    if (!Metrics::enabled())
+        return;
+
+    uint64_t end = header_bytes;
+    for (size_t i = 0; i < count; ++i)
+    {
+        end += sizeof(uint32_t) + static_cast<uint64_t>(sizes[i].size) * sizeof(T);
+        this->vector_ends.push_back(end);
+    }
+}
+
+// Метод для извлечения готовых результатов с учётом времени оборота
+template <typename T>
+size_t WireCodec::take(T *results, size_t count)
+{
+    size_t n = this->ring.pop(results, count);
+    // Времена отправки запоминаются только при сборе метрик
+    if (n == 0 || !Metrics::enabled())
+        return n;
+
+    std::lock_guard<std::mutex> lock(this->sent_mutex);
+    if (!this->sent_at.empty())
+    {
+        uint64_t now = monotonicNanos();
+        LatencyHistogram &rtt = Metrics::instance().rtt();
+        for (size_t i = 0; i < n && !this->sent_at.empty(); ++i)
+        {
+            rtt.record(now - this->sent_at.front());
+            this->sent_at.pop_front();
+        }
+    }
+    return n;
+}
+
+// Метод для отправки собранного массива iovec
+template <typename T>
+void WireCodec::flush(T *results, size_t count, size_t &received)
+{
+    PhaseTimer timer(Phase::CALC_SEND);
+    size_t first = 0;
+    size_t total = this->iov.size();
+    uint64_t chunk_sent = 0;
+    size_t stamped = 0;
+
+    while (first < total)
+    {
+        struct msghdr msg;
+        std::memset(&msg, 0, sizeof(msg));
+        size_t n = std::min(total - first, static_cast<size_t>(IOV_MAX));
+        msg.msg_iov = &this->iov[first];
+        msg.msg_iovlen = n;
+
+        // MSG_MORE удерживает неполные сегменты до последнего пакета порции
+        int flags = MSG_DONTWAIT | MSG_NOSIGNAL;
+        if (first + n < total)
+            flags |= MSG_MORE;
+
+        ssize_t sent = sendmsg(this->socket, &msg, flags);
+        ++this->counters.send_calls;
+        if (sent < 0)
+        {
+            if (errno == EINTR)
+                continue;
+            if (errno != EAGAIN && errno != EWOULDBLOCK)
+                throw NetworkError("Failed to send vector data", "NetworkManager.calc()");
+
+            // Сокет не готов к отправке - ожидание с приёмом готовых результатов
+            struct pollfd pfd;
+            pfd.fd = this->socket;
+            pfd.events = POLLOUT;
+            if (results != nullptr && received < count)
+                pfd.events |= POLLIN;
+            pfd.revents = 0;
+            if (poll(&pfd, 1, -1) < 0 && errno != EINTR)
+                throw NetworkError("Failed to wait for socket", "NetworkManager.calc()");
+            ++this->counters.poll_calls;
+
+            if ((pfd.revents & POLLIN) && results != nullptr)
+            {
+                this->fill(false);
+                received += this->take(results + received, count - received);
+            }
+            continue;
+        }
+        this->counters.bytes_sent += sent;
+        chunk_sent += sent;
+
+        // Векторы, переданные ядру целиком, получают время отправки
+        if (stamped < this->vector_ends.size() && this->vector_ends[stamped] <= chunk_sent)
+        {
+            uint64_t now = monotonicNanos();
+            std::lock_guard<std::mutex> lock(this->sent_mutex);
+            while (stamped < this->vector_ends.size() && this->vector_ends[stamped] <= chunk_sent)
+            {
+                this->sent_at.push_back(now);
+                ++stamped;
+            }
+        }
+
+        // Пропуск полностью отправленных фрагментов и сдвиг частично отправленного
+        size_t left = sent;
+        while (first < total && left >= this->iov[first].iov_len)
+        {
+            left -= this->iov[first].iov_len;
+            ++first;
+        }
+        if (left > 0)
+        {
+            this->iov[first].iov_base = static_cast<char *>(this->iov[first].iov_base) + left;
+            this->iov[first].iov_len -= left;
+        }
+    }
+    timer.stop(chunk_sent, this->gathered);
+}
+
+// Метод для приёма данных в кольцевой буфер
+size_t WireCodec::fill(bool block)
+{
+    size_t length;
+    char *space = this->ring.space(length);
+    if (length == 0)
+        return 0;
+
+    while (true)
+    {
+        ssize_t got = ::recv(this->socket, space, length, block ? 0 : MSG_DONTWAIT);
+        ++this->counters.recv_calls;
+        if (got < 0)
+        {
+            if (errno == EINTR)
+                continue;
+            if (!block && (errno == EAGAIN || errno == EWOULDBLOCK))
+                return 0;
+            throw NetworkError("Failed to receive result", "NetworkManager.calc()");
+        }
+        if (got == 0)
+            throw NetworkError("Connection closed by server", "NetworkManager.calc()");
+
+        this->ring.commit(got);
+        this->counters.bytes_received += got;
+        return got;
+    }
+}
+
+// Метод для отправки порции векторов
+template <typename T>
+void WireCodec::send(const BasicVectorBatch<T> &chunk)
+{
+    size_t received = 0;
+    this->gather(chunk);
+    this->flush<T>(nullptr, 0, received);
+}
+
+// Метод для отправки порции векторов из отображённого файла
+template <typename T>
+void WireCodec::send(const BasicMappedChunk<T> &chunk)
+{
+    size_t received = 0;
+    this->gather(chunk);
+    this->flush<T>(nullptr, 0, received);
+}
+
+// Метод для отправки выбранных векторов
+template <typename T>
+void WireCodec::send(const std::vector<BasicVectorView<T>> &views)
+{
+    size_t received = 0;
+    this->gather(views);
+    this->flush<T>(nullptr, 0, received);
+}
+
+// Метод для приёма заданного количества результатов
+template <typename T>
+void WireCodec::recv(T *results, size_t count)
+{
+    PhaseTimer timer(Phase::CALC_RECV);
+    size_t received = this->take(results, count);
+    while (received < count)
+    {
+        this->fill(true);
+        received += this->take(results + received, count - received);
+    }
+    timer.stop(count * sizeof(T), count);
+}
+
+// Метод для обмена порцией векторов
+template <typename T>
+std::vector<T> WireCodec::exchange(const BasicVectorBatch<T> &chunk)
+{
+    std::vector<T> results(chunk.size());
+    size_t received = 0;
+
+    this->gather(chunk);
+    this->flush(results.data(), results.size(), received);
+    this->recv(results.data() + received, results.size() - received);
+
+    return results;
+}
+
+// Метод для обмена порцией векторов из отображённого файла
+template <typename T>
+std::vector<T> WireCodec::exchange(const BasicMappedChunk<T> &chunk)
+{
+    std::vector<T> results(chunk.views.size());
+    size_t received = 0;
+
+    this->gather(chunk);
+    this->flush(results.data(), results.size(), received);
+    this->recv(results.data() + received, results.size() - received);
+
+    return results;
+}
+
+// Метод для обмена выбранными векторами
+template <typename T>
+std::vector<T> WireCodec::exchange(const std::vector<BasicVectorView<T>> &views)
+{
+    std::vector<T> results(views.size());
+    size_t received = 0;
+
+    this->gather(views);
+    this->flush(results.data(), results.size(), received);
+    this->recv(results.data() + received, results.size() - received);
+
+    return results;
+}
+
+const SyscallStats &WireCodec::stats() const
+{
+    return this->counters;
+}
+
+// Явное инстанцирование для поддерживаемых типов данных
+#define INSTANTIATE_CODEC(T)                                                        \
+    template size_t RecvRing::pop<T>(T *, size_t);                                  \
+    template void WireCodec::send<T>(const BasicVectorBatch<T> &);                  \
+    template void WireCodec::send<T>(const BasicMappedChunk<T> &);                  \
+    template void WireCodec::send<T>(const std::vector<BasicVectorView<T>> &);      \
+    template void WireCodec::recv<T>(T *, size_t);                                  \
+    template std::vector<T> WireCodec::exchange<T>(const BasicVectorBatch<T> &);    \
+    template std::vector<T> WireCodec::exchange<T>(const BasicMappedChunk<T> &);    \
+    template std::vector<T> WireCodec::exchange<T>(const std::vector<BasicVectorView<T>> &);
+FOR_EACH_DATA_TYPE(INSTANTIATE_CODEC)
@@ -0,0 +1,276 @@
+#ifndef WIRE_CODEC_H
+#define WIRE_CODEC_H
+
+#include <cstdint>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <vector>
+#include <sys/uio.h>
+#include "batch.h"
+#include "mapped.h"
+#include "errors.h"
+#include "metrics.h"
+
+/**
+* @file codec.h
+* @brief Определения классов для кодирования обмена векторами по сети.
+* @details Этот файл содержит определения классов для пакетной отправки векторов
+* через sendmsg с массивом iovec, пакетного приёма результатов через кольцевой буфер
+* и подсчёта системных вызовов.
+* @date 17.10.2026
+* @version 1.0
+* @authors Косов Р. С.
+* @copyright ИБСТ ПГУ
+*/
+
+/**
+* @brief Счётчики системных вызовов и переданных байтов.
+*/
+struct SyscallStats
+{
+    uint64_t send_calls; ///< Количество вызовов отправки.
+    uint64_t recv_calls; ///< Количество вызовов приёма.
+    uint64_t poll_calls; ///< Количество вызовов ожидания готовности сокета.
+    uint64_t bytes_sent; ///< Количество отправленных байтов.
+    uint64_t bytes_received; ///< Количество принятых байтов.
+};
+
+/**
+* @brief Кольцевой буфер для приёма результатов.
+* @details Вместимость кратна размеру результата, поэтому результат
+* никогда не разрывается на границе буфера.
+*/
+class RecvRing
+{
+public:
+    /**
+    * @brief Конструктор класса RecvRing.
+    * @param capacity Вместимость буфера в байтах (степень двойки).
+    */
+    explicit RecvRing(size_t capacity = 64 * 1024);
+
+    /**
+    * @brief Метод для получения свободного непрерывного участка буфера.
+    * @param length Длина участка в байтах.
+    * @return Указатель на начало участка.
+    */
+    char *space(size_t &length);
+
+    /**
+    * @brief Метод для фиксации принятых байтов.
+    * @param length Количество принятых байтов.
+    */
+    void commit(size_t length);
+
+    /**
+    * @brief Метод для извлечения готовых результатов.
+    * @tparam T Тип результатов.
+    * @param results Буфер для результатов.
+    * @param count Максимальное количество результатов.
+    * @return Количество извлечённых результатов.
+    */
+    template <typename T>
+    size_t pop(T *results, size_t count);
+
+    /**
+    * @brief Метод для получения количества байтов в буфере.
+    * @return Количество байтов.
+    */
+    size_t readable() const;
+
+private:
+    std::vector<char> buffer; ///< Память буфера.
+    size_t mask; ///< Маска индекса (вместимость - 1).
+    size_t head; ///< Счётчик прочитанных байтов.
+    size_t tail; ///< Счётчик записанных байтов.
+};
+
+/**
+* @brief Класс для обмена векторами и результатами по сокету.
+* @details Заголовки и значения векторов собираются в массив iovec и отправляются
+* небольшим числом вызовов sendmsg (с флагом MSG_MORE между пакетами). Пока сокет
+* не готов к отправке, принимаются уже готовые результаты, поэтому обмен не
+* блокируется при заполнении буферов сокета. Частичные отправка и приём
+* обрабатываются корректно. Методы обмена параметризованы типом значений T.
+* При включённых метриках отправка и приём учитываются как фазы calc_send
+* и calc_recv, а для каждого вектора измеряется время от передачи его
+* последнего байта ядру до приёма его результата.
+*/
+class WireCodec
+{
+public:
+    /**
+    * @brief Конструктор класса WireCodec.
+    */
+    WireCodec();
+
+    /**
+    * @brief Метод для привязки кодека к сокету.
+    * @param socket Дескриптор подключённого сокета.
+    */
+    void attach(int socket);
+
+    /**
+    * @brief Метод для начала передачи с заданным количеством векторов.
+    * @details Количество отправляется вместе с первой порцией векторов.
+    * @param num_vectors Общее количество векторов.
+    * @throw NetworkError Если не удалось отправить количество векторов.
+    */
+    void begin(uint32_t num_vectors);
+
+    /**
+    * @brief Метод для сброса счётчиков системных вызовов.
+    */
+    void reset();
+
+    /**
+    * @brief Метод для начала очередного раунда передачи на том же подключении.
+    * @details В отличие от begin() не сбрасывает счётчики системных вызовов.
+    * Сервер обрабатывает раунды по порядку, поэтому новый раунд можно начать,
+    * не дожидаясь результатов предыдущего.
+    * @param num_vectors Количество векторов раунда.
+    * @throw NetworkError Если не удалось отправить количество векторов.
+    */
+    void round(uint32_t num_vectors);
+
+    /**
+    * @brief Метод для отправки порции векторов без ожидания результатов.
+    * @param chunk Порция векторов.
+    * @throw NetworkError Если не удалось отправить данные.
+    */
+    template <typename T>
+    void send(const BasicVectorBatch<T> &chunk);
+
+    /**
+    * @brief Метод для отправки порции векторов из отображённого файла без ожидания результатов.
+    * @param chunk Порция векторов.
+    * @throw NetworkError Если не удалось отправить данные.
+    */
+    template <typename T>
+    void send(const BasicMappedChunk<T> &chunk);
+
+    /**
+    * @brief Метод для отправки выбранных векторов без ожидания результатов.
+    * @param views Представления векторов.
+    * @throw NetworkError Если не удалось отправить данные.
+    */
+    template <typename T>
+    void send(const std::vector<BasicVectorView<T>> &views);
+
+    /**
+    * @brief Метод для приёма заданного количества результатов.
+    * @param results Буфер для результатов.
+    * @param count Количество результатов.
+    * @throw NetworkError Если не удалось получить данные или соединение закрыто.
+    */
+    template <typename T>
+    void recv(T *results, size_t count);
+
+    /**
+    * @brief Метод для обмена порцией векторов.
+    * @param chunk Порция векторов.
+    * @return Результаты обработки порции.
+    * @throw NetworkError Если не удалось отправить или получить данные.
+    */
+    template <typename T>
+    std::vector<T> exchange(const BasicVectorBatch<T> &chunk);
+
+    /**
+    * @brief Метод для обмена порцией векторов из отображённого файла.
+    * @param chunk Порция векторов.
+    * @return Результаты обработки порции.
+    * @throw NetworkError Если не удалось отправить или получить данные.
+    */
+    template <typename T>
+    std::vector<T> exchange(const BasicMappedChunk<T> &chunk);
+
+    /**
+    * @brief Метод для обмена выбранными векторами.
+    * @param views Представления векторов.
+    * @return Результаты обработки векторов.
+    * @throw NetworkError Если не удалось отправить или получить данные.
+    */
+    template <typename T>
+    std::vector<T> exchange(const std::vector<BasicVectorView<T>> &views);
+
+    /**
+    * @brief Метод для получения счётчиков системных вызовов.
+    * @return Счётчики с момента последнего вызова begin().
+    */
+    const SyscallStats &stats() const;
+
+private:
+    int socket; ///< Дескриптор сокета.
+    uint32_t pending_count; ///< Количество векторов, ещё не отправленное серверу.
+    bool count_pending; ///< Флаг ожидания отправки количества векторов.
+    RecvRing ring; ///< Кольцевой буфер приёма.
+    std::vector<uint32_t> headers; ///< Заголовки (размеры) векторов текущей порции.
+    std::vector<struct iovec> iov; ///< Массив фрагментов текущей порции.
+    SyscallStats counters; ///< Счётчики системных вызовов.
+    size_t gathered; ///< Количество векторов в собранной порции.
+    std::vector<uint64_t> vector_ends; ///< Концы записей векторов порции в байтах (при сборе метрик).
+    std::deque<uint64_t> sent_at; ///< Время отправки векторов, результаты которых ещё не приняты.
+    std::mutex sent_mutex; ///< Мьютекс времён отправки (send() и recv() работают в разных потоках).
+
+    /**
+    * @brief Метод для сборки массива iovec для порции векторов.
+    * @param chunk Порция векторов.
+    */
+    template <typename T>
+    void gather(const BasicVectorBatch<T> &chunk);
+
+    /**
+    * @brief Метод для сборки массива iovec для порции из отображённого файла.
+    * @param chunk Порция векторов.
+    */
+    template <typename T>
+    void gather(const BasicMappedChunk<T> &chunk);
+
+    /**
+    * @brief Метод для сборки массива iovec для выбранных векторов.
+    * @param views Представления векторов.
+    */
+    template <typename T>
+    void gather(const std::vector<BasicVectorView<T>> &views);
+
+    /**
+    * @brief Метод для отправки собранного массива iovec.
+    * @details Если передан буфер результатов, то во время ожидания готовности
+    * сокета к отправке из него принимаются готовые результаты.
+    * @param results Буфер для результатов (может быть nullptr).
+    * @param count Ожидаемое количество результатов.
+    * @param received Количество уже принятых результатов.
+    * @throw NetworkError Если не удалось отправить данные.
+    */
+    template <typename T>
+    void flush(T *results, size_t count, size_t &received);
+
+    /**
+    * @brief Метод для запоминания концов записей векторов при сборе метрик.
+    * @param header_bytes Объём заголовка перед первым вектором.
+    * @param sizes Размеры векторов порции.
+    * @param count Количество векторов.
+    */
+    template <typename T, typename Sizes>
+    void mark(size_t header_bytes, const Sizes &sizes, size_t count);
+
+    /**
+    * @brief Метод для извлечения готовых результатов с учётом времени оборота.
+    * @param results Буфер для результатов.
+    * @param count Максимальное количество результатов.
+    * @return Количество извлечённых результатов.
+    */
+    template <typename T>
+    size_t take(T *results, size_t count);
+
+    /**
+    * @brief Метод для приёма данных в кольцевой буфер.
+    * @param block Ожидать ли поступления данных.
+    * @return Количество принятых байтов (0, если данных нет).
+    * @throw NetworkError Если не удалось получить данные или соединение закрыто.
+    */
+    size_t fill(bool block);
+};
+
+#endif // WIRE_CODEC_H
@@ -0,0 +1,412 @@
+#include "compute.h"
+#include "metrics.h"
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <thread>
+#include <type_traits>
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+// Количество 16-битных значений, после которого 32-битные частичные суммы сбрасываются в 64-битную
+static const size_t BLOCK_16 = 1 << 16;
+
+// Функция для чтения значения без требований к выравниванию
+template <typename T>
+static inline T load(const T *p)
+{
+    T value;
+    std::memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+// Функция для ограничения точной суммы диапазоном типа
+template <typename T>
+static T saturate(__int128 sum)
+{
+    if (sum > static_cast<__int128>(std::numeric_limits<T>::max()))
+        return std::numeric_limits<T>::max();
+    if (sum < static_cast<__int128>(std::numeric_limits<T>::min()))
+        return std::numeric_limits<T>::min();
+    return static_cast<T>(sum);
+}
+
+// Функция для точной суммы целых значений без векторных инструкций
+template <typename T>
+static __int128 sumScalar(const T *data, size_t size)
+{
+    // Сумма не более 2^32 значений до 32 бит помещается в 64-битный накопитель
+    if (sizeof(T) <= 4)
+    {
+        typedef typename std::conditional<std::is_signed<T>::value, int64_t, uint64_t>::type Wide;
+        Wide sum = 0;
+        for (size_t i = 0; i < size; ++i)
+            sum += load(data + i);
+        return sum;
+    }
+    __int128 sum = 0;
+    for (size_t i = 0; i < size; ++i)
+        sum += load(data + i);
+    return sum;
+}
+
+#if defined(__x86_64__)
+// Функция для суммы 16-битных значений (AVX2)
+template <bool Signed>
+__attribute__((target("avx2"))) static __int128 sum16Avx2(const void *data, size_t size)
+{
+    const char *p = static_cast<const char *>(data);
+    __int128 total = 0;
+    size_t i = 0;
+    while (size - i >= 16)
+    {
+        // 32-битные частичные суммы не переполняются в пределах блока
+        size_t end = i + std::min(BLOCK_16, (size - i) / 16 * 16);
+        __m256i acc = _mm256_setzero_si256();
+        for (; i < end; i += 16)
+        {
+            __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p + i * 2));
+            __m128i lo = _mm256_castsi256_si128(v);
+            __m128i hi = _mm256_extracti128_si256(v, 1);
+            acc = _mm256_add_epi32(acc, Signed ? _mm256_cvtepi16_epi32(lo) : _mm256_cvtepu16_epi32(lo));
+            acc = _mm256_add_epi32(acc, Signed ? _mm256_cvtepi16_epi32(hi) : _mm256_cvtepu16_epi32(hi));
+        }
+        alignas(32) int32_t lanes[8];
+        _mm256_store_si256(reinterpret_cast<__m256i *>(lanes), acc);
+        for (int32_t lane : lanes)
+            total += Signed ? static_cast<int64_t>(lane) : static_cast<int64_t>(static_cast<uint32_t>(lane));
+    }
+    typedef typename std::conditional<Signed, int16_t, uint16_t>::type T;
+    return total + sumScalar(reinterpret_cast<const T *>(p) + i, size - i);
+}
+
+// Функция для суммы 32-битных значений (AVX2)
+template <bool Signed>
+__attribute__((target("avx2"))) static __int128 sum32Avx2(const void *data, size_t size)
+{
+    const char *p = static_cast<const char *>(data);
+    __m256i acc0 = _mm256_setzero_si256();
+    __m256i acc1 = _mm256_setzero_si256();
+    size_t i = 0;
+    for (; size - i >= 8; i += 8)
+    {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p + i * 4));
+        __m128i lo = _mm256_castsi256_si128(v);
+        __m128i hi = _mm256_extracti128_si256(v, 1);
+        acc0 = _mm256_add_epi64(acc0, Signed ? _mm256_cvtepi32_epi64(lo) : _mm256_cvtepu32_epi64(lo));
+        acc1 = _mm256_add_epi64(acc1, Signed ? _mm256_cvtepi32_epi64(hi) : _mm256_cvtepu32_epi64(hi));
+    }
+
+    // Точная сумма помещается в 64 бита, поэтому сложение по модулю 2^64 её не искажает
+    alignas(32) uint64_t lanes[4];
+    _mm256_store_si256(reinterpret_cast<__m256i *>(lanes), _mm256_add_epi64(acc0, acc1));
+    uint64_t sum = lanes[0] + lanes[1] + lanes[2] + lanes[3];
+    typedef typename std::conditional<Signed, int32_t, uint32_t>::type T;
+    __int128 total = Signed ? static_cast<__int128>(static_cast<int64_t>(sum)) : static_cast<__int128>(sum);
+    return total + sumScalar(reinterpret_cast<const T *>(p) + i, size - i);
+}
+
+// Функция для суммы 64-битных значений (AVX2)
+template <bool Signed>
+__attribute__((target("avx2"))) static __int128 sum64Avx2(const void *data, size_t size)
+{
+    const char *p = static_cast<const char *>(data);
+    const __m256i sign = _mm256_set1_epi64x(std::numeric_limits<int64_t>::min());
+    __m256i low = _mm256_setzero_si256();
+    __m256i carry = _mm256_setzero_si256();
+    __m256i negative = _mm256_setzero_si256();
+    size_t i = 0;
+    for (; size - i >= 4; i += 4)
+    {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p + i * 8));
+        __m256i next = _mm256_add_epi64(low, v);
+
+        // Перенос, если сумма без знака стала меньше слагаемого (сравнение со сдвигом знакового бита)
+        __m256i overflow = _mm256_cmpgt_epi64(_mm256_xor_si256(v, sign), _mm256_xor_si256(next, sign));
+        carry = _mm256_sub_epi64(carry, overflow);
+        if (Signed)
+            negative = _mm256_sub_epi64(negative, _mm256_cmpgt_epi64(_mm256_setzero_si256(), v));
+        low = next;
+    }
+
+    // Знаковое значение равно беззнаковому минус 2^64 для отрицательных
+    alignas(32) uint64_t low_lanes[4], carry_lanes[4], negative_lanes[4];
+    _mm256_store_si256(reinterpret_cast<__m256i *>(low_lanes), low);
+    _mm256_store_si256(reinterpret_cast<__m256i *>(carry_lanes), carry);
+    _mm256_store_si256(reinterpret_cast<__m256i *>(negative_lanes), negative);
+    __int128 total = 0;
+    for (int k = 0; k < 4; ++k)
+        total += static_cast<__int128>(low_lanes[k]) +
+                 (static_cast<__int128>(carry_lanes[k]) << 64) -
+                 (static_cast<__int128>(negative_lanes[k]) << 64);
+    typedef typename std::conditional<Signed, int64_t, uint64_t>::type T;
+    return total + sumScalar(reinterpret_cast<const T *>(p) + i, size - i);
+}
+
+// Функция для суммы 16-битных значений (AVX-512)
+template <bool Signed>
+__attribute__((target("avx512f"))) static __int128 sum16Avx512(const void *data, size_t size)
+{
+    const char *p = static_cast<const char *>(data);
+    __int128 total = 0;
+    size_t i = 0;
+    while (size - i >= 32)
+    {
+        size_t end = i + std::min(BLOCK_16, (size - i) / 32 * 32);
+        __m512i acc = _mm512_setzero_si512();
+        for (; i < end; i += 32)
+        {
+            // Расширение с нулевой маской не читает неинициализированный регистр
+            __m256i lo = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p + i * 2));
+            __m256i hi = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p + i * 2 + 32));
+            acc = _mm512_add_epi32(acc, Signed ? _mm512_maskz_cvtepi16_epi32(0xFFFF, lo) : _mm512_maskz_cvtepu16_epi32(0xFFFF, lo));
+            acc = _mm512_add_epi32(acc, Signed ? _mm512_maskz_cvtepi16_epi32(0xFFFF, hi) : _mm512_maskz_cvtepu16_epi32(0xFFFF, hi));
+        }
+        alignas(64) int32_t lanes[16];
+        _mm512_store_si512(lanes, acc);
+        for (int32_t lane : lanes)
+            total += Signed ? static_cast<int64_t>(lane) : static_cast<int64_t>(static_cast<uint32_t>(lane));
+    }
+    typedef typename std::conditional<Signed, int16_t, uint16_t>::type T;
+    return total + sumScalar(reinterpret_cast<const T *>(p) + i, size - i);
+}
+
+// Функция для суммы 32-битных значений (AVX-512)
+template <bool Signed>
+__attribute__((target("avx512f"))) static __int128 sum32Avx512(const void *data, size_t size)
+{
+    const char *p = static_cast<const char *>(data);
+    __m512i acc0 = _mm512_setzero_si512();
+    __m512i acc1 = _mm512_setzero_si512();
+    size_t i = 0;
+    for (; size - i >= 16; i += 16)
+    {
+        __m256i lo = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p + i * 4));
+        __m256i hi = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p + i * 4 + 32));
+        acc0 = _mm512_add_epi64(acc0, Signed ? _mm512_maskz_cvtepi32_epi64(0xFF, lo) : _mm512_maskz_cvtepu32_epi64(0xFF, lo));
+        acc1 = _mm512_add_epi64(acc1, Signed ? _mm512_maskz_cvtepi32_epi64(0xFF, hi) : _mm512_maskz_cvtepu32_epi64(0xFF, hi));
+    }
+    alignas(64) uint64_t lanes[8];
+    _mm512_store_si512(lanes, _mm512_add_epi64(acc0, acc1));
+    uint64_t sum = 0;
+    for (uint64_t lane : lanes)
+        sum += lane;
+    typedef typename std::conditional<Signed, int32_t, uint32_t>::type T;
+    __int128 total = Signed ? static_cast<__int128>(static_cast<int64_t>(sum)) : static_cast<__int128>(sum);
+    return total + sumScalar(reinterpret_cast<const T *>(p) + i, size - i);
+}
+
+// Функция для суммы 64-битных значений (AVX-512)
+template <bool Signed>
+__attribute__((target("avx512f"))) static __int128 sum64Avx512(const void *data, size_t size)
+{
+    const char *p = static_cast<const char *>(data);
+    const __m512i one = _mm512_set1_epi64(1);
+    __m512i low = _mm512_setzero_si512();
+    __m512i carry = _mm512_setzero_si512();
+    __m512i negative = _mm512_setzero_si512();
+    size_t i = 0;
+    for (; size - i >= 8; i += 8)
+    {
+        __m512i v = _mm512_loadu_si512(p + i * 8);
+        __m512i next = _mm512_add_epi64(low, v);
+        carry = _mm512_mask_add_epi64(carry, _mm512_cmplt_epu64_mask(next, v), carry, one);
+        if (Signed)
+            negative = _mm512_mask_add_epi64(negative, _mm512_cmplt_epi64_mask(v, _mm512_setzero_si512()), negative, one);
+        low = next;
+    }
+
+    alignas(64) uint64_t low_lanes[8], carry_lanes[8], negative_lanes[8];
+    _mm512_store_si512(low_lanes, low);
+    _mm512_store_si512(carry_lanes, carry);
+    _mm512_store_si512(negative_lanes, negative);
+    __int128 total = 0;
+    for (int k = 0; k < 8; ++k)
+        total += static_cast<__int128>(low_lanes[k]) +
+                 (static_cast<__int128>(carry_lanes[k]) << 64) -
+                 (static_cast<__int128>(negative_lanes[k]) << 64);
+    typedef typename std::conditional<Signed, int64_t, uint64_t>::type T;
+    return total + sumScalar(reinterpret_cast<const T *>(p) + i, size - i);
+}
+#endif
+
+// Функция для точной суммы целых значений выбранным набором инструкций
+template <typename T>
+static __int128 sumIntegral(const T *data, size_t size, SimdLevel level)
+{
+#if defined(__x86_64__)
+    const bool is_signed = std::is_signed<T>::value;
+    if (level == SimdLevel::AVX512)
+    {
+        if (sizeof(T) == 2)
+            return is_signed ? sum16Avx512<true>(data, size) : sum16Avx512<false>(data, size);
+        if (sizeof(T) == 4)
+            return is_signed ? sum32Avx512<true>(data, size) : sum32Avx512<false>(data, size);
+        return is_signed ? sum64Avx512<true>(data, size) : sum64Avx512<false>(data, size);
+    }
+    if (level == SimdLevel::AVX2)
+    {
+        if (sizeof(T) == 2)
+            return is_signed ? sum16Avx2<true>(data, size) : sum16Avx2<false>(data, size);
+        if (sizeof(T) == 4)
+            return is_signed ? sum32Avx2<true>(data, size) : sum32Avx2<false>(data, size);
+        return is_signed ? sum64Avx2<true>(data, size) : sum64Avx2<false>(data, size);
+    }
+#endif
+    (void)level;
+    return sumScalar(data, size);
+}
+
+// Функция для вычисления результата вектора целых значений
+template <typename T>
+static T reduceTyped(const T *data, size_t size, SimdLevel level, std::true_type)
+{
+    return saturate<T>(sumIntegral(data, size, level));
+}
+
+// Функция для вычисления результата вектора значений с плавающей точкой
+template <typename T>
+static T reduceTyped(const T *data, size_t size, SimdLevel, std::false_type)
+{
+    // Значения складываются строго по порядку, как на сервере
+    T sum = 0;
+    for (size_t i = 0; i < size; ++i)
+        sum += load(data + i);
+    return sum;
+}
+
+// Функция для получения лучшего набора инструкций
+SimdLevel simdLevel()
+{
+    // Возможности процессора проверяются один раз
+    static const SimdLevel level = simdSupported(SimdLevel::AVX512) ? SimdLevel::AVX512
+                                   : simdSupported(SimdLevel::AVX2) ? SimdLevel::AVX2
+                                                                    : SimdLevel::SCALAR;
+    return level;
+}
+
+// Функция для проверки поддержки набора инструкций
+bool simdSupported(SimdLevel level)
+{
+    switch (level)
+    {
+#if defined(__x86_64__)
+    case SimdLevel::AVX512:
+        return __builtin_cpu_supports("avx512f");
+    case SimdLevel::AVX2:
+        return __builtin_cpu_supports("avx2");
+#endif
+    case SimdLevel::SCALAR:
+        return true;
+    default:
+        return false;
+    }
+}
+
+const char *simdLevelName(SimdLevel level)
+{
+    switch (level)
+    {
+    case SimdLevel::AVX512:
+        return "avx512";
+    case SimdLevel::AVX2:
+        return "avx2";
+    default:
+        return "scalar";
+    }
+}
+
+// Функция для вычисления результата вектора
+template <typename T>
+T reduceVector(const T *data, size_t size)
+{
+    return reduceTyped(data, size, simdLevel(), std::is_integral<T>());
+}
+
+// Функция для вычисления результата вектора заданным набором инструкций
+template <typename T>
+T reduceVector(const T *data, size_t size, SimdLevel level)
+{
+    return reduceTyped(data, size, level, std::is_integral<T>());
+}
+
+// Конструктор
+template <typename T>
+BasicLocalEngine<T>::BasicLocalEngine(size_t threads)
+    : threads(threads > 0 ? threads : 1) {}
+
+template <typename T>
+std::vector<T> BasicLocalEngine<T>::calc(const BasicVectorBatch<T> &chunk)
+{
+    std::vector<BasicVectorView<T>> views(chunk.size());
+    for (size_t i = 0; i < chunk.size(); ++i)
+        views[i] = chunk[i];
+    return this->calc(views.data(), views.size());
+}
+
+template <typename T>
+std::vector<T> BasicLocalEngine<T>::calc(const BasicMappedChunk<T> &chunk)
+{
+    return this->calc(chunk.views.data(), chunk.views.size());
+}
+
+// Метод для вычисления результатов набора векторов
+template <typename T>
+std::vector<T> BasicLocalEngine<T>::calc(const BasicVectorView<T> *views, size_t count)
+{
+    PhaseTimer timer(Phase::COMPUTE);
+    std::vector<T> results(count);
+    size_t values = 0;
+    for (size_t i = 0; i < count; ++i)
+        values += views[i].size;
+
+    auto work = [&](size_t begin, size_t end)
+    {
+        for (size_t i = begin; i < end; ++i)
+            results[i] = reduceVector(views[i].data, views[i].size);
+    };
+
+    // Векторы делятся на участки с примерно равным количеством значений
+    size_t parts = std::min(this->threads, std::max<size_t>(values / MIN_VALUES_PER_THREAD, 1));
+    if (parts <= 1 || count < 2)
+    {
+        work(0, count);
+    }
+    else
+    {
+        std::vector<std::thread> workers;
+        size_t begin = 0;
+        size_t taken = 0;
+        for (size_t part = 0; part < parts; ++part)
+        {
+            // Последний участок забирает остаток и обрабатывается вызывающим потоком
+            size_t end = count;
+            if (part + 1 < parts)
+            {
+                size_t target = values / parts * (part + 1);
+                for (end = begin; end < count && taken < target; ++end)
+                    taken += views[end].size;
+            }
+            if (end == begin)
+                continue;
+            if (part + 1 < parts)
+                workers.emplace_back(work, begin, end);
+            else
+                work(begin, end);
+            begin = end;
+        }
+        for (auto &worker : workers)
+            worker.join();
+    }
+
+    timer.stop(values * sizeof(T), count);
+    return results;
+}
+
+// Явное инстанцирование для поддерживаемых типов данных
+#define INSTANTIATE_COMPUTE(T)                                       \
+    template T reduceVector<T>(const T *, size_t);                   \
+    template T reduceVector<T>(const T *, size_t, SimdLevel);        \
+    template class BasicLocalEngine<T>;
+FOR_EACH_DATA_TYPE(INSTANTIATE_COMPUTE)
@@ -0,0 +1,127 @@
+#ifndef COMPUTE_H
+#define COMPUTE_H
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include "batch.h"
+#include "mapped.h"
+#include "types.h"
+
+/**
+* @file compute.h
+* @brief Определения функций и класса локального вычисления результатов векторов.
+* @details Локально вычисляется та же операция, что и на сервере: сумма значений
+* вектора. Для целых типов сумма считается точно и ограничивается диапазоном
+* типа (насыщение), для типов с плавающей точкой значения складываются по порядку
+* в исходном типе. Целые суммы вычисляются ядрами AVX-512 или AVX2 (значения
+* расширяются до 32- или 64-битных частичных сумм, переносы 64-битных сумм
+* подсчитываются отдельно), набор инструкций выбирается один раз по возможностям
+* процессора. Суммы с плавающей точкой считаются последовательно: другой порядок
+* сложения изменил бы результат.
+* @date 17.10.2026
+* @version 1.0
+* @authors Косов Р. С.
+* @copyright ИБСТ ПГУ
+*/
+
+/**
+* @brief Набор векторных инструкций ядер суммирования.
+*/
+enum class SimdLevel
+{
+    SCALAR, ///< Без векторных инструкций.
+    AVX2,   ///< AVX2 (256-битные регистры).
+    AVX512  ///< AVX-512F (512-битные регистры).
+};
+
+/**
+* @brief Функция для получения лучшего набора инструкций, поддерживаемого процессором.
+* @return Набор инструкций.
+*/
+SimdLevel simdLevel();
+
+/**
+* @brief Функция для проверки поддержки набора инструкций процессором.
+* @param level Набор инструкций.
+* @return true, если ядра этого набора можно вызывать.
+*/
+bool simdSupported(SimdLevel level);
+
+/**
+* @brief Функция для получения названия набора инструкций.
+* @param level Набор инструкций.
+* @return Название ("scalar", "avx2", "avx512").
+*/
+const char *simdLevelName(SimdLevel level);
+
+/**
+* @brief Функция для вычисления результата вектора.
+* @tparam T Тип значений вектора.
+* @param data Значения вектора (выравнивание не требуется).
+* @param size Количество значений.
+* @return Сумма значений с семантикой сервера.
+*/
+template <typename T>
+T reduceVector(const T *data, size_t size);
+
+/**
+* @brief Функция для вычисления результата вектора заданным набором инструкций.
+* @tparam T Тип значений вектора.
+* @param data Значения вектора (выравнивание не требуется).
+* @param size Количество значений.
+* @param level Набор инструкций (должен поддерживаться процессором).
+* @return Сумма значений с семантикой сервера.
+*/
+template <typename T>
+T reduceVector(const T *data, size_t size, SimdLevel level);
+
+/**
+* @brief Класс для локального вычисления результатов порций векторов.
+* @details Векторы порции делятся между потоками на участки с примерно равным
+* количеством значений; маленькие порции обрабатываются в вызывающем потоке.
+* @tparam T Тип значений векторов.
+*/
+template <typename T>
+class BasicLocalEngine
+{
+public:
+    /// Наименьшее количество значений на поток.
+    static const size_t MIN_VALUES_PER_THREAD = 1 << 16;
+
+    /**
+    * @brief Конструктор класса BasicLocalEngine.
+    * @param threads Количество потоков.
+    */
+    explicit BasicLocalEngine(size_t threads);
+
+    /**
+    * @brief Метод для вычисления результатов порции векторов.
+    * @param chunk Порция векторов.
+    * @return Результаты векторов.
+    */
+    std::vector<T> calc(const BasicVectorBatch<T> &chunk);
+
+    /**
+    * @brief Метод для вычисления результатов порции из отображённого файла.
+    * @param chunk Порция векторов.
+    * @return Результаты векторов.
+    */
+    std::vector<T> calc(const BasicMappedChunk<T> &chunk);
+
+private:
+    size_t threads; ///< Количество потоков.
+
+    /**
+    * @brief Метод для вычисления результатов набора векторов.
+    * @param views Представления векторов.
+    * @param count Количество векторов.
+    * @return Результаты векторов.
+    */
+    std::vector<T> calc(const BasicVectorView<T> *views, size_t count);
+};
+
+/// Локальное вычисление результатов векторов из значений uint32_t.
+typedef BasicLocalEngine<uint32_t> LocalEngine;
+
+#endif // COMPUTE_H
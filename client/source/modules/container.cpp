@@ -0,0 +1,282 @@
+#include "container.h"
+#include "crc32c.h"
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static_assert(sizeof(ContainerHeader) == 64, "Container header must be 64 bytes");
+static_assert(sizeof(ContainerIndexEntry) == 16, "Container index entry must be 16 bytes");
+
+// Функция для проверки, записан ли файл в формате v2
+bool isContainerFile(const std::string &path)
+{
+    std::ifstream input_file(path, std::ios::binary);
+    char magic[sizeof(CONTAINER_MAGIC)];
+    return input_file.read(magic, sizeof(magic)) &&
+           std::memcmp(magic, CONTAINER_MAGIC, sizeof(magic)) == 0;
+}
+
+// Конструктор писателя
+template <typename T>
+BasicContainerWriter<T>::BasicContainerWriter(const std::string &path)
+    : output_file(path, std::ios::binary),
+      path(path),
+      offset(sizeof(ContainerHeader))
+{
+    if (!this->output_file.is_open())
+    {
+        throw IOError("Failed to open output file \"" + this->path + "\"", "ContainerWriter.ContainerWriter()");
+    }
+
+    // Место под заголовок - он записывается при закрытии
+    ContainerHeader header;
+    std::memset(&header, 0, sizeof(header));
+    this->output_file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+}
+
+// Метод для дополнения файла нулями до границы выравнивания
+template <typename T>
+void BasicContainerWriter<T>::pad()
+{
+    static const char zeros[CONTAINER_ALIGN] = {};
+    size_t tail = this->offset % CONTAINER_ALIGN;
+    if (tail != 0)
+    {
+        this->output_file.write(zeros, CONTAINER_ALIGN - tail);
+        this->offset += CONTAINER_ALIGN - tail;
+    }
+}
+
+// Метод для добавления вектора
+template <typename T>
+void BasicContainerWriter<T>::append(const T *values, uint32_t size)
+{
+    this->pad();
+
+    size_t bytes = static_cast<size_t>(size) * sizeof(T);
+    ContainerIndexEntry entry;
+    entry.offset = this->offset;
+    entry.size = size;
+    entry.crc = crc32c(values, bytes);
+    this->index.push_back(entry);
+
+    this->output_file.write(reinterpret_cast<const char *>(values), bytes);
+    if (!this->output_file)
+    {
+        throw IOError("Failed to write output file \"" + this->path + "\"", "ContainerWriter.append()");
+    }
+    this->offset += bytes;
+}
+
+// Метод для завершения записи
+template <typename T>
+void BasicContainerWriter<T>::close()
+{
+    this->pad();
+
+    ContainerHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, CONTAINER_MAGIC, sizeof(header.magic));
+    header.version = CONTAINER_VERSION;
+    header.value_type = static_cast<uint16_t>(DataTypeOf<T>::value);
+    header.value_size = sizeof(T);
+    header.header_size = sizeof(ContainerHeader);
+    header.count = this->index.size();
+    header.data_offset = sizeof(ContainerHeader);
+    header.index_offset = this->offset;
+    header.index_crc = crc32c(this->index.data(), this->index.size() * sizeof(ContainerIndexEntry));
+    header.header_crc = crc32c(&header, offsetof(ContainerHeader, header_crc));
+
+    this->output_file.write(
+        reinterpret_cast<const char *>(this->index.data()),
+        this->index.size() * sizeof(ContainerIndexEntry));
+    this->output_file.seekp(0);
+    this->output_file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    this->output_file.close();
+    if (!this->output_file)
+    {
+        throw IOError("Failed to write output file \"" + this->path + "\"", "ContainerWriter.close()");
+    }
+}
+
+// Конструктор читателя
+template <typename T>
+BasicContainerInput<T>::BasicContainerInput(const std::string &path)
+    : fd(-1),
+      base(nullptr),
+      length(0),
+      num_vectors(0),
+      index(nullptr),
+      data_offset(0),
+      data_end(0)
+{
+    this->fd = ::open(path.c_str(), O_RDONLY);
+    if (this->fd < 0)
+    {
+        throw IOError("Failed to open input file for reading.", "ContainerInput.ContainerInput()");
+    }
+
+    struct stat st;
+    if (fstat(this->fd, &st) < 0)
+    {
+        ::close(this->fd);
+        throw IOError("Failed to get size of input file", "ContainerInput.ContainerInput()");
+    }
+    this->length = st.st_size;
+    if (this->length < sizeof(ContainerHeader))
+    {
+        ::close(this->fd);
+        throw DataDecodeError("Container file is too short for header", "ContainerInput.ContainerInput()");
+    }
+
+    void *mem = mmap(nullptr, this->length, PROT_READ, MAP_SHARED, this->fd, 0);
+    if (mem == MAP_FAILED)
+    {
+        ::close(this->fd);
+        throw IOError("Failed to map input file", "ContainerInput.ContainerInput()");
+    }
+    this->base = static_cast<const char *>(mem);
+
+    // Проверка заголовка до обращения к индексу
+    ContainerHeader header;
+    std::memcpy(&header, this->base, sizeof(header));
+    std::string error;
+    if (std::memcmp(header.magic, CONTAINER_MAGIC, sizeof(header.magic)) != 0)
+        error = "Not a container file";
+    else if (header.version != CONTAINER_VERSION)
+        error = "Unsupported container version " + std::to_string(header.version);
+    else if (header.header_crc != crc32c(&header, offsetof(ContainerHeader, header_crc)))
+        error = "Container header checksum mismatch";
+    else if (header.value_type != static_cast<uint16_t>(DataTypeOf<T>::value) || header.value_size != sizeof(T))
+        error = "Container holds values of another type";
+    else if (header.data_offset < sizeof(ContainerHeader) || header.index_offset < header.data_offset ||
+             header.index_offset > this->length || header.index_offset % CONTAINER_ALIGN != 0 ||
+             header.count > (this->length - header.index_offset) / sizeof(ContainerIndexEntry))
+        error = "Container index is out of file bounds";
+    else if (header.index_crc != crc32c(this->base + header.index_offset, header.count * sizeof(ContainerIndexEntry)))
+        error = "Container index checksum mismatch";
+    if (!error.empty())
+    {
+        munmap(mem, this->length);
+        ::close(this->fd);
+        throw DataDecodeError(error, "ContainerInput.ContainerInput()");
+    }
+
+    this->num_vectors = header.count;
+    this->index = reinterpret_cast<const ContainerIndexEntry *>(this->base + header.index_offset);
+    this->data_offset = header.data_offset;
+    this->data_end = header.index_offset;
+}
+
+// Конструктор перемещения
+template <typename T>
+BasicContainerInput<T>::BasicContainerInput(BasicContainerInput &&other)
+    : fd(other.fd),
+      base(other.base),
+      length(other.length),
+      num_vectors(other.num_vectors),
+      index(other.index),
+      data_offset(other.data_offset),
+      data_end(other.data_end)
+{
+    other.fd = -1;
+    other.base = nullptr;
+    other.length = 0;
+}
+
+// Деструктор
+template <typename T>
+BasicContainerInput<T>::~BasicContainerInput()
+{
+    if (this->base != nullptr)
+        munmap(const_cast<char *>(this->base), this->length);
+    if (this->fd >= 0)
+        ::close(this->fd);
+}
+
+template <typename T>
+uint64_t BasicContainerInput<T>::count() const
+{
+    return this->num_vectors;
+}
+
+// Метод для получения проверенной записи индекса
+template <typename T>
+ContainerIndexEntry BasicContainerInput<T>::entry(uint64_t k) const
+{
+    if (k >= this->num_vectors)
+    {
+        throw DataDecodeError("Vector " + std::to_string(k) + " is out of range", "ContainerInput.entry()");
+    }
+
+    ContainerIndexEntry e = this->index[k];
+    uint64_t bytes = static_cast<uint64_t>(e.size) * sizeof(T);
+    if (e.offset < this->data_offset || e.offset % CONTAINER_ALIGN != 0 ||
+        e.offset > this->data_end || bytes > this->data_end - e.offset)
+    {
+        throw DataDecodeError(
+            "Vector " + std::to_string(k) + " is out of file bounds",
+            "ContainerInput.entry()");
+    }
+    return e;
+}
+
+// Метод для получения вектора без копирования
+template <typename T>
+BasicVectorView<T> BasicContainerInput<T>::view(uint64_t k) const
+{
+    ContainerIndexEntry e = this->entry(k);
+    BasicVectorView<T> vec;
+    vec.data = reinterpret_cast<const T *>(this->base + e.offset);
+    vec.size = e.size;
+    return vec;
+}
+
+// Метод для проверки CRC32C вектора
+template <typename T>
+bool BasicContainerInput<T>::verify(uint64_t k) const
+{
+    ContainerIndexEntry e = this->entry(k);
+    return crc32c(this->base + e.offset, static_cast<size_t>(e.size) * sizeof(T)) == e.crc;
+}
+
+// Метод для чтения диапазона векторов в порцию
+template <typename T>
+size_t BasicContainerInput<T>::read(
+    uint64_t first,
+    size_t max_vectors,
+    size_t memory_limit,
+    BasicVectorBatch<T> &chunk) const
+{
+    chunk.clear();
+    size_t chunk_bytes = 0;
+
+    for (uint64_t k = first; k < this->num_vectors && chunk.size() < max_vectors; ++k)
+    {
+        ContainerIndexEntry e = this->entry(k);
+        size_t vector_bytes = static_cast<size_t>(e.size) * sizeof(T);
+        if (!chunk.empty() && chunk_bytes + vector_bytes > memory_limit)
+            break;
+
+        // Контрольная сумма проверяется до копирования в порцию
+        const char *values = this->base + e.offset;
+        if (crc32c(values, vector_bytes) != e.crc)
+        {
+            throw DataDecodeError(
+                "Checksum mismatch in vector " + std::to_string(k),
+                "ContainerInput.read()");
+        }
+        std::memcpy(chunk.append(e.size), values, vector_bytes);
+        chunk_bytes += vector_bytes;
+    }
+
+    return chunk.size();
+}
+
+// Явное инстанцирование для поддерживаемых типов данных
+#define INSTANTIATE_CONTAINER(T)            \
+    template class BasicContainerWriter<T>; \
+    template class BasicContainerInput<T>;
+FOR_EACH_DATA_TYPE(INSTANTIATE_CONTAINER)
@@ -0,0 +1,208 @@
+#ifndef CONTAINER_H
+#define CONTAINER_H
+
+#include <cstdint>
+#include <cstddef>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "batch.h"
+#include "errors.h"
+#include "types.h"
+
+/**
+* @file container.h
+* @brief Определения классов для индексированного бинарного формата (v2).
+* @details Файл v2 состоит из заголовка, значений векторов и индекса смещений:
+* - заголовок (64 байта): сигнатура "VEC2", версия, тип и размер значений,
+*   64-битное количество векторов, смещения значений и индекса, CRC32C индекса
+*   и CRC32C самого заголовка;
+* - значения векторов, каждый вектор начинается с границы 8 байтов;
+* - индекс: для каждого вектора смещение, количество значений и CRC32C значений.
+* Индекс позволяет найти вектор k без чтения предыдущих, поэтому несколько потоков
+* могут разбирать и отправлять непересекающиеся диапазоны, а задание - продолжаться
+* с любого вектора. Все поля записываются в порядке байтов little-endian.
+* @date 17.10.2026
+* @version 1.0
+* @authors Косов Р. С.
+* @copyright ИБСТ ПГУ
+*/
+
+/// Сигнатура файла v2.
+static const char CONTAINER_MAGIC[4] = {'V', 'E', 'C', '2'};
+
+/// Версия формата.
+static const uint16_t CONTAINER_VERSION = 2;
+
+/// Выравнивание значений векторов и индекса в файле.
+static const size_t CONTAINER_ALIGN = 8;
+
+/**
+* @brief Заголовок файла v2.
+*/
+struct ContainerHeader
+{
+    char magic[4]; ///< Сигнатура "VEC2".
+    uint16_t version; ///< Версия формата.
+    uint16_t value_type; ///< Тип значений (DataType).
+    uint32_t value_size; ///< Размер одного значения в байтах.
+    uint32_t header_size; ///< Размер заголовка в байтах.
+    uint64_t count; ///< Количество векторов.
+    uint64_t data_offset; ///< Смещение значений векторов.
+    uint64_t index_offset; ///< Смещение индекса.
+    uint32_t index_crc; ///< CRC32C индекса.
+    uint32_t flags; ///< Флаги (зарезервировано, 0).
+    uint8_t reserved[12]; ///< Зарезервировано (нули).
+    uint32_t header_crc; ///< CRC32C предыдущих полей заголовка.
+};
+
+/**
+* @brief Запись индекса файла v2.
+*/
+struct ContainerIndexEntry
+{
+    uint64_t offset; ///< Смещение значений вектора от начала файла.
+    uint32_t size; ///< Количество значений.
+    uint32_t crc; ///< CRC32C значений.
+};
+
+/**
+* @brief Функция для проверки, записан ли файл в формате v2.
+* @param path Путь к файлу.
+* @return true, если файл начинается с сигнатуры v2.
+*/
+bool isContainerFile(const std::string &path);
+
+/**
+* @brief Класс для записи файла v2.
+* @details Значения записываются по мере добавления векторов, индекс накапливается
+* в памяти и записывается при закрытии вместе с окончательным заголовком.
+* @tparam T Тип значений векторов.
+*/
+template <typename T>
+class BasicContainerWriter
+{
+public:
+    /**
+    * @brief Конструктор класса BasicContainerWriter.
+    * @param path Путь к выходному файлу.
+    * @throw IOError Если не удалось открыть файл для записи.
+    */
+    explicit BasicContainerWriter(const std::string &path);
+
+    /**
+    * @brief Метод для добавления вектора.
+    * @param values Значения вектора.
+    * @param size Количество значений.
+    * @throw IOError Если запись не удалась.
+    */
+    void append(const T *values, uint32_t size);
+
+    /**
+    * @brief Метод для завершения записи (индекс и заголовок).
+    * @throw IOError Если запись не удалась.
+    */
+    void close();
+
+private:
+    std::ofstream output_file; ///< Выходной файл.
+    std::string path; ///< Путь к выходному файлу.
+    uint64_t offset; ///< Смещение следующего вектора.
+    std::vector<ContainerIndexEntry> index; ///< Индекс записанных векторов.
+
+    /**
+    * @brief Метод для дополнения файла нулями до границы выравнивания.
+    */
+    void pad();
+};
+
+/**
+* @brief Класс для чтения файла v2 с произвольным доступом.
+* @details Файл отображается в память. Константные методы можно вызывать
+* из нескольких потоков одновременно.
+* @tparam T Тип значений векторов.
+*/
+template <typename T>
+class BasicContainerInput
+{
+public:
+    /**
+    * @brief Конструктор класса BasicContainerInput.
+    * @param path Путь к файлу.
+    * @throw IOError Если не удалось открыть или отобразить файл.
+    * @throw DataDecodeError Если заголовок или индекс повреждены или тип значений не совпадает с T.
+    */
+    explicit BasicContainerInput(const std::string &path);
+
+    /**
+    * @brief Конструктор перемещения.
+    * @param other Перемещаемый объект.
+    */
+    BasicContainerInput(BasicContainerInput &&other);
+
+    BasicContainerInput(const BasicContainerInput &) = delete;
+    BasicContainerInput &operator=(const BasicContainerInput &) = delete;
+
+    /**
+    * @brief Деструктор класса BasicContainerInput.
+    */
+    ~BasicContainerInput();
+
+    /**
+    * @brief Метод для получения количества векторов.
+    * @return Количество векторов.
+    */
+    uint64_t count() const;
+
+    /**
+    * @brief Метод для получения вектора без копирования и проверки CRC32C.
+    * @param k Номер вектора.
+    * @return Представление вектора в отображённом файле.
+    * @throw DataDecodeError Если номер или запись индекса выходят за границы файла.
+    */
+    BasicVectorView<T> view(uint64_t k) const;
+
+    /**
+    * @brief Метод для проверки CRC32C вектора.
+    * @param k Номер вектора.
+    * @return true, если контрольная сумма совпадает.
+    * @throw DataDecodeError Если номер или запись индекса выходят за границы файла.
+    */
+    bool verify(uint64_t k) const;
+
+    /**
+    * @brief Метод для чтения диапазона векторов в порцию с проверкой CRC32C.
+    * @param first Номер первого вектора.
+    * @param max_vectors Максимальное количество векторов в порции.
+    * @param memory_limit Ограничение объёма значений в порции (в байтах).
+    * @param chunk Порция векторов (очищается перед заполнением).
+    * @return Количество прочитанных векторов (0, если first не меньше count()).
+    * @throw DataDecodeError Если контрольная сумма вектора не совпадает.
+    */
+    size_t read(uint64_t first, size_t max_vectors, size_t memory_limit, BasicVectorBatch<T> &chunk) const;
+
+private:
+    int fd; ///< Дескриптор файла.
+    const char *base; ///< Начало отображения.
+    size_t length; ///< Длина файла в байтах.
+    uint64_t num_vectors; ///< Количество векторов.
+    const ContainerIndexEntry *index; ///< Индекс в отображённом файле.
+    uint64_t data_offset; ///< Смещение значений векторов.
+    uint64_t data_end; ///< Конец значений векторов (начало индекса).
+
+    /**
+    * @brief Метод для получения проверенной записи индекса.
+    * @param k Номер вектора.
+    * @return Запись индекса.
+    * @throw DataDecodeError Если номер или запись выходят за границы файла.
+    */
+    ContainerIndexEntry entry(uint64_t k) const;
+};
+
+/// Запись файла v2 из значений uint32_t.
+typedef BasicContainerWriter<uint32_t> ContainerWriter;
+
+/// Чтение файла v2 из значений uint32_t.
+typedef BasicContainerInput<uint32_t> ContainerInput;
+
+#endif // CONTAINER_H
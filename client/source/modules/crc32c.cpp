@@ -0,0 +1,93 @@
+#include "crc32c.h"
+#include <cstring>
+#if defined(__x86_64__)
+#include <nmmintrin.h>
+#endif
+
+// Отражённый полином Кастаньоли
+static const uint32_t CRC32C_POLY = 0x82F63B78;
+
+// Таблицы для обработки 8 байтов за шаг
+struct Crc32cTables
+{
+    uint32_t table[8][256];
+
+    Crc32cTables()
+    {
+        for (uint32_t i = 0; i < 256; ++i)
+        {
+            uint32_t crc = i;
+            for (int bit = 0; bit < 8; ++bit)
+                crc = (crc >> 1) ^ (CRC32C_POLY & (0u - (crc & 1)));
+            this->table[0][i] = crc;
+        }
+        for (uint32_t i = 0; i < 256; ++i)
+            for (int k = 1; k < 8; ++k)
+                this->table[k][i] = (this->table[k - 1][i] >> 8) ^ this->table[0][this->table[k - 1][i] & 0xFF];
+    }
+};
+
+static const Crc32cTables &tables()
+{
+    static const Crc32cTables instance;
+    return instance;
+}
+
+// Функция для вычисления CRC32C табличным алгоритмом
+uint32_t crc32cSoftware(const void *data, size_t length, uint32_t crc)
+{
+    const uint32_t(*t)[256] = tables().table;
+    const unsigned char *p = static_cast<const unsigned char *>(data);
+    crc = ~crc;
+
+    while (length >= 8)
+    {
+        uint32_t low, high;
+        std::memcpy(&low, p, sizeof(low));
+        std::memcpy(&high, p + 4, sizeof(high));
+        low ^= crc;
+        crc = t[7][low & 0xFF] ^ t[6][(low >> 8) & 0xFF] ^ t[5][(low >> 16) & 0xFF] ^ t[4][low >> 24] ^
+              t[3][high & 0xFF] ^ t[2][(high >> 8) & 0xFF] ^ t[1][(high >> 16) & 0xFF] ^ t[0][high >> 24];
+        p += 8;
+        length -= 8;
+    }
+    while (length-- > 0)
+        crc = (crc >> 8) ^ t[0][(crc ^ *p++) & 0xFF];
+
+    return ~crc;
+}
+
+#if defined(__x86_64__)
+// Функция для вычисления CRC32C инструкцией crc32 (SSE4.2)
+__attribute__((target("sse4.2"))) static uint32_t crc32cHardware(const void *data, size_t length, uint32_t crc)
+{
+    const unsigned char *p = static_cast<const unsigned char *>(data);
+    uint64_t crc64 = ~crc;
+
+    while (length >= 8)
+    {
+        uint64_t word;
+        std::memcpy(&word, p, sizeof(word));
+        crc64 = _mm_crc32_u64(crc64, word);
+        p += 8;
+        length -= 8;
+    }
+    uint32_t crc32 = static_cast<uint32_t>(crc64);
+    while (length-- > 0)
+        crc32 = _mm_crc32_u8(crc32, *p++);
+
+    return ~crc32;
+}
+#endif
+
+// Функция для вычисления CRC32C
+uint32_t crc32c(const void *data, size_t length, uint32_t crc)
+{
+#if defined(__x86_64__)
+    // Поддержка SSE4.2 проверяется один раз
+    static const bool hardware = __builtin_cpu_supports("sse4.2");
+    if (hardware)
+        return crc32cHardware(data, length, crc);
+#endif
+    return crc32cSoftware(data, length, crc);
+}
@@ -0,0 +1,36 @@
+#ifndef CRC32C_H
+#define CRC32C_H
+
+#include <cstdint>
+#include <cstddef>
+
+/**
+* @file crc32c.h
+* @brief Определения функций вычисления контрольной суммы CRC32C.
+* @details CRC32C (полином Кастаньоли) вычисляется инструкцией crc32 из SSE4.2,
+* если процессор её поддерживает, иначе - табличным алгоритмом.
+* @date 17.10.2026
+* @version 1.0
+* @authors Косов Р. С.
+* @copyright ИБСТ ПГУ
+*/
+
+/**
+* @brief Функция для вычисления CRC32C.
+* @param data Данные.
+* @param length Количество байтов.
+* @param crc Контрольная сумма предыдущих данных (для вычисления по частям).
+* @return Контрольная сумма.
+*/
+uint32_t crc32c(const void *data, size_t length, uint32_t crc = 0);
+
+/**
+* @brief Функция для вычисления CRC32C табличным алгоритмом (без SSE4.2).
+* @param data Данные.
+* @param length Количество байтов.
+* @param crc Контрольная сумма предыдущих данных (для вычисления по частям).
+* @return Контрольная сумма.
+*/
+uint32_t crc32cSoftware(const void *data, size_t length, uint32_t crc = 0);
+
+#endif // CRC32C_H
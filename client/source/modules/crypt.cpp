@@ -1,54 +1,83 @@
 #include "crypt.h"
-#include <cryptopp/hex.h>
 #include <cryptopp/sha.h>
 #include <cryptopp/osrng.h>
-#include <sstream>
-#include <iomanip>
+#include <vector>
 
-// Реализация статического метода для генерации соли
-std::string CryptManager::get_salt()
+// Размер соли в байтах
+// 64 бита = 8 байт
+static const size_t SALT_SIZE = 8;
+
+// Генератор случайных чисел потока (инициализируется из ОС один раз)
+static CryptoPP::AutoSeededRandomPool &thread_prng()
+{
+    thread_local CryptoPP::AutoSeededRandomPool prng;
+    return prng;
+}
+
+// Контекст хеш-функции потока
+static CryptoPP::SHA1 &thread_sha1()
+{
+    thread_local CryptoPP::SHA1 hash_func;
+    return hash_func;
+}
+
+// Реализация статического метода для шестнадцатеричного кодирования
+void CryptManager::hex_encode(const unsigned char *in, size_t length, char *out)
 {
-    // Размер соли в байтах
-    // 64 бита = 8 байт
-    const size_t SALT_SIZE = 8;
-    CryptoPP::byte salt[SALT_SIZE]; // массив для соли
-    CryptoPP::AutoSeededRandomPool prng;
-    prng.GenerateBlock(salt, SALT_SIZE); // генерация соли
-    std::string salt_hex;                // строка для соли
-    CryptoPP::ArraySource(
-        salt,
-        SALT_SIZE,
-        true,
-        new CryptoPP::HexEncoder(
-            new CryptoPP::StringSink(salt_hex),
-            true // Заглавные буквы
-            ));
-
-    // Дополнение соли нулями слева до 16 символов
-    while (salt_hex.size() < 16)
+    static const char digits[] = "0123456789ABCDEF";
+    for (size_t i = 0; i < length; ++i)
     {
-        salt_hex = "0" + salt_hex;
+        out[2 * i] = digits[in[i] >> 4];
+        out[2 * i + 1] = digits[in[i] & 0x0F];
     }
+}
 
+// Реализация статического метода для генерации соли в буфер
+void CryptManager::get_salt(char *out)
+{
+    CryptoPP::byte salt[SALT_SIZE];
+    thread_prng().GenerateBlock(salt, SALT_SIZE);
+    hex_encode(salt, SALT_SIZE, out);
+}
+
+// Реализация статического метода для вычисления хеша в буфер
+void CryptManager::get_hash(const char *salt, size_t salt_length, const char *data, size_t data_length, char *out)
+{
+    // Соль и данные подаются в хеш по частям, без конкатенации
+    CryptoPP::SHA1 &hash_func = thread_sha1();
+    CryptoPP::byte digest[CryptoPP::SHA1::DIGESTSIZE];
+    hash_func.Update(reinterpret_cast<const CryptoPP::byte *>(salt), salt_length);
+    hash_func.Update(reinterpret_cast<const CryptoPP::byte *>(data), data_length);
+    hash_func.Final(digest);
+    hex_encode(digest, sizeof(digest), out);
+}
+
+// Реализация статического метода для генерации нескольких пар соль - хеш
+void CryptManager::get_batch(const std::string &data, SaltHash *out, size_t count)
+{
+    std::vector<CryptoPP::byte> salts(count * SALT_SIZE);
+    if (count > 0)
+        thread_prng().GenerateBlock(salts.data(), salts.size());
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        hex_encode(&salts[i * SALT_SIZE], SALT_SIZE, out[i].salt);
+        get_hash(out[i].salt, SALT_HEX_LENGTH, data.data(), data.size(), out[i].hash);
+    }
+}
+
+// Реализация статического метода для генерации соли
+std::string CryptManager::get_salt()
+{
+    std::string salt_hex(SALT_HEX_LENGTH, '0');
+    get_salt(&salt_hex[0]);
     return salt_hex;
 }
 
 // Реализация статического метода для вычисления хеша
 std::string CryptManager::get_hash(const std::string &salt, const std::string &data)
 {
-    CryptoPP::SHA1 hash_func; // создаем объект хеш-функции
-    std::string hash_hex;
-
-    // формирование хэша и преобразование в шестнадцатеричную строку
-    CryptoPP::StringSource(
-        salt + data,
-        true,
-        new CryptoPP::HashFilter(
-            hash_func,
-            new CryptoPP::HexEncoder(
-                new CryptoPP::StringSink(hash_hex),
-                true // Заглавные буквы
-                )));
-
+    std::string hash_hex(HASH_HEX_LENGTH, '0');
+    get_hash(salt.data(), salt.size(), data.data(), data.size(), &hash_hex[0]);
     return hash_hex;
 }
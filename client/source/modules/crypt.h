@@ -1,9 +1,10 @@
 #ifndef CRYPT_MANAGER_H
 #define CRYPT_MANAGER_H
 
+#include <cstddef>
 #include <string>
 
-/** 
+/**
 * @file crypt.h
 * @brief Определения классов для криптографических операций.
 * @details Этот файл содержит определения классов для генерации соли и вычисления хеша данных.
@@ -13,8 +14,26 @@
 * @copyright ИБСТ ПГУ
 */
 
-/** 
+/// Длина соли в шестнадцатеричном виде (64 бита).
+static const size_t SALT_HEX_LENGTH = 16;
+
+/// Длина хеша SHA1 в шестнадцатеричном виде (160 бит).
+static const size_t HASH_HEX_LENGTH = 40;
+
+/**
+* @brief Пара соль - хеш для одного сообщения аутентификации.
+* @details Строки не завершаются нулём.
+*/
+struct SaltHash
+{
+    char salt[SALT_HEX_LENGTH]; ///< Соль в шестнадцатеричном виде.
+    char hash[HASH_HEX_LENGTH]; ///< Хеш соли и пароля в шестнадцатеричном виде.
+};
+
+/**
 * @brief Класс для выполнения криптографических операций.
+* @details Генератор случайных чисел и контекст SHA1 создаются один раз
+* на поток и переиспользуются между вызовами.
 */
 class CryptManager
 {
@@ -32,6 +51,39 @@ public:
     * @return Вычисленный хеш.
     */
     static std::string get_hash(const std::string &salt, const std::string &data);
+
+    /**
+    * @brief Статический метод для генерации соли в буфер вызывающего.
+    * @param out Буфер для SALT_HEX_LENGTH символов.
+    */
+    static void get_salt(char *out);
+
+    /**
+    * @brief Статический метод для вычисления хеша в буфер вызывающего.
+    * @param salt Соль.
+    * @param salt_length Длина соли.
+    * @param data Данные, которые нужно захешировать.
+    * @param data_length Длина данных.
+    * @param out Буфер для HASH_HEX_LENGTH символов.
+    */
+    static void get_hash(const char *salt, size_t salt_length, const char *data, size_t data_length, char *out);
+
+    /**
+    * @brief Статический метод для генерации нескольких пар соль - хеш.
+    * @details Случайные байты всех солей генерируются одним вызовом генератора.
+    * @param data Данные, которые нужно захешировать (пароль).
+    * @param out Массив пар.
+    * @param count Количество пар.
+    */
+    static void get_batch(const std::string &data, SaltHash *out, size_t count);
+
+    /**
+    * @brief Статический метод для шестнадцатеричного кодирования (заглавные буквы).
+    * @param in Кодируемые байты.
+    * @param length Количество байтов.
+    * @param out Буфер для 2 * length символов.
+    */
+    static void hex_encode(const unsigned char *in, size_t length, char *out);
 };
 
 #endif // CRYPT_MANAGER_H
@@ -0,0 +1,352 @@
+#include "daemon.h"
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include "log.h"
+#include "trace.h"
+#include <list>
+#include <sstream>
+#include <thread>
+#include <utility>
+#include <vector>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+// Период проверки флага работы в циклах ожидания (мс)
+static const int POLL_INTERVAL_MS = 200;
+
+// Пауза перед повторной попыткой открыть сессию после ошибки
+static const std::chrono::milliseconds RETRY_DELAY(1000);
+
+template <typename T>
+std::atomic<bool> BasicSessionDaemon<T>::running(false);
+
+// Конструктор
+template <typename T>
+BasicSessionDaemon<T>::BasicSessionDaemon(
+    const std::string &config_path,
+    const std::string &address,
+    uint16_t port,
+    const std::array<std::string, 2> &credentials,
+    const std::string &socket_path,
+    size_t sessions,
+    size_t memory_limit,
+    FileBackend backend,
+    size_t queue_depth,
+    ResultCache *cache,
+    bool dedup)
+    : config_path(config_path),
+      address(address),
+      port(port),
+      credentials(credentials),
+      socket_path(socket_path),
+      sessions(sessions > 0 ? sessions : 1),
+      memory_limit(memory_limit),
+      backend(backend),
+      queue_depth(queue_depth),
+      cache(cache),
+      dedup(dedup),
+      failures(0),
+      opening(0) {}
+
+// Метод для остановки демона
+template <typename T>
+void BasicSessionDaemon<T>::stop()
+{
+    running = false;
+}
+
+// Метод для получения готовой сессии из пула
+template <typename T>
+std::unique_ptr<NetworkManager> BasicSessionDaemon<T>::acquire()
+{
+    std::unique_lock<std::mutex> lock(this->mutex);
+    // Ошибка пополнения завершает ожидание, только если других открываемых сессий не осталось
+    uint64_t failures_before = this->failures;
+    this->changed.wait(lock, [&]
+                       { return !this->idle.empty() || !running ||
+                                (this->failures != failures_before && this->opening == 0); });
+    if (this->idle.empty())
+        throw NetworkError("No server session available", "SessionDaemon.acquire()");
+
+    std::unique_ptr<NetworkManager> session = std::move(this->idle.front());
+    this->idle.pop_front();
+
+    // Фоновый поток открывает замену забранной сессии
+    this->changed.notify_all();
+    return session;
+}
+
+// Метод фонового потока пополнения пула сессий
+template <typename T>
+void BasicSessionDaemon<T>::refill()
+{
+    if (Tracer::enabled())
+        Tracer::instance().nameThread("refill");
+    while (running)
+    {
+        size_t missing;
+        {
+            std::unique_lock<std::mutex> lock(this->mutex);
+            this->changed.wait_for(lock, std::chrono::milliseconds(POLL_INTERVAL_MS), [&]
+                                   { return this->idle.size() < this->sessions || !running; });
+            if (!running)
+                break;
+            missing = this->sessions - std::min(this->idle.size(), this->sessions);
+            this->opening = missing;
+        }
+        if (missing == 0)
+            continue;
+
+        // Соли и хеши недостающих сессий вычисляются одним пакетом
+        std::vector<SaltHash> tokens(missing);
+        {
+            TraceSpan span("hash_batch", "crypto");
+            CryptManager::get_batch(this->credentials[1], tokens.data(), tokens.size());
+        }
+
+        bool failed = false;
+        for (size_t i = 0; i < missing && running; ++i)
+        {
+            std::unique_ptr<NetworkManager> session(new NetworkManager(this->address, this->port));
+            session->setCache(this->cache);
+            session->setDedup(this->dedup);
+            try
+            {
+                session->conn();
+                session->auth(this->credentials[0], tokens[i]);
+            }
+            catch (const BasicClientError &e)
+            {
+                session->close();
+                LOG_ERROR("SessionDaemon.refill()", "Error: " << e.what());
+                failed = true;
+                std::lock_guard<std::mutex> lock(this->mutex);
+                ++this->failures;
+                --this->opening;
+                this->changed.notify_all();
+                continue;
+            }
+
+            std::lock_guard<std::mutex> lock(this->mutex);
+            this->idle.push_back(std::move(session));
+            --this->opening;
+            this->changed.notify_all();
+        }
+
+        std::unique_lock<std::mutex> lock(this->mutex);
+        this->opening = 0;
+        this->changed.notify_all();
+
+        // Повторная попытка после паузы (прерывается остановкой демона)
+        if (failed)
+            this->changed.wait_for(lock, RETRY_DELAY, []
+                                   { return !running; });
+    }
+}
+
+// Метод для обработки одного задания
+template <typename T>
+uint32_t BasicSessionDaemon<T>::process(const std::string &input_path, const std::string &output_path)
+{
+    IOManager io_man(this->config_path, input_path, output_path);
+    io_man.setBackend(this->backend, this->queue_depth);
+
+    for (int attempt = 0;; ++attempt)
+    {
+        // Файлы открываются до получения сессии, чтобы ошибка в них не тратила сессию
+        BasicVectorReader<T> reader = io_man.reader<T>(this->memory_limit);
+        BasicResultWriter<T> writer = io_man.writer<T>(reader.count());
+
+        std::unique_ptr<NetworkManager> session = this->acquire();
+        bool received = false;
+        try
+        {
+            session->begin(reader.count());
+            BasicVectorBatch<T> chunk;
+            while (reader.next(chunk))
+            {
+                writer.append(session->exchange(chunk));
+                received = true;
+            }
+        }
+        catch (const NetworkError &e)
+        {
+            session->close();
+
+            // Сервер мог закрыть сессию, пока она ждала в пуле - одна попытка с другой
+            if (!received && attempt == 0)
+            {
+                LOG_WARN("SessionDaemon.process()", "Retrying on another session: " << e.what());
+                continue;
+            }
+            throw;
+        }
+        catch (...)
+        {
+            session->close();
+            throw;
+        }
+        session->close();
+        writer.close();
+
+        return reader.count();
+    }
+}
+
+// Метод для обслуживания одного подключения к Unix-сокету
+template <typename T>
+void BasicSessionDaemon<T>::serve(int fd)
+{
+    std::string pending;
+    char buffer[4096];
+
+    while (running)
+    {
+        struct pollfd pfd;
+        pfd.fd = fd;
+        pfd.events = POLLIN;
+        pfd.revents = 0;
+        int ready = poll(&pfd, 1, POLL_INTERVAL_MS);
+        if (ready < 0 && errno != EINTR)
+            break;
+        if (ready <= 0)
+            continue;
+
+        ssize_t got = ::recv(fd, buffer, sizeof(buffer), 0);
+        if (got <= 0)
+            break;
+        pending.append(buffer, got);
+
+        // Каждая полная строка - отдельное задание
+        size_t end;
+        while ((end = pending.find('\n')) != std::string::npos)
+        {
+            std::istringstream line(pending.substr(0, end));
+            pending.erase(0, end + 1);
+
+            std::string input_path, output_path, response;
+            if (!(line >> input_path >> output_path))
+                response = "ERR Expected \"INPUT OUTPUT\"\n";
+            else
+            {
+                std::chrono::steady_clock::time_point started = std::chrono::steady_clock::now();
+                try
+                {
+                    TraceSpan span("job", "ui");
+                    uint32_t count = this->process(input_path, output_path);
+                    response = "OK " + std::to_string(count) + "\n";
+
+                    auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+                        std::chrono::steady_clock::now() - started);
+                    LOG_INFO("SessionDaemon.serve()", "Job: " << input_path << " -> " << output_path
+                                                              << " results=" << count
+                                                              << " time=" << elapsed.count() << "us");
+                }
+                catch (const std::exception &e)
+                {
+                    std::string message = e.what();
+                    for (auto &c : message)
+                        if (c == '\n')
+                            c = ' ';
+                    response = "ERR " + message + "\n";
+                }
+            }
+            if (::send(fd, response.data(), response.size(), MSG_NOSIGNAL) < 0)
+            {
+                ::close(fd);
+                return;
+            }
+        }
+    }
+    ::close(fd);
+}
+
+// Метод для запуска демона
+template <typename T>
+void BasicSessionDaemon<T>::run()
+{
+    struct sockaddr_un addr;
+    std::memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    if (this->socket_path.size() >= sizeof(addr.sun_path))
+        throw NetworkError("Socket path is too long", "SessionDaemon.run()");
+    std::strcpy(addr.sun_path, this->socket_path.c_str());
+
+    int listen_fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listen_fd < 0)
+        throw NetworkError("Failed to create socket", "SessionDaemon.run()");
+
+    ::unlink(this->socket_path.c_str());
+    if (bind(listen_fd, (struct sockaddr *)&addr, sizeof(addr)) < 0 || listen(listen_fd, SOMAXCONN) < 0)
+    {
+        ::close(listen_fd);
+        throw NetworkError("Failed to listen on \"" + this->socket_path + "\"", "SessionDaemon.run()");
+    }
+
+    running = true;
+    std::thread refill_thread(&BasicSessionDaemon<T>::refill, this);
+
+    LOG_INFO("SessionDaemon.run()", "Listening: " << this->socket_path << " sessions=" << this->sessions);
+
+    // Приём подключений, каждое обслуживается своим потоком
+    typedef std::pair<std::thread, std::shared_ptr<std::atomic<bool>>> Client;
+    std::list<Client> clients;
+    while (running)
+    {
+        // Присоединение потоков завершившихся подключений
+        for (auto it = clients.begin(); it != clients.end();)
+        {
+            if (*it->second)
+            {
+                it->first.join();
+                it = clients.erase(it);
+            }
+            else
+                ++it;
+        }
+
+        struct pollfd pfd;
+        pfd.fd = listen_fd;
+        pfd.events = POLLIN;
+        pfd.revents = 0;
+        if (poll(&pfd, 1, POLL_INTERVAL_MS) <= 0)
+            continue;
+
+        int fd = accept(listen_fd, nullptr, nullptr);
+        if (fd < 0)
+            continue;
+
+        std::shared_ptr<std::atomic<bool>> done(new std::atomic<bool>(false));
+        clients.emplace_back(std::thread([this, fd, done]
+                                         {
+            if (Tracer::enabled())
+                Tracer::instance().nameThread("client " + std::to_string(fd));
+            this->serve(fd);
+            *done = true; }),
+                             done);
+    }
+
+    // Завершение: пробуждение ожидающих потоков и закрытие сессий
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->changed.notify_all();
+    }
+    for (auto &client : clients)
+        client.first.join();
+    refill_thread.join();
+
+    for (auto &session : this->idle)
+        session->close();
+    this->idle.clear();
+
+    ::close(listen_fd);
+    ::unlink(this->socket_path.c_str());
+}
+
+// Явное инстанцирование для поддерживаемых типов данных
+#define INSTANTIATE_DAEMON(T) template class BasicSessionDaemon<T>;
+FOR_EACH_DATA_TYPE(INSTANTIATE_DAEMON)
@@ -0,0 +1,136 @@
+#ifndef SESSION_DAEMON_H
+#define SESSION_DAEMON_H
+
+#include <cstdint>
+#include <cstddef>
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include "io.h"
+#include "network.h"
+
+/**
+* @file daemon.h
+* @brief Определения классов для режима демона с заранее открытыми сессиями.
+* @details Этот файл содержит определение демона, который держит пул подключённых
+* и аутентифицированных сессий с сервером и принимает задания через локальный
+* Unix-сокет. Задание - строка "ВХОДНОЙ_ФАЙЛ ВЫХОДНОЙ_ФАЙЛ", ответ - строка
+* "OK КОЛИЧЕСТВО_РЕЗУЛЬТАТОВ" или "ERR СООБЩЕНИЕ".
+* @date 17.10.2026
+* @version 1.0
+* @authors Косов Р. С.
+* @copyright ИБСТ ПГУ
+*/
+
+/**
+* @brief Класс демона обработки заданий через заранее открытые сессии.
+* @details Каждое задание забирает из пула готовую сессию и закрывает её после
+* обработки, фоновый поток сразу открывает и аутентифицирует замену. Поэтому
+* задание не ждёт подключения и аутентификации, пока пул успевает пополняться.
+* Если сервер закрыл сессию, пока она ждала в пуле, задание повторяется один
+* раз на другой сессии.
+* @tparam T Тип значений векторов.
+*/
+template <typename T>
+class BasicSessionDaemon
+{
+public:
+    /**
+    * @brief Конструктор класса BasicSessionDaemon.
+    * @param config_path Путь к файлу конфигурации.
+    * @param address Адрес сервера.
+    * @param port Порт сервера.
+    * @param credentials Логин и пароль.
+    * @param socket_path Путь к Unix-сокету для приёма заданий.
+    * @param sessions Количество заранее открытых сессий.
+    * @param memory_limit Ограничение объёма одной порции векторов (в байтах).
+    * @param backend Способ чтения и записи файлов заданий.
+    * @param queue_depth Количество блоков в обработке для FileBackend::URING.
+    * @param cache Кеш результатов, общий для всех сессий (nullptr - без кеша).
+    * @param dedup Устранять ли повторы внутри порций.
+    */
+    BasicSessionDaemon(
+        const std::string &config_path,
+        const std::string &address,
+        uint16_t port,
+        const std::array<std::string, 2> &credentials,
+        const std::string &socket_path,
+        size_t sessions,
+        size_t memory_limit,
+        FileBackend backend = FileBackend::STREAM,
+        size_t queue_depth = 4,
+        ResultCache *cache = nullptr,
+        bool dedup = false);
+
+    /**
+    * @brief Метод для запуска демона (блокируется до вызова stop()).
+    * @throw NetworkError Если не удалось открыть Unix-сокет.
+    */
+    void run();
+
+    /**
+    * @brief Метод для обработки одного задания на готовой сессии.
+    * @param input_path Путь к входному файлу.
+    * @param output_path Путь к выходному файлу.
+    * @return Количество записанных результатов.
+    * @throw IOError Если произошла ошибка ввода-вывода.
+    * @throw DataDecodeError Если входной файл повреждён.
+    * @throw NetworkError Если нет доступной сессии или произошла сетевая ошибка.
+    */
+    uint32_t process(const std::string &input_path, const std::string &output_path);
+
+    /**
+    * @brief Метод для остановки демона (безопасен для вызова из обработчика сигнала).
+    */
+    static void stop();
+
+private:
+    std::string config_path; ///< Путь к файлу конфигурации.
+    std::string address; ///< Адрес сервера.
+    uint16_t port; ///< Порт сервера.
+    std::array<std::string, 2> credentials; ///< Логин и пароль.
+    std::string socket_path; ///< Путь к Unix-сокету.
+    size_t sessions; ///< Количество заранее открытых сессий.
+    size_t memory_limit; ///< Ограничение объёма порции.
+    FileBackend backend; ///< Способ чтения и записи файлов заданий.
+    size_t queue_depth; ///< Количество блоков в обработке для FileBackend::URING.
+    ResultCache *cache; ///< Кеш результатов (nullptr - без кеша).
+    bool dedup; ///< Флаг устранения повторов внутри порций.
+
+    std::mutex mutex; ///< Мьютекс пула сессий.
+    std::condition_variable changed; ///< Условие изменения пула.
+    std::deque<std::unique_ptr<NetworkManager>> idle; ///< Готовые сессии.
+    uint64_t failures; ///< Количество неудачных попыток открыть сессию.
+    size_t opening; ///< Количество сессий текущего пополнения, которые ещё открываются.
+
+    static std::atomic<bool> running; ///< Флаг работы демона.
+
+    /**
+    * @brief Метод для получения готовой сессии из пула.
+    * @details Ожидает, пока в пуле не появится сессия или пополнение не
+    * завершится без единой открытой сессии.
+    * @return Подключённая и аутентифицированная сессия.
+    * @throw NetworkError Если открыть сессию не удаётся.
+    */
+    std::unique_ptr<NetworkManager> acquire();
+
+    /**
+    * @brief Метод фонового потока пополнения пула сессий.
+    */
+    void refill();
+
+    /**
+    * @brief Метод для обслуживания одного подключения к Unix-сокету.
+    * @param fd Дескриптор подключения.
+    */
+    void serve(int fd);
+};
+
+/// Демон для векторов из значений uint32_t.
+typedef BasicSessionDaemon<uint32_t> SessionDaemon;
+
+#endif // SESSION_DAEMON_H
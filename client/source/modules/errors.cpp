@@ -5,7 +5,7 @@ BasicClientError::BasicClientError(
     const std::string &name,
     const std::string &message,
     const std::string &func)
-    : name(name), message(message), func(func) {}
+    : name(name), func(func), message(message) {}
 
 const char *BasicClientError::what() const noexcept
 {
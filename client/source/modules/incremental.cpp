@@ -0,0 +1,393 @@
+#include "incremental.h"
+#include "crc32c.h"
+#include "log.h"
+#include "metrics.h"
+#include "trace.h"
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Сигнатура файла отпечатков
+static const char FINGERPRINT_MAGIC[8] = {'V', 'C', 'I', 'N', 'C', 'R', '0', '1'};
+
+// Функция для получения времени изменения файла в наносекундах
+static int64_t mtimeNanos(const struct stat &st)
+{
+    return static_cast<int64_t>(st.st_mtim.tv_sec) * 1000000000 + st.st_mtim.tv_nsec;
+}
+
+// Конструктор
+FingerprintFile::FingerprintFile(const std::string &path)
+    : path(path),
+      base(nullptr),
+      length(0),
+      entries(nullptr),
+      num_entries(0),
+      output_matches(false),
+      header() {}
+
+// Деструктор
+FingerprintFile::~FingerprintFile()
+{
+    if (this->base != nullptr)
+        munmap(this->base, this->length);
+
+    // Незавершённый файл не должен заменить отпечатки прошлого запуска
+    if (this->output.is_open())
+    {
+        this->output.close();
+        std::remove((this->path + ".tmp").c_str());
+    }
+}
+
+std::string FingerprintFile::pathFor(const std::string &output_path)
+{
+    return output_path + ".vcinc";
+}
+
+// Метод для загрузки отпечатков прошлого запуска
+bool FingerprintFile::load(DataType type, const std::string &output_path)
+{
+    int fd = ::open(this->path.c_str(), O_RDONLY);
+    if (fd < 0)
+        return false;
+
+    struct stat st;
+    if (fstat(fd, &st) < 0 || static_cast<size_t>(st.st_size) < sizeof(Header))
+    {
+        ::close(fd);
+        LOG_WARN("FingerprintFile.load()", "Fingerprint file \"" << this->path << "\" is damaged and is ignored");
+        return false;
+    }
+    void *mapped = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (mapped == MAP_FAILED)
+        return false;
+    this->base = static_cast<char *>(mapped);
+    this->length = st.st_size;
+
+    Header stored;
+    std::memcpy(&stored, this->base, sizeof(stored));
+    const Entry *stored_entries = reinterpret_cast<const Entry *>(this->base + sizeof(Header));
+    if (std::memcmp(stored.magic, FINGERPRINT_MAGIC, sizeof(FINGERPRINT_MAGIC)) != 0 ||
+        this->length != sizeof(Header) + stored.count * sizeof(Entry) ||
+        crc32c(stored_entries, stored.count * sizeof(Entry)) != stored.crc)
+    {
+        LOG_WARN("FingerprintFile.load()", "Fingerprint file \"" << this->path << "\" is damaged and is ignored");
+        return false;
+    }
+    if (stored.type != static_cast<uint32_t>(type))
+    {
+        LOG_INFO("FingerprintFile.load()", "Fingerprint file \"" << this->path << "\" was written for another type");
+        return false;
+    }
+
+    this->entries = stored_entries;
+    this->num_entries = stored.count;
+
+    // Выходной файл дописывается на месте, только если его не меняли после прошлого запуска
+    struct stat out;
+    this->output_matches = stat(output_path.c_str(), &out) == 0 &&
+                           static_cast<uint64_t>(out.st_size) == stored.output_size &&
+                           mtimeNanos(out) == stored.output_mtime;
+    return true;
+}
+
+uint64_t FingerprintFile::count() const
+{
+    return this->num_entries;
+}
+
+bool FingerprintFile::outputMatches() const
+{
+    return this->output_matches;
+}
+
+// Метод для поиска результата вектора на той же позиции
+bool FingerprintFile::at(uint64_t index, const CacheKey &key, uint64_t &result) const
+{
+    if (index >= this->num_entries)
+        return false;
+    const Entry &entry = this->entries[index];
+    if (entry.hi != key.hi || entry.lo != key.lo)
+        return false;
+    result = entry.result;
+    return true;
+}
+
+// Метод для поиска результата вектора на любой позиции
+bool FingerprintFile::find(const CacheKey &key, uint64_t &result)
+{
+    if (this->num_entries == 0)
+        return false;
+
+    size_t capacity = 16;
+    while (capacity < this->num_entries * 2)
+        capacity *= 2;
+    size_t mask = capacity - 1;
+
+    // Индекс строится один раз, повторы хешей хранятся по первому вхождению
+    if (this->index.empty())
+    {
+        this->index.assign(capacity, 0);
+        for (uint64_t i = 0; i < this->num_entries; ++i)
+        {
+            const Entry &entry = this->entries[i];
+            size_t slot = entry.lo & mask;
+            while (this->index[slot] != 0)
+            {
+                const Entry &other = this->entries[this->index[slot] - 1];
+                if (other.hi == entry.hi && other.lo == entry.lo)
+                    break;
+                slot = (slot + 1) & mask;
+            }
+            if (this->index[slot] == 0)
+                this->index[slot] = static_cast<uint32_t>(i + 1);
+        }
+    }
+
+    for (size_t slot = key.lo & mask; this->index[slot] != 0; slot = (slot + 1) & mask)
+    {
+        const Entry &entry = this->entries[this->index[slot] - 1];
+        if (entry.hi == key.hi && entry.lo == key.lo)
+        {
+            result = entry.result;
+            return true;
+        }
+    }
+    return false;
+}
+
+// Метод для начала записи нового файла отпечатков
+void FingerprintFile::create(DataType type)
+{
+    this->output.open(this->path + ".tmp", std::ios::binary | std::ios::trunc);
+    if (!this->output.is_open())
+        throw IOError("Failed to create fingerprint file \"" + this->path + ".tmp\"", "FingerprintFile.create()");
+
+    this->header = Header();
+    std::memcpy(this->header.magic, FINGERPRINT_MAGIC, sizeof(FINGERPRINT_MAGIC));
+    this->header.type = static_cast<uint32_t>(type);
+
+    // Заголовок перезаписывается в commit()
+    this->output.write(reinterpret_cast<const char *>(&this->header), sizeof(this->header));
+}
+
+// Метод для дозаписи отпечатков порции векторов
+void FingerprintFile::append(const CacheKey *keys, const uint64_t *results, size_t count)
+{
+    std::vector<Entry> chunk(count);
+    for (size_t i = 0; i < count; ++i)
+        chunk[i] = Entry{keys[i].hi, keys[i].lo, results[i]};
+
+    size_t bytes = count * sizeof(Entry);
+    this->header.crc = crc32c(chunk.data(), bytes, this->header.crc);
+    this->header.count += count;
+    this->output.write(reinterpret_cast<const char *>(chunk.data()), bytes);
+    if (!this->output)
+        throw IOError("Failed to write fingerprint file \"" + this->path + ".tmp\"", "FingerprintFile.append()");
+}
+
+// Метод для замены файла отпечатков новым
+void FingerprintFile::commit(const std::string &output_path)
+{
+    struct stat out;
+    if (stat(output_path.c_str(), &out) < 0)
+        throw IOError("Failed to get size of output file \"" + output_path + "\"", "FingerprintFile.commit()");
+    this->header.output_size = out.st_size;
+    this->header.output_mtime = mtimeNanos(out);
+
+    this->output.seekp(0);
+    this->output.write(reinterpret_cast<const char *>(&this->header), sizeof(this->header));
+    this->output.close();
+    if (!this->output)
+        throw IOError("Failed to write fingerprint file \"" + this->path + ".tmp\"", "FingerprintFile.commit()");
+    if (std::rename((this->path + ".tmp").c_str(), this->path.c_str()) < 0)
+        throw IOError("Failed to replace fingerprint file \"" + this->path + "\"", "FingerprintFile.commit()");
+}
+
+// Функция для записи результатов в заданное место выходного файла
+static void pwriteAll(int fd, const void *data, size_t bytes, off_t offset)
+{
+    const char *p = static_cast<const char *>(data);
+    while (bytes > 0)
+    {
+        ssize_t written = pwrite(fd, p, bytes, offset);
+        if (written <= 0)
+            throw IOError("Failed to patch output file", "IncrementalCalc.run()");
+        p += written;
+        bytes -= written;
+        offset += written;
+    }
+}
+
+// Конструктор
+template <typename T>
+BasicIncrementalCalc<T>::BasicIncrementalCalc(
+    IOManager &io_man,
+    NetworkManager &net_man,
+    const std::string &output_path,
+    size_t memory_limit,
+    bool huge_pages)
+    : io_man(io_man),
+      net_man(net_man),
+      output_path(output_path),
+      memory_limit(memory_limit),
+      huge_pages(huge_pages),
+      counters() {}
+
+// Метод для запуска обработки
+template <typename T>
+void BasicIncrementalCalc<T>::run()
+{
+    const DataType type = DataTypeOf<T>::value;
+    BasicVectorReader<T> reader = this->io_man.template reader<T>(this->memory_limit);
+    uint32_t total = reader.count();
+
+    std::string sidecar = FingerprintFile::pathFor(this->output_path);
+    FingerprintFile previous(sidecar);
+    bool loaded = previous.load(type, this->output_path);
+    this->counters = IncrementalStats();
+    this->counters.in_place = loaded && previous.count() == total && previous.outputMatches();
+
+    FingerprintFile next(sidecar);
+    next.create(type);
+
+    // При том же количестве векторов выходной файл не перезаписывается целиком
+    int out_fd = -1;
+    std::unique_ptr<BasicResultWriter<T>> writer;
+    if (this->counters.in_place)
+    {
+        out_fd = ::open(this->output_path.c_str(), O_WRONLY);
+        if (out_fd < 0)
+            throw IOError("Failed to open output file \"" + this->output_path + "\"", "IncrementalCalc.run()");
+    }
+    else
+    {
+        writer.reset(new BasicResultWriter<T>(this->io_man.template writer<T>(total)));
+    }
+
+    try
+    {
+        this->net_man.beginRounds();
+        BasicVectorBatch<T> chunk(this->huge_pages);
+        std::vector<CacheKey> keys;
+        std::vector<uint64_t> raw;
+        std::vector<char> changed;
+        std::vector<size_t> pending;
+        std::vector<BasicVectorView<T>> views;
+        uint64_t position = 0;
+
+        while (reader.next(chunk))
+        {
+            size_t count = chunk.size();
+            keys.resize(count);
+            raw.assign(count, 0);
+            changed.assign(count, 0);
+            pending.clear();
+            views.clear();
+
+            // Отправляются только векторы, которых не было во входном файле прошлого запуска
+            {
+                TraceSpan span("fingerprint", "io");
+                for (size_t i = 0; i < count; ++i)
+                {
+                    BasicVectorView<T> view = chunk[i];
+                    keys[i] = ResultCache::key(type, view.data, static_cast<size_t>(view.size) * sizeof(T));
+                    if (loaded && previous.at(position + i, keys[i], raw[i]))
+                        continue;
+                    changed[i] = 1;
+                    ++this->counters.changed;
+                    if (loaded && previous.find(keys[i], raw[i]))
+                    {
+                        ++this->counters.moved;
+                        continue;
+                    }
+                    pending.push_back(i);
+                    views.push_back(view);
+                }
+            }
+
+            std::vector<T> computed = this->net_man.exchange(views);
+            for (size_t j = 0; j < computed.size(); ++j)
+                std::memcpy(&raw[pending[j]], &computed[j], sizeof(T));
+            this->counters.sent += computed.size();
+            next.append(keys.data(), raw.data(), count);
+
+            std::vector<T> results(count);
+            for (size_t i = 0; i < count; ++i)
+                std::memcpy(&results[i], &raw[i], sizeof(T));
+
+            if (this->counters.in_place)
+            {
+                // Подряд идущие изменённые позиции перезаписываются одним вызовом
+                PhaseTimer timer(Phase::WRITE);
+                size_t patched = 0;
+                size_t i = 0;
+                while (i < count)
+                {
+                    if (!changed[i])
+                    {
+                        ++i;
+                        continue;
+                    }
+                    size_t end = i;
+                    while (end < count && changed[end])
+                        ++end;
+                    pwriteAll(out_fd, &results[i], (end - i) * sizeof(T),
+                              sizeof(uint32_t) + (position + i) * sizeof(T));
+                    patched += end - i;
+                    i = end;
+                }
+                timer.stop(patched * sizeof(T), patched);
+            }
+            else
+            {
+                writer->append(results);
+            }
+            position += count;
+        }
+        this->counters.vectors = position;
+
+        if (this->counters.in_place)
+        {
+            int fd = out_fd;
+            out_fd = -1;
+            if (::close(fd) < 0)
+                throw IOError("Failed to patch output file", "IncrementalCalc.run()");
+        }
+        else
+        {
+            writer->close();
+        }
+    }
+    catch (...)
+    {
+        if (out_fd >= 0)
+            ::close(out_fd);
+        throw;
+    }
+
+    // Отпечатки заменяются после записи выходного файла
+    next.commit(this->output_path);
+
+    LOG_INFO("IncrementalCalc.run()", "Incremental: vectors=" << this->counters.vectors
+                                                              << " changed=" << this->counters.changed
+                                                              << " moved=" << this->counters.moved
+                                                              << " sent=" << this->counters.sent
+                                                              << " output=" << (this->counters.in_place ? "patched" : "rewritten"));
+}
+
+template <typename T>
+const IncrementalStats &BasicIncrementalCalc<T>::stats() const
+{
+    return this->counters;
+}
+
+// Явное инстанцирование для поддерживаемых типов данных
+#define INSTANTIATE_INCREMENTAL(T) template class BasicIncrementalCalc<T>;
+FOR_EACH_DATA_TYPE(INSTANTIATE_INCREMENTAL)
@@ -0,0 +1,227 @@
+#ifndef INCREMENTAL_H
+#define INCREMENTAL_H
+
+#include <cstdint>
+#include <cstddef>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "io.h"
+#include "network.h"
+#include "cache.h"
+#include "errors.h"
+#include "types.h"
+
+/**
+* @file incremental.h
+* @brief Определения классов для инкрементальной обработки входного файла.
+* @details Рядом с выходным файлом хранится файл отпечатков (OUTPUT.vcinc):
+* заголовок и записи по 24 байта (128-битный хеш вектора и его результат)
+* для каждой позиции входного файла. При повторном запуске вектор, хеш
+* которого совпадает с записью той же позиции, не отправляется; вектор,
+* перемещённый на другую позицию, находится по хешу среди всех записей.
+* Серверу отправляются только изменённые и новые векторы. Если количество
+* векторов не изменилось, а выходной файл совпадает с записанным в прошлый
+* раз (по размеру и времени изменения), в нём перезаписываются только
+* результаты изменённых позиций, иначе он записывается заново из сохранённых
+* и новых результатов. Новый файл отпечатков пишется во временный файл и
+* заменяет старый после записи выходного файла.
+* @date 17.10.2026
+* @version 1.0
+* @authors Косов Р. С.
+* @copyright ИБСТ ПГУ
+*/
+
+/**
+* @brief Класс файла отпечатков векторов и их результатов.
+*/
+class FingerprintFile
+{
+public:
+    /**
+    * @brief Конструктор класса FingerprintFile.
+    * @param path Путь к файлу отпечатков.
+    */
+    explicit FingerprintFile(const std::string &path);
+
+    /**
+    * @brief Деструктор класса FingerprintFile.
+    * @details Незавершённый новый файл отпечатков удаляется.
+    */
+    ~FingerprintFile();
+
+    FingerprintFile(const FingerprintFile &) = delete;
+    FingerprintFile &operator=(const FingerprintFile &) = delete;
+
+    /**
+    * @brief Метод для получения пути к файлу отпечатков выходного файла.
+    * @param output_path Путь к выходному файлу.
+    * @return Путь к файлу отпечатков.
+    */
+    static std::string pathFor(const std::string &output_path);
+
+    /**
+    * @brief Метод для загрузки отпечатков прошлого запуска.
+    * @details Отсутствующий, повреждённый или записанный для другого типа
+    * значений файл не загружается.
+    * @param type Тип значений векторов.
+    * @param output_path Путь к выходному файлу.
+    * @return true, если отпечатки загружены.
+    */
+    bool load(DataType type, const std::string &output_path);
+
+    /**
+    * @brief Метод для получения количества загруженных отпечатков.
+    * @return Количество векторов прошлого запуска.
+    */
+    uint64_t count() const;
+
+    /**
+    * @brief Метод для проверки, не изменялся ли выходной файл после прошлого запуска.
+    * @return true, если выходной файл можно дописывать на месте.
+    */
+    bool outputMatches() const;
+
+    /**
+    * @brief Метод для поиска результата вектора на той же позиции.
+    * @param index Позиция вектора.
+    * @param key Хеш вектора.
+    * @param result Результат (биты значения типа T в младших байтах).
+    * @return true, если на позиции прошлого запуска был тот же вектор.
+    */
+    bool at(uint64_t index, const CacheKey &key, uint64_t &result) const;
+
+    /**
+    * @brief Метод для поиска результата вектора на любой позиции.
+    * @details Индекс по хешам строится при первом вызове.
+    * @param key Хеш вектора.
+    * @param result Результат (биты значения типа T в младших байтах).
+    * @return true, если вектор был во входном файле прошлого запуска.
+    */
+    bool find(const CacheKey &key, uint64_t &result);
+
+    /**
+    * @brief Метод для начала записи нового файла отпечатков.
+    * @param type Тип значений векторов.
+    * @throw IOError Если не удалось создать временный файл.
+    */
+    void create(DataType type);
+
+    /**
+    * @brief Метод для дозаписи отпечатков порции векторов.
+    * @param keys Хеши векторов.
+    * @param results Результаты (биты значения типа T в младших байтах).
+    * @param count Количество векторов.
+    * @throw IOError Если запись не удалась.
+    */
+    void append(const CacheKey *keys, const uint64_t *results, size_t count);
+
+    /**
+    * @brief Метод для замены файла отпечатков новым.
+    * @details Вызывается после закрытия выходного файла: в заголовок
+    * записываются его размер и время изменения.
+    * @param output_path Путь к выходному файлу.
+    * @throw IOError Если не удалось записать или переименовать файл.
+    */
+    void commit(const std::string &output_path);
+
+private:
+    /**
+    * @brief Заголовок файла отпечатков.
+    */
+    struct Header
+    {
+        char magic[8]; ///< Сигнатура "VCINCR01".
+        uint32_t type; ///< Тип значений векторов.
+        uint32_t crc; ///< CRC32C записей.
+        uint64_t count; ///< Количество записей.
+        uint64_t output_size; ///< Размер выходного файла.
+        int64_t output_mtime; ///< Время изменения выходного файла в наносекундах.
+        uint64_t reserved[3]; ///< Зарезервировано.
+    };
+
+    /**
+    * @brief Запись файла отпечатков.
+    */
+    struct Entry
+    {
+        uint64_t hi; ///< Старшая половина хеша.
+        uint64_t lo; ///< Младшая половина хеша.
+        uint64_t result; ///< Результат.
+    };
+
+    std::string path; ///< Путь к файлу отпечатков.
+    char *base; ///< Отображение загруженного файла.
+    size_t length; ///< Размер отображения.
+    const Entry *entries; ///< Загруженные записи.
+    uint64_t num_entries; ///< Количество загруженных записей.
+    bool output_matches; ///< Флаг совпадения выходного файла с прошлым запуском.
+    std::vector<uint32_t> index; ///< Индекс записей по хешу (номер + 1, 0 - ячейка пуста).
+    std::ofstream output; ///< Новый файл отпечатков.
+    Header header; ///< Заголовок нового файла.
+};
+
+/**
+* @brief Счётчики инкрементальной обработки.
+*/
+struct IncrementalStats
+{
+    uint64_t vectors; ///< Количество векторов.
+    uint64_t changed; ///< Количество позиций, вектор которых изменился.
+    uint64_t moved; ///< Количество изменённых позиций, вектор которых найден на другой позиции.
+    uint64_t sent; ///< Количество векторов, отправленных серверу.
+    bool in_place; ///< Флаг записи выходного файла на месте.
+};
+
+/**
+* @brief Класс для инкрементальной обработки входного файла.
+* @details Входной файл читается потоково; каждая порция хешируется,
+* изменённые векторы порции отправляются отдельным раундом.
+* @tparam T Тип значений векторов.
+*/
+template <typename T>
+class BasicIncrementalCalc
+{
+public:
+    /**
+    * @brief Конструктор класса BasicIncrementalCalc.
+    * @param io_man Менеджер ввода-вывода.
+    * @param net_man Подключённый и аутентифицированный менеджер сети.
+    * @param output_path Путь к выходному файлу.
+    * @param memory_limit Ограничение объёма одной порции векторов (в байтах).
+    * @param huge_pages Размещать ли порции в больших страницах памяти.
+    */
+    BasicIncrementalCalc(
+        IOManager &io_man,
+        NetworkManager &net_man,
+        const std::string &output_path,
+        size_t memory_limit,
+        bool huge_pages);
+
+    /**
+    * @brief Метод для запуска обработки.
+    * @throw IOError Если произошла ошибка ввода-вывода.
+    * @throw DataDecodeError Если входной файл повреждён.
+    * @throw NetworkError Если произошла сетевая ошибка.
+    */
+    void run();
+
+    /**
+    * @brief Метод для получения счётчиков последнего запуска.
+    * @return Счётчики обработки.
+    */
+    const IncrementalStats &stats() const;
+
+private:
+    IOManager &io_man; ///< Менеджер ввода-вывода.
+    NetworkManager &net_man; ///< Менеджер сети.
+    std::string output_path; ///< Путь к выходному файлу.
+    size_t memory_limit; ///< Ограничение объёма порции.
+    bool huge_pages; ///< Флаг размещения порций в больших страницах.
+    IncrementalStats counters; ///< Счётчики обработки.
+};
+
+/// Инкрементальная обработка векторов из значений uint32_t.
+typedef BasicIncrementalCalc<uint32_t> IncrementalCalc;
+
+#endif // INCREMENTAL_H
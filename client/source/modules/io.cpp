@@ -1,7 +1,12 @@
 #include "io.h"
 #include <fstream>
 #include <sstream>
-#include <iostream>
+#include "log.h"
+#include "metrics.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <sys/stat.h>
 
 // Конструктор
 IOManager::IOManager(
@@ -10,11 +15,312 @@ IOManager::IOManager(
     const std::string &path_to_out)
     : path_to_conf(path_to_conf),
       path_to_in(path_to_in),
-      path_to_out(path_to_out) {}
+      path_to_out(path_to_out),
+      backend(FileBackend::STREAM),
+      queue_depth(4) {}
+
+// Конструктор потокового читателя
+template <typename T>
+BasicVectorReader<T>::BasicVectorReader(
+    const std::string &path,
+    size_t memory_limit,
+    FileBackend backend,
+    size_t queue_depth)
+    : memory_limit(memory_limit),
+      num_vectors(0),
+      num_read(0),
+      held_size(0),
+      held(false),
+      bytes_left(0)
+{
+    // Формат v2 читается через индекс независимо от способа чтения
+    if (isContainerFile(path))
+    {
+        this->container.reset(new BasicContainerInput<T>(path));
+        if (this->container->count() > UINT32_MAX)
+        {
+            throw DataDecodeError(
+                "Container has more vectors than one session can send",
+                "VectorReader.VectorReader()");
+        }
+        this->num_vectors = static_cast<uint32_t>(this->container->count());
+        return;
+    }
+
+    // Текстовый формат разбирается из отображения в память
+    if (isTextFile(path))
+    {
+        this->text.reset(new BasicTextInput<T>(path));
+        this->num_vectors = this->text->count();
+        return;
+    }
+
+    // Размер файла ограничивает размеры векторов из заголовков
+    struct stat info;
+    if (stat(path.c_str(), &info) == 0)
+        this->bytes_left = static_cast<uint64_t>(info.st_size);
+
+    if (backend == FileBackend::URING)
+    {
+        this->ring_input.reset(new RingFileReader(path, queue_depth));
+    }
+    else
+    {
+        this->input_file.open(path, std::ios::binary);
+        if (!this->input_file.is_open())
+        {
+            throw IOError("Failed to open input file for reading.", "IOManager.read()");
+        }
+    }
+
+    // Чтение количества векторов
+    if (!this->readBytes(&this->num_vectors, sizeof(this->num_vectors)))
+    {
+        throw DataDecodeError("Failed to read number of vectors", "VectorReader.VectorReader()");
+    }
+
+    // Каждый вектор занимает в файле не меньше своего размера
+    if (static_cast<uint64_t>(this->num_vectors) * sizeof(uint32_t) > this->bytes_left)
+    {
+        throw DataDecodeError("Number of vectors exceeds input file length", "VectorReader.VectorReader()");
+    }
+}
+
+// Метод для чтения очередных байтов входного файла
+template <typename T>
+bool BasicVectorReader<T>::readBytes(void *data, size_t length)
+{
+    bool read = this->ring_input ? this->ring_input->read(data, length)
+                                 : static_cast<bool>(this->input_file.read(static_cast<char *>(data), length));
+    if (read)
+        this->bytes_left -= std::min<uint64_t>(length, this->bytes_left);
+    return read;
+}
+
+template <typename T>
+uint32_t BasicVectorReader<T>::count() const
+{
+    return this->num_vectors;
+}
+
+template <typename T>
+uint32_t BasicVectorReader<T>::remaining() const
+{
+    return this->num_vectors - this->num_read;
+}
+
+// Метод для получения количества ещё не прочитанных значений
+template <typename T>
+uint64_t BasicVectorReader<T>::valuesLeft() const
+{
+    if (this->container || this->text)
+        return 0;
+
+    // Размер отложенного вектора уже прочитан из файла
+    uint64_t headers = static_cast<uint64_t>(this->remaining() - (this->held ? 1 : 0)) * sizeof(uint32_t);
+    return this->bytes_left > headers ? (this->bytes_left - headers) / sizeof(T) : 0;
+}
+
+// Метод для чтения очередной порции векторов
+template <typename T>
+bool BasicVectorReader<T>::next(BasicVectorBatch<T> &chunk)
+{
+    return this->next(chunk, SIZE_MAX);
+}
+
+// Метод для чтения очередной порции с ограничением количества векторов
+template <typename T>
+bool BasicVectorReader<T>::next(BasicVectorBatch<T> &chunk, size_t max_vectors)
+{
+    PhaseTimer timer(Phase::READ);
+    if (this->container)
+    {
+        this->num_read += this->container->read(this->num_read, max_vectors, this->memory_limit, chunk);
+        timer.stop(chunk.bytes(), chunk.size());
+        return !chunk.empty();
+    }
+    if (this->text)
+    {
+        this->num_read += this->text->read(max_vectors, this->memory_limit, chunk);
+        timer.stop(chunk.bytes(), chunk.size());
+        return !chunk.empty();
+    }
+
+    chunk.clear();
+    size_t chunk_bytes = 0;
+
+    while (this->num_read < this->num_vectors && chunk.size() < max_vectors)
+    {
+        // Чтение размера вектора (или размера, отложенного прошлой порцией)
+        uint32_t vector_size = this->held_size;
+        if (!this->held && !this->readBytes(&vector_size, sizeof(vector_size)))
+        {
+            throw DataDecodeError("Unexpected end of input file", "VectorReader.next()");
+        }
+        this->held = false;
+
+        // Повреждённый размер не должен приводить к выделению памяти сверх размера файла
+        size_t vector_bytes = static_cast<size_t>(vector_size) * sizeof(T);
+        if (vector_bytes > this->bytes_left)
+        {
+            throw DataDecodeError("Vector size exceeds input file length", "VectorReader.next()");
+        }
+
+        // Порция заполнена - размер вектора откладывается до следующей порции
+        if (!chunk.empty() && chunk_bytes + vector_bytes > this->memory_limit)
+        {
+            this->held_size = vector_size;
+            this->held = true;
+            break;
+        }
+
+        // Чтение значений вектора прямо в буфер порции
+        T *values = chunk.append(vector_size);
+        if (!this->readBytes(values, vector_bytes))
+        {
+            throw DataDecodeError("Unexpected end of input file", "VectorReader.next()");
+        }
+        chunk_bytes += vector_bytes;
+        ++this->num_read;
+    }
+
+    timer.stop(chunk.bytes(), chunk.size());
+    return !chunk.empty();
+}
+
+// Конструктор потокового писателя
+template <typename T>
+BasicResultWriter<T>::BasicResultWriter(
+    const std::string &path,
+    uint32_t count,
+    FileBackend backend,
+    size_t queue_depth)
+    : path(path),
+      part_path(path + ".part"),
+      count(count),
+      num_written(0),
+      finished(false)
+{
+    // Запись количества результатов
+    if (backend == FileBackend::URING)
+    {
+        this->ring_output.reset(new RingFileWriter(this->part_path, queue_depth));
+        this->ring_output->write(&this->count, sizeof(this->count));
+        return;
+    }
+
+    this->output_file.open(this->part_path, std::ios::binary);
+    if (!this->output_file.is_open())
+    {
+        throw IOError(
+            "Failed to open output file \"" +
+                this->path + "\"",
+            "IOManager.write()");
+    }
+    this->output_file.write(reinterpret_cast<const char *>(&this->count), sizeof(this->count));
+}
+
+// Конструктор перемещения потокового писателя
+template <typename T>
+BasicResultWriter<T>::BasicResultWriter(BasicResultWriter &&other)
+    : output_file(std::move(other.output_file)),
+      ring_output(std::move(other.ring_output)),
+      path(other.path),
+      part_path(other.part_path),
+      count(other.count),
+      num_written(other.num_written),
+      finished(other.finished)
+{
+    other.finished = true;
+}
+
+// Деструктор потокового писателя
+template <typename T>
+BasicResultWriter<T>::~BasicResultWriter()
+{
+    if (this->finished)
+        return;
+
+    // Незавершённая запись не оставляет выходного файла с неполными результатами
+    this->ring_output.reset();
+    this->output_file.close();
+    std::remove(this->part_path.c_str());
+}
+
+// Метод для дозаписи порции результатов
+template <typename T>
+void BasicResultWriter<T>::append(const std::vector<T> &results)
+{
+    PhaseTimer timer(Phase::WRITE);
+    if (results.size() > static_cast<size_t>(this->count - this->num_written))
+    {
+        throw IOError("Too many results for output file", "ResultWriter.append()");
+    }
+
+    if (this->ring_output)
+    {
+        this->ring_output->write(results.data(), results.size() * sizeof(T));
+        this->num_written += results.size();
+        timer.stop(results.size() * sizeof(T), results.size());
+        return;
+    }
+
+    this->output_file.write(
+        reinterpret_cast<const char *>(results.data()),
+        results.size() * sizeof(T));
+    if (!this->output_file)
+    {
+        throw IOError("Failed to write output file \"" + this->path + "\"", "ResultWriter.append()");
+    }
+    this->num_written += results.size();
+    timer.stop(results.size() * sizeof(T), results.size());
+}
+
+// Метод для завершения записи
+template <typename T>
+void BasicResultWriter<T>::close()
+{
+    if (this->ring_output)
+    {
+        this->ring_output->close();
+    }
+    else
+    {
+        this->output_file.close();
+        if (!this->output_file)
+            throw IOError("Failed to write output file \"" + this->path + "\"", "ResultWriter.close()");
+    }
+    if (this->num_written != this->count)
+    {
+        throw IOError("Not all results were written", "ResultWriter.close()");
+    }
+
+    // Выходной файл появляется только целиком
+    if (std::rename(this->part_path.c_str(), this->path.c_str()) != 0)
+    {
+        throw IOError("Failed to rename output file \"" + this->path + "\"", "ResultWriter.close()");
+    }
+    this->finished = true;
+}
+
+// Метод для смены входного и выходного файлов
+void IOManager::setPaths(const std::string &path_to_in, const std::string &path_to_out)
+{
+    this->path_to_in = path_to_in;
+    this->path_to_out = path_to_out;
+}
+
+// Метод для выбора способа чтения и записи файлов
+void IOManager::setBackend(FileBackend backend, size_t queue_depth)
+{
+    this->backend = backend;
+    this->queue_depth = queue_depth > 0 ? queue_depth : 1;
+}
 
 // Метод для чтения конфигурационных данных
 std::array<std::string, 2> IOManager::conf()
 {
+    PhaseTimer timer(Phase::CONF);
     std::ifstream conf_file(this->path_to_conf);
     if (!conf_file.is_open())
     {
@@ -41,85 +347,75 @@ std::array<std::string, 2> IOManager::conf()
             "IOManager.conf()");
     }
 
-    // Логирование считанных логина и пароля
-    std::cout << "Log: \"IOManager.conf()\"\n";
-    std::cout << "UserData: " << credentials[0]
-              << " " << credentials[1] << "\n";
+    timer.stop();
+
+    // Пароль в журнал не попадает
+    LOG_INFO("IOManager.conf()", "UserData: " << credentials[0]);
 
     return credentials;
 }
 
 // Метод для чтения числовых данных с логированием
-std::vector<std::vector<uint32_t>> IOManager::read()
+template <typename T>
+BasicVectorBatch<T> IOManager::read()
 {
-    std::ifstream input_file(this->path_to_in, std::ios::binary);
-    if (!input_file.is_open())
-    {
-        throw IOError("Failed to open input file for reading.", "IOManager.read()");
-    }
-
-    // Чтение количества векторов
-    uint32_t num_vectors;
-    input_file.read(reinterpret_cast<char *>(&num_vectors), sizeof(num_vectors));
-
-    std::vector<std::vector<uint32_t>> data(num_vectors);
-
-    // Чтение каждого вектора
-    for (uint32_t i = 0; i < num_vectors; ++i)
-    {
-        // Чтение размера вектора
-        uint32_t vector_size;
-        input_file.read(reinterpret_cast<char *>(&vector_size), sizeof(vector_size));
+    // Чтение всего файла одной порцией
+    BasicVectorReader<T> input = this->reader<T>(SIZE_MAX);
 
-        // Чтение значений вектора
-        std::vector<uint32_t> vec(vector_size);
-        input_file.read(reinterpret_cast<char *>(vec.data()), vector_size * sizeof(uint32_t));
+    // Объём значений двоичного файла известен заранее - память выделяется один раз
+    BasicVectorBatch<T> data;
+    uint64_t values = input.valuesLeft();
+    if (values > 0)
+        data.reserve(input.count(), static_cast<size_t>(values));
 
-        data[i] = vec;
-    }
-
-    input_file.close();
+    input.next(data);
 
-    // Логирование всех прочитанных векторов
-    std::cout << "Log: IOManager.read()\n";
-    std::cout << "Vectors: {";
-    for (const auto &vec : data)
-    {
-        std::cout << "{";
-        for (const auto &val : vec)
-            std::cout << val << ", ";
-        if (!vec.empty())
-            std::cout << "\b\b";
-        std::cout << "}, ";
-    }
-    if (!data.empty())
-        std::cout << "\b\b";
-    std::cout << "}\n";
+    // Сводка вместо полного вывода, выборка первых векторов - на уровне DEBUG
+    LOG_INFO("IOManager.read()", "Vectors: count=" << data.size() << " values=" << data.values());
+    for (size_t i = 0; i < data.size() && i < 4 && Logger::enabled(LogLevel::DEBUG); ++i)
+        LOG_DEBUG("IOManager.read()", "Vector " << i << ": size=" << data[i].size << " "
+                                                << logSample(data[i].begin(), data[i].end(), 8));
 
     return data;
 }
 
 // Метод для записи числовых данных
-void IOManager::write(const std::vector<uint32_t> &data)
+template <typename T>
+void IOManager::write(const std::vector<T> &data)
 {
-    std::ofstream output_file(this->path_to_out, std::ios::binary);
-    if (!output_file.is_open())
-    {
-        throw IOError(
-            "Failed to open output file \"" +
-                this->path_to_out + "\"",
-            "IOManager.write()");
-    }
+    BasicResultWriter<T> output = this->writer<T>(data.size());
+    output.append(data);
+    output.close();
+}
 
-    // Запись количества результатов
-    uint32_t count = data.size();
-    output_file.write(reinterpret_cast<const char *>(&count), sizeof(count));
+// Метод для потокового чтения
+template <typename T>
+BasicVectorReader<T> IOManager::reader(size_t memory_limit)
+{
+    return BasicVectorReader<T>(this->path_to_in, memory_limit, this->backend, this->queue_depth);
+}
 
-    // Запись самих результатов
-    for (const auto &num : data)
-    {
-        output_file.write(reinterpret_cast<const char *>(&num), sizeof(num));
-    }
-    
-    output_file.close();
+// Метод для потоковой записи
+template <typename T>
+BasicResultWriter<T> IOManager::writer(uint32_t count)
+{
+    return BasicResultWriter<T>(this->path_to_out, count, this->backend, this->queue_depth);
 }
+
+// Метод для чтения через отображение в память
+template <typename T>
+BasicMappedInput<T> IOManager::map()
+{
+    return BasicMappedInput<T>(this->path_to_in);
+}
+
+// Явное инстанцирование для поддерживаемых типов данных
+#define INSTANTIATE_IO(T)                                                      \
+    template class BasicVectorReader<T>;                                       \
+    template class BasicResultWriter<T>;                                       \
+    template BasicVectorBatch<T> IOManager::read<T>();                         \
+    template void IOManager::write<T>(const std::vector<T> &);                 \
+    template BasicVectorReader<T> IOManager::reader<T>(size_t);                \
+    template BasicResultWriter<T> IOManager::writer<T>(uint32_t);              \
+    template BasicMappedInput<T> IOManager::map<T>();
+FOR_EACH_DATA_TYPE(INSTANTIATE_IO)
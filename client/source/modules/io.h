@@ -4,7 +4,15 @@
 #include <string>
 #include <vector>
 #include <array>
+#include <fstream>
+#include <cstddef>
+#include <memory>
 #include "errors.h"
+#include "batch.h"
+#include "mapped.h"
+#include "container.h"
+#include "text.h"
+#include "uring.h"
 
 /** 
 * @file io.h
@@ -16,8 +24,179 @@
 * @copyright ИБСТ ПГУ
 */
 
+/**
+* @brief Способ чтения и записи файлов.
+*/
+enum class FileBackend
+{
+    STREAM, ///< Блокирующие std::ifstream/std::ofstream.
+    URING   ///< io_uring с упреждающим чтением и асинхронной записью (или pread/pwrite).
+};
+
+/** 
+* @brief Класс для потокового чтения векторов из входного файла.
+* @details Векторы читаются порциями, суммарный объём значений в порции
+* не превышает заданного ограничения памяти (кроме случая, когда один
+* вектор сам по себе больше ограничения - тогда он читается отдельно).
+* Файлы в индексированном формате v2 распознаются по сигнатуре и читаются
+* через индекс с проверкой CRC32C каждого вектора, файлы в текстовом формате
+* распознаются по первым строкам и разбираются в несколько потоков.
+* @tparam T Тип значений векторов.
+*/
+template <typename T>
+class BasicVectorReader {
+public:
+    /**
+    * @brief Конструктор класса BasicVectorReader.
+    * @param path Путь к входному файлу.
+    * @param memory_limit Ограничение объёма значений в одной порции (в байтах).
+    * @param backend Способ чтения файла.
+    * @param queue_depth Количество блоков, читаемых с упреждением (для FileBackend::URING).
+    * @throw IOError Если не удалось открыть входной файл для чтения.
+    * @throw DataDecodeError Если не удалось прочитать количество векторов или файл v2
+    * содержит больше векторов, чем помещается в одну сессию (2^32 - 1).
+    */
+    BasicVectorReader(
+        const std::string& path,
+        size_t memory_limit,
+        FileBackend backend = FileBackend::STREAM,
+        size_t queue_depth = 4
+    );
+
+    /**
+    * @brief Метод для получения общего количества векторов в файле.
+    * @return Количество векторов.
+    */
+    uint32_t count() const;
+
+    /**
+    * @brief Метод для получения количества ещё не прочитанных векторов.
+    * @return Количество оставшихся векторов.
+    */
+    uint32_t remaining() const;
+
+    /**
+    * @brief Метод для получения количества ещё не прочитанных значений.
+    * @details Известно заранее только для двоичного формата v1, где значения
+    * занимают всё место после заголовков векторов.
+    * @return Количество значений (0, если заранее неизвестно).
+    */
+    uint64_t valuesLeft() const;
+
+    /**
+    * @brief Метод для чтения очередной порции векторов.
+    * @param chunk Порция векторов (очищается перед заполнением, память переиспользуется).
+    * @return false, если все векторы уже прочитаны.
+    * @throw DataDecodeError Если входной файл обрывается раньше времени или строка
+    * текстового файла не разбирается.
+    */
+    bool next(BasicVectorBatch<T>& chunk);
+
+    /**
+    * @brief Метод для чтения очередной порции с ограничением количества векторов.
+    * @param chunk Порция векторов (очищается перед заполнением, память переиспользуется).
+    * @param max_vectors Максимальное количество векторов в порции.
+    * @return false, если все векторы уже прочитаны.
+    * @throw DataDecodeError Если входной файл обрывается раньше времени или строка
+    * текстового файла не разбирается.
+    */
+    bool next(BasicVectorBatch<T>& chunk, size_t max_vectors);
+
+private:
+    std::ifstream input_file; ///< Входной файл (для FileBackend::STREAM).
+    std::unique_ptr<RingFileReader> ring_input; ///< Входной файл (для FileBackend::URING).
+    std::unique_ptr<BasicContainerInput<T>> container; ///< Входной файл в формате v2.
+    std::unique_ptr<BasicTextInput<T>> text; ///< Входной файл в текстовом формате.
+    size_t memory_limit; ///< Ограничение объёма порции в байтах.
+    uint32_t num_vectors; ///< Общее количество векторов.
+    uint32_t num_read; ///< Количество прочитанных векторов.
+    uint32_t held_size; ///< Размер вектора, не поместившегося в прошлую порцию.
+    bool held; ///< Флаг наличия отложенного размера вектора.
+    uint64_t bytes_left; ///< Количество непрочитанных байтов входного файла.
+
+    /**
+    * @brief Метод для чтения очередных байтов входного файла.
+    * @param data Буфер для данных.
+    * @param length Количество байтов.
+    * @return false, если файл закончился раньше.
+    */
+    bool readBytes(void* data, size_t length);
+};
+
+/** 
+* @brief Класс для потоковой записи результатов в выходной файл.
+* @details Количество результатов записывается сразу, сами результаты
+* дописываются по мере поступления во временный файл OUTPUT.part, который
+* переименовывается в выходной при закрытии. Если запись не завершена,
+* временный файл удаляется, а прежний выходной файл остаётся нетронутым.
+* @tparam T Тип результатов.
+*/
+template <typename T>
+class BasicResultWriter {
+public:
+    /**
+    * @brief Конструктор класса BasicResultWriter.
+    * @param path Путь к выходному файлу.
+    * @param count Ожидаемое количество результатов.
+    * @param backend Способ записи файла.
+    * @param queue_depth Количество буферов асинхронной записи (для FileBackend::URING).
+    * @throw IOError Если не удалось открыть выходной файл для записи.
+    */
+    BasicResultWriter(
+        const std::string& path,
+        uint32_t count,
+        FileBackend backend = FileBackend::STREAM,
+        size_t queue_depth = 4
+    );
+
+    /**
+    * @brief Конструктор перемещения.
+    * @param other Перемещаемый объект.
+    */
+    BasicResultWriter(BasicResultWriter &&other);
+
+    BasicResultWriter(const BasicResultWriter &) = delete;
+    BasicResultWriter &operator=(const BasicResultWriter &) = delete;
+
+    /**
+    * @brief Деструктор класса BasicResultWriter.
+    * @details Удаляет временный файл, если запись не была завершена.
+    */
+    ~BasicResultWriter();
+
+    /**
+    * @brief Метод для дозаписи порции результатов.
+    * @param results Порция результатов.
+    * @throw IOError Если результатов больше, чем ожидалось, или запись не удалась.
+    */
+    void append(const std::vector<T>& results);
+
+    /**
+    * @brief Метод для завершения записи и переименования временного файла в выходной.
+    * @throw IOError Если записано меньше результатов, чем ожидалось, или запись не удалась.
+    */
+    void close();
+
+private:
+    std::ofstream output_file; ///< Выходной файл (для FileBackend::STREAM).
+    std::unique_ptr<RingFileWriter> ring_output; ///< Выходной файл (для FileBackend::URING).
+    std::string path; ///< Путь к выходному файлу.
+    std::string part_path; ///< Путь к временному файлу.
+    uint32_t count; ///< Ожидаемое количество результатов.
+    uint32_t num_written; ///< Количество записанных результатов.
+    bool finished; ///< Флаг завершения записи (временный файл переименован).
+};
+
+/// Потоковое чтение векторов из значений uint32_t.
+typedef BasicVectorReader<uint32_t> VectorReader;
+
+/// Потоковая запись результатов uint32_t.
+typedef BasicResultWriter<uint32_t> ResultWriter;
+
 /** 
 * @brief Класс для управления вводом и выводом данных.
+* @details Методы чтения и записи данных параметризованы типом значений T
+* (по умолчанию uint32_t), тип выбирается один раз при запуске клиента.
 */
 class IOManager {
 public:
@@ -33,6 +212,22 @@ public:
         const std::string& path_to_out
     );
 
+    /**
+    * @brief Метод для смены входного и выходного файлов.
+    * @details Позволяет переиспользовать менеджер для нескольких заданий.
+    * @param path_to_in Путь к входному файлу.
+    * @param path_to_out Путь к выходному файлу.
+    */
+    void setPaths(const std::string& path_to_in, const std::string& path_to_out);
+
+    /**
+    * @brief Метод для выбора способа чтения и записи файлов.
+    * @details Действует на объекты, создаваемые методами reader(), writer(), read() и write().
+    * @param backend Способ чтения и записи.
+    * @param queue_depth Количество блоков в обработке для FileBackend::URING.
+    */
+    void setBackend(FileBackend backend, size_t queue_depth);
+
     /**
     * @brief Метод для чтения конфигурационных данных.
     * @return Массив строк с конфигурационными данными.
@@ -43,22 +238,57 @@ public:
 
     /**
     * @brief Метод для чтения данных из файла.
-    * @return Двумерный вектор с данными.
+    * @tparam T Тип значений векторов.
+    * @return Порция со всеми векторами файла.
     * @throw IOError Если не удалось открыть входной файл для чтения.
     */
-    std::vector<std::vector<uint32_t>> read();
+    template <typename T = uint32_t>
+    BasicVectorBatch<T> read();
 
     /**
     * @brief Метод для записи данных в файл.
+    * @tparam T Тип результатов.
     * @param data Вектор данных для записи.
     * @throw IOError Если не удалось открыть выходной файл для записи.
     */
-    void write(const std::vector<uint32_t>& data);
+    template <typename T = uint32_t>
+    void write(const std::vector<T>& data);
+
+    /**
+    * @brief Метод для потокового чтения входного файла.
+    * @tparam T Тип значений векторов.
+    * @param memory_limit Ограничение объёма одной порции векторов (в байтах).
+    * @return Объект для чтения векторов порциями.
+    * @throw IOError Если не удалось открыть входной файл для чтения.
+    */
+    template <typename T = uint32_t>
+    BasicVectorReader<T> reader(size_t memory_limit);
+
+    /**
+    * @brief Метод для потоковой записи результатов.
+    * @tparam T Тип результатов.
+    * @param count Ожидаемое количество результатов.
+    * @return Объект для записи результатов порциями.
+    * @throw IOError Если не удалось открыть выходной файл для записи.
+    */
+    template <typename T = uint32_t>
+    BasicResultWriter<T> writer(uint32_t count);
+
+    /**
+    * @brief Метод для чтения входного файла через отображение в память.
+    * @tparam T Тип значений векторов.
+    * @return Объект для чтения векторов без копирования.
+    * @throw IOError Если не удалось открыть или отобразить входной файл.
+    */
+    template <typename T = uint32_t>
+    BasicMappedInput<T> map();
 
 private:
     std::string path_to_conf; ///< Путь к файлу конфигурации.
     std::string path_to_in; ///< Путь к входному файлу.
     std::string path_to_out; ///< Путь к выходному файлу.
+    FileBackend backend; ///< Способ чтения и записи файлов.
+    size_t queue_depth; ///< Количество блоков в обработке для FileBackend::URING.
 };
 
 #endif // IO_MANAGER_H
@@ -0,0 +1,177 @@
+#include "log.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+// Пауза фонового потока, когда буфер пуст
+static const std::chrono::milliseconds IDLE_SLEEP(2);
+
+std::atomic<int> Logger::current_level(static_cast<int>(LogLevel::INFO));
+
+// Функция для разбора уровня журнала из строки
+LogLevel parseLogLevel(const std::string &name)
+{
+    if (name == "debug")
+        return LogLevel::DEBUG;
+    if (name == "info")
+        return LogLevel::INFO;
+    if (name == "warn")
+        return LogLevel::WARN;
+    if (name == "error")
+        return LogLevel::ERROR;
+    if (name == "off")
+        return LogLevel::OFF;
+    throw ArgsDecodeError("Unsupported log level: " + name, "parseLogLevel()");
+}
+
+// Конструктор
+Logger::Logger()
+    : slots(new Slot[CAPACITY]),
+      write_pos(0),
+      read_pos(0),
+      lost(0),
+      reported_lost(0),
+      stopping(false),
+      out(stdout),
+      err(stderr)
+{
+    for (size_t i = 0; i < CAPACITY; ++i)
+        this->slots[i].sequence.store(i, std::memory_order_relaxed);
+    this->flusher = std::thread(&Logger::run, this);
+}
+
+// Деструктор
+Logger::~Logger()
+{
+    this->stopping.store(true);
+    this->flusher.join();
+    this->drain();
+}
+
+Logger &Logger::instance()
+{
+    static Logger logger;
+    return logger;
+}
+
+void Logger::setLevel(LogLevel level)
+{
+    current_level.store(static_cast<int>(level), std::memory_order_relaxed);
+}
+
+LogLevel Logger::level()
+{
+    return static_cast<LogLevel>(current_level.load(std::memory_order_relaxed));
+}
+
+// Метод для смены потоков вывода
+void Logger::setOutput(FILE *out, FILE *err)
+{
+    this->flush();
+    this->out.store(out);
+    this->err.store(err);
+}
+
+uint64_t Logger::dropped() const
+{
+    return this->lost.load();
+}
+
+// Метод для записи сообщения в буфер
+void Logger::write(LogLevel level, const char *func, const std::string &message)
+{
+    // Захват ячейки: её номер последовательности должен совпасть с позицией
+    uint64_t pos = this->write_pos.load(std::memory_order_relaxed);
+    Slot *slot;
+    for (;;)
+    {
+        slot = &this->slots[pos & (CAPACITY - 1)];
+        uint64_t sequence = slot->sequence.load(std::memory_order_acquire);
+        int64_t diff = static_cast<int64_t>(sequence - pos);
+        if (diff == 0)
+        {
+            if (this->write_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                break;
+        }
+        else if (diff < 0)
+        {
+            // Буфер заполнен - сообщение отбрасывается
+            this->lost.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        else
+            pos = this->write_pos.load(std::memory_order_relaxed);
+    }
+
+    slot->level = level;
+    slot->func = func;
+    slot->length = static_cast<uint32_t>(std::min(message.size(), MESSAGE_SIZE));
+    std::memcpy(slot->text, message.data(), slot->length);
+    if (message.size() > MESSAGE_SIZE)
+        std::memcpy(slot->text + MESSAGE_SIZE - 3, "...", 3);
+    slot->sequence.store(pos + 1, std::memory_order_release);
+}
+
+// Метод для вывода всех готовых сообщений
+bool Logger::drain()
+{
+    std::string out_text;
+    std::string err_text;
+    uint64_t pos = this->read_pos.load(std::memory_order_relaxed);
+    for (;;)
+    {
+        Slot &slot = this->slots[pos & (CAPACITY - 1)];
+        if (slot.sequence.load(std::memory_order_acquire) != pos + 1)
+            break;
+
+        std::string &text = slot.level >= LogLevel::WARN ? err_text : out_text;
+        text.append("Log: \"").append(slot.func).append("\"\n");
+        text.append(slot.text, slot.length).append("\n");
+
+        slot.sequence.store(pos + CAPACITY, std::memory_order_release);
+        ++pos;
+    }
+
+    uint64_t lost_now = this->lost.load(std::memory_order_relaxed);
+    if (lost_now != this->reported_lost)
+    {
+        err_text.append("Log: \"Logger\"\nDropped " + std::to_string(lost_now - this->reported_lost) +
+                        " messages (buffer full)\n");
+        this->reported_lost = lost_now;
+    }
+
+    FILE *out = this->out.load();
+    FILE *err = this->err.load();
+    if (!out_text.empty())
+    {
+        std::fwrite(out_text.data(), 1, out_text.size(), out);
+        std::fflush(out);
+    }
+    if (!err_text.empty())
+    {
+        std::fwrite(err_text.data(), 1, err_text.size(), err);
+        std::fflush(err);
+    }
+
+    bool progressed = pos != this->read_pos.load(std::memory_order_relaxed);
+    this->read_pos.store(pos, std::memory_order_release);
+    return progressed;
+}
+
+// Метод фонового потока вывода
+void Logger::run()
+{
+    while (!this->stopping.load())
+    {
+        if (!this->drain())
+            std::this_thread::sleep_for(IDLE_SLEEP);
+    }
+}
+
+// Метод для ожидания вывода всех записанных сообщений
+void Logger::flush()
+{
+    uint64_t target = this->write_pos.load();
+    while (this->read_pos.load(std::memory_order_acquire) < target)
+        std::this_thread::sleep_for(std::chrono::microseconds(100));
+}
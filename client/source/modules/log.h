@@ -0,0 +1,220 @@
+#ifndef LOGGER_H
+#define LOGGER_H
+
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+#include <cstdio>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include "errors.h"
+
+/**
+* @file log.h
+* @brief Определения асинхронного журнала с уровнями.
+* @details Сообщения помещаются в кольцевой буфер без блокировок (несколько
+* писателей, один читатель), фоновый поток сбрасывает их в stdout (DEBUG, INFO)
+* или stderr (WARN, ERROR). Если буфер заполнен, сообщение отбрасывается
+* и учитывается в счётчике потерянных, писатель никогда не ждёт.
+* Макросы LOG_* проверяют уровень до форматирования сообщения, поэтому
+* при отключённом уровне на горячем пути нет ни форматирования, ни выделений памяти.
+* @date 17.10.2026
+* @version 1.0
+* @authors Косов Р. С.
+* @copyright ИБСТ ПГУ
+*/
+
+/**
+* @brief Уровень сообщений журнала.
+*/
+enum class LogLevel : int
+{
+    DEBUG = 0, ///< Отладочные сообщения (выборки значений).
+    INFO = 1,  ///< Сводки о работе (по умолчанию).
+    WARN = 2,  ///< Предупреждения.
+    ERROR = 3, ///< Ошибки.
+    OFF = 4    ///< Журнал отключён.
+};
+
+/**
+* @brief Функция для разбора уровня журнала из строки.
+* @param name Название уровня: debug, info, warn, error или off.
+* @return Уровень журнала.
+* @throw ArgsDecodeError Если уровень не поддерживается.
+*/
+LogLevel parseLogLevel(const std::string &name);
+
+/**
+* @brief Класс асинхронного журнала.
+*/
+class Logger
+{
+public:
+    /// Количество ячеек кольцевого буфера (степень двойки).
+    static constexpr size_t CAPACITY = 1024;
+
+    /// Максимальная длина одного сообщения (длинные сообщения обрезаются).
+    static constexpr size_t MESSAGE_SIZE = 240;
+
+    /**
+    * @brief Метод для получения единственного экземпляра журнала.
+    * @details Фоновый поток запускается при первом обращении.
+    * @return Журнал.
+    */
+    static Logger &instance();
+
+    /**
+    * @brief Метод для проверки, записываются ли сообщения уровня.
+    * @param level Уровень сообщения.
+    * @return true, если уровень не ниже текущего.
+    */
+    static bool enabled(LogLevel level)
+    {
+        return static_cast<int>(level) >= current_level.load(std::memory_order_relaxed);
+    }
+
+    /**
+    * @brief Метод для установки уровня журнала.
+    * @param level Минимальный записываемый уровень.
+    */
+    static void setLevel(LogLevel level);
+
+    /**
+    * @brief Метод для получения уровня журнала.
+    * @return Минимальный записываемый уровень.
+    */
+    static LogLevel level();
+
+    /**
+    * @brief Метод для смены потоков вывода.
+    * @details Сначала сбрасывает уже записанные сообщения.
+    * @param out Поток для DEBUG и INFO.
+    * @param err Поток для WARN и ERROR.
+    */
+    void setOutput(FILE *out, FILE *err);
+
+    /**
+    * @brief Метод для записи сообщения в буфер.
+    * @param level Уровень сообщения.
+    * @param func Имя функции-источника (строковый литерал).
+    * @param message Текст сообщения.
+    */
+    void write(LogLevel level, const char *func, const std::string &message);
+
+    /**
+    * @brief Метод для ожидания вывода всех записанных сообщений.
+    */
+    void flush();
+
+    /**
+    * @brief Метод для получения количества отброшенных сообщений.
+    * @return Количество сообщений, не поместившихся в буфер.
+    */
+    uint64_t dropped() const;
+
+    Logger(const Logger &) = delete;
+    Logger &operator=(const Logger &) = delete;
+
+    /**
+    * @brief Деструктор класса Logger.
+    * @details Останавливает фоновый поток и выводит оставшиеся сообщения.
+    */
+    ~Logger();
+
+private:
+    /**
+    * @brief Ячейка кольцевого буфера.
+    */
+    struct Slot
+    {
+        std::atomic<uint64_t> sequence; ///< Номер позиции, для которой ячейка готова.
+        LogLevel level; ///< Уровень сообщения.
+        const char *func; ///< Имя функции-источника.
+        uint32_t length; ///< Длина текста.
+        char text[MESSAGE_SIZE]; ///< Текст сообщения.
+    };
+
+    static std::atomic<int> current_level; ///< Текущий уровень журнала.
+
+    std::unique_ptr<Slot[]> slots; ///< Кольцевой буфер.
+    alignas(64) std::atomic<uint64_t> write_pos; ///< Следующая позиция для записи.
+    alignas(64) std::atomic<uint64_t> read_pos; ///< Следующая позиция для вывода.
+    std::atomic<uint64_t> lost; ///< Количество отброшенных сообщений.
+    uint64_t reported_lost; ///< Количество отброшенных сообщений, о которых уже сообщено.
+    std::atomic<bool> stopping; ///< Флаг остановки фонового потока.
+    std::atomic<FILE *> out; ///< Поток для DEBUG и INFO.
+    std::atomic<FILE *> err; ///< Поток для WARN и ERROR.
+    std::thread flusher; ///< Фоновый поток вывода.
+
+    /**
+    * @brief Конструктор класса Logger.
+    */
+    Logger();
+
+    /**
+    * @brief Метод для вывода всех готовых сообщений.
+    * @return true, если было выведено хотя бы одно сообщение.
+    */
+    bool drain();
+
+    /**
+    * @brief Метод фонового потока вывода.
+    */
+    void run();
+};
+
+/**
+* @brief Макрос для записи сообщения с проверкой уровня до форматирования.
+* @param level Уровень сообщения.
+* @param func Имя функции-источника.
+* @param message Выражение для std::ostream (например, "count=" << n).
+*/
+#define LOG_AT(level, func, message)                                    \
+    do                                                                  \
+    {                                                                   \
+        if (Logger::enabled(level))                                     \
+        {                                                               \
+            std::ostringstream log_stream_;                             \
+            log_stream_ << message;                                     \
+            Logger::instance().write(level, func, log_stream_.str());   \
+        }                                                               \
+    } while (0)
+
+#define LOG_DEBUG(func, message) LOG_AT(LogLevel::DEBUG, func, message)
+#define LOG_INFO(func, message) LOG_AT(LogLevel::INFO, func, message)
+#define LOG_WARN(func, message) LOG_AT(LogLevel::WARN, func, message)
+#define LOG_ERROR(func, message) LOG_AT(LogLevel::ERROR, func, message)
+
+/**
+* @brief Функция для форматирования выборки первых значений.
+* @details Используется вместо вывода наборов данных целиком.
+* @tparam Iterator Тип итератора значений.
+* @param begin Начало значений.
+* @param end Конец значений.
+* @param limit Максимальное количество выводимых значений.
+* @return Строка вида "{1, 2, 3, ...}".
+*/
+template <typename Iterator>
+std::string logSample(Iterator begin, Iterator end, size_t limit)
+{
+    std::ostringstream sample;
+    sample << "{";
+    size_t k = 0;
+    for (Iterator it = begin; it != end; ++it, ++k)
+    {
+        if (k == limit)
+        {
+            sample << ", ...";
+            break;
+        }
+        if (k > 0)
+            sample << ", ";
+        sample << +*it;
+    }
+    sample << "}";
+    return sample.str();
+}
+
+#endif // LOGGER_H
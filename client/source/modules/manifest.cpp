@@ -0,0 +1,243 @@
+#include "manifest.h"
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include "log.h"
+#include "trace.h"
+#include <sstream>
+#include <thread>
+#include <sys/stat.h>
+
+// Функция для чтения манифеста
+std::vector<ManifestJob> readManifest(const std::string &path)
+{
+    std::ifstream manifest(path);
+    if (!manifest.is_open())
+    {
+        throw IOError("Failed to open manifest file \"" + path + "\"", "readManifest()");
+    }
+
+    std::vector<ManifestJob> jobs;
+    std::string line;
+    size_t line_number = 0;
+    while (std::getline(manifest, line))
+    {
+        ++line_number;
+        std::istringstream fields(line);
+        ManifestJob job;
+        if (!(fields >> job.input_path) || job.input_path[0] == '#')
+            continue;
+        if (!(fields >> job.output_path))
+        {
+            throw DataDecodeError(
+                "Missing output path in manifest line " + std::to_string(line_number),
+                "readManifest()");
+        }
+
+        // Размер входного файла используется для распределения заданий
+        struct stat st;
+        job.bytes = stat(job.input_path.c_str(), &st) == 0 ? st.st_size : 0;
+        jobs.push_back(job);
+    }
+    return jobs;
+}
+
+// Конструктор очередей с перехватом работы
+WorkStealingQueues::WorkStealingQueues(size_t workers)
+    : steal_count(0)
+{
+    for (size_t i = 0; i < std::max<size_t>(workers, 1); ++i)
+        this->lanes.emplace_back(new Lane());
+}
+
+// Метод для добавления задания в очередь потока
+void WorkStealingQueues::push(size_t worker, size_t job)
+{
+    Lane &lane = *this->lanes[worker % this->lanes.size()];
+    std::lock_guard<std::mutex> lock(lane.mutex);
+    lane.jobs.push_back(job);
+}
+
+// Метод для получения задания потоком
+bool WorkStealingQueues::pop(size_t worker, size_t &job)
+{
+    // Своя очередь - с начала
+    {
+        Lane &own = *this->lanes[worker % this->lanes.size()];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.jobs.empty())
+        {
+            job = own.jobs.front();
+            own.jobs.pop_front();
+            return true;
+        }
+    }
+
+    // Чужие очереди - с конца, начиная с соседней
+    for (size_t i = 1; i < this->lanes.size(); ++i)
+    {
+        Lane &victim = *this->lanes[(worker + i) % this->lanes.size()];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.jobs.empty())
+        {
+            job = victim.jobs.back();
+            victim.jobs.pop_back();
+            ++this->steal_count;
+            return true;
+        }
+    }
+    return false;
+}
+
+uint64_t WorkStealingQueues::steals() const
+{
+    return this->steal_count;
+}
+
+// Конструктор
+template <typename T>
+BasicManifestRunner<T>::BasicManifestRunner(
+    const std::string &config_path,
+    const std::string &address,
+    uint16_t port,
+    const std::array<std::string, 2> &credentials,
+    const std::vector<ManifestJob> &jobs,
+    size_t workers,
+    size_t memory_limit,
+    FileBackend backend,
+    size_t queue_depth,
+    ResultCache *cache,
+    bool dedup)
+    : config_path(config_path),
+      address(address),
+      port(port),
+      credentials(credentials),
+      jobs(jobs),
+      workers(workers > 0 ? workers : 1),
+      memory_limit(memory_limit),
+      backend(backend),
+      queue_depth(queue_depth),
+      cache(cache),
+      dedup(dedup) {}
+
+// Метод рабочего потока
+template <typename T>
+void BasicManifestRunner<T>::work(size_t worker, WorkStealingQueues &queues, std::atomic<size_t> &failed)
+{
+    if (Tracer::enabled())
+        Tracer::instance().nameThread("worker " + std::to_string(worker));
+
+    // Менеджеры и буфер порции живут всё время работы потока
+    IOManager io_man(this->config_path, "", "");
+    io_man.setBackend(this->backend, this->queue_depth);
+    NetworkManager session(this->address, this->port);
+    session.setCache(this->cache);
+    session.setDedup(this->dedup);
+    BasicVectorBatch<T> chunk;
+    bool connected = false;
+
+    size_t index;
+    while (queues.pop(worker, index))
+    {
+        const ManifestJob &job = this->jobs[index];
+        TraceSpan span("job", "ui");
+        io_man.setPaths(job.input_path, job.output_path);
+
+        for (int attempt = 0;; ++attempt)
+        {
+            try
+            {
+                BasicVectorReader<T> reader = io_man.reader<T>(this->memory_limit);
+                BasicResultWriter<T> writer = io_man.writer<T>(reader.count());
+
+                bool reused = connected;
+                bool received = false;
+                if (!connected)
+                {
+                    session.conn();
+                    session.auth(this->credentials[0], this->credentials[1]);
+                    connected = true;
+                }
+
+                try
+                {
+                    session.begin(reader.count());
+                    while (reader.next(chunk))
+                    {
+                        writer.append(session.exchange(chunk));
+                        received = true;
+                    }
+                }
+                catch (const NetworkError &)
+                {
+                    session.close();
+                    connected = false;
+
+                    // Сервер мог закрыть переиспользуемую сессию между заданиями - одна попытка с новой,
+                    // обрыв посреди задания не повторяется
+                    if (reused && !received && attempt == 0)
+                        continue;
+                    throw;
+                }
+                writer.close();
+            }
+            catch (const std::exception &e)
+            {
+                if (!connected)
+                    session.close();
+                ++failed;
+                LOG_ERROR("ManifestRunner.work()", "Error: job \"" << job.input_path << "\" -> \""
+                                                                    << job.output_path << "\": " << e.what());
+            }
+            break;
+        }
+    }
+
+    if (connected)
+        session.close();
+}
+
+// Метод для обработки всех заданий
+template <typename T>
+size_t BasicManifestRunner<T>::run()
+{
+    typedef std::chrono::steady_clock clock;
+    clock::time_point started = clock::now();
+
+    // Большие файлы распределяются первыми - каждый в наименее загруженную очередь
+    std::vector<size_t> order(this->jobs.size());
+    for (size_t i = 0; i < order.size(); ++i)
+        order[i] = i;
+    std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b)
+                     { return this->jobs[a].bytes > this->jobs[b].bytes; });
+
+    size_t num_workers = std::min(this->workers, std::max<size_t>(this->jobs.size(), 1));
+    WorkStealingQueues queues(num_workers);
+    std::vector<uint64_t> load(num_workers, 0);
+    for (size_t index : order)
+    {
+        size_t lightest = std::min_element(load.begin(), load.end()) - load.begin();
+        load[lightest] += this->jobs[index].bytes + 1;
+        queues.push(lightest, index);
+    }
+
+    std::atomic<size_t> failed(0);
+    std::vector<std::thread> threads;
+    for (size_t w = 0; w < num_workers; ++w)
+        threads.emplace_back(&BasicManifestRunner<T>::work, this, w, std::ref(queues), std::ref(failed));
+    for (auto &thread : threads)
+        thread.join();
+
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(clock::now() - started);
+    LOG_INFO("ManifestRunner.run()", "Jobs: total=" << this->jobs.size()
+                                                     << " failed=" << failed
+                                                     << " workers=" << num_workers
+                                                     << " steals=" << queues.steals()
+                                                     << " time=" << elapsed.count() << "ms");
+
+    return failed;
+}
+
+// Явное инстанцирование для поддерживаемых типов данных
+#define INSTANTIATE_MANIFEST(T) template class BasicManifestRunner<T>;
+FOR_EACH_DATA_TYPE(INSTANTIATE_MANIFEST)
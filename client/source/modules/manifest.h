@@ -0,0 +1,173 @@
+#ifndef MANIFEST_H
+#define MANIFEST_H
+
+#include <cstdint>
+#include <cstddef>
+#include <array>
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "io.h"
+#include "network.h"
+
+/**
+* @file manifest.h
+* @brief Определения классов для пакетной обработки файлов по манифесту.
+* @details Этот файл содержит определения разбора манифеста (строки "ВХОДНОЙ_ФАЙЛ
+* ВЫХОДНОЙ_ФАЙЛ"), очередей заданий с перехватом работы и класса, обрабатывающего
+* задания манифеста пулом рабочих потоков.
+* @date 17.10.2026
+* @version 1.0
+* @authors Косов Р. С.
+* @copyright ИБСТ ПГУ
+*/
+
+/**
+* @brief Задание манифеста.
+*/
+struct ManifestJob
+{
+    std::string input_path; ///< Путь к входному файлу.
+    std::string output_path; ///< Путь к выходному файлу.
+    uint64_t bytes; ///< Размер входного файла (0, если файл недоступен).
+};
+
+/**
+* @brief Функция для чтения манифеста.
+* @details Пустые строки и строки, начинающиеся с '#', пропускаются.
+* @param path Путь к файлу манифеста.
+* @return Задания манифеста.
+* @throw IOError Если не удалось открыть файл манифеста.
+* @throw DataDecodeError Если строка манифеста не содержит двух путей.
+*/
+std::vector<ManifestJob> readManifest(const std::string &path);
+
+/**
+* @brief Очереди заданий с перехватом работы.
+* @details У каждого рабочего потока своя очередь: владелец забирает задания
+* из её начала, а освободившийся поток перехватывает задания с конца чужих очередей.
+* Поэтому один долгий файл не задерживает остальные задания своей очереди.
+*/
+class WorkStealingQueues
+{
+public:
+    /**
+    * @brief Конструктор класса WorkStealingQueues.
+    * @param workers Количество рабочих потоков.
+    */
+    explicit WorkStealingQueues(size_t workers);
+
+    /**
+    * @brief Метод для добавления задания в очередь потока.
+    * @param worker Номер потока.
+    * @param job Номер задания.
+    */
+    void push(size_t worker, size_t job);
+
+    /**
+    * @brief Метод для получения задания потоком.
+    * @details Сначала берётся задание из своей очереди, затем перехватывается чужое.
+    * @param worker Номер потока.
+    * @param job Номер задания.
+    * @return false, если все очереди пусты.
+    */
+    bool pop(size_t worker, size_t &job);
+
+    /**
+    * @brief Метод для получения количества перехваченных заданий.
+    * @return Количество перехватов.
+    */
+    uint64_t steals() const;
+
+private:
+    /**
+    * @brief Очередь одного рабочего потока.
+    */
+    struct Lane
+    {
+        std::mutex mutex; ///< Мьютекс очереди.
+        std::deque<size_t> jobs; ///< Номера заданий.
+    };
+
+    std::vector<std::unique_ptr<Lane>> lanes; ///< Очереди потоков.
+    std::atomic<uint64_t> steal_count; ///< Количество перехватов.
+};
+
+/**
+* @brief Класс для обработки заданий манифеста пулом рабочих потоков.
+* @details Задания распределяются между очередями потоков по размеру входных файлов
+* (от больших к меньшим), дисбаланс выравнивается перехватом работы. Каждый поток
+* переиспользует свои менеджер ввода-вывода, сессию с сервером и буфер порции:
+* после каждого вычисления сервер снова ждёт количество векторов, поэтому задания
+* потока идут отдельными вычислениями в одной сессии. Если сервер закрыл сессию
+* между заданиями, задание повторяется один раз на новом подключении.
+* @tparam T Тип значений векторов.
+*/
+template <typename T>
+class BasicManifestRunner
+{
+public:
+    /**
+    * @brief Конструктор класса BasicManifestRunner.
+    * @param config_path Путь к файлу конфигурации.
+    * @param address Адрес сервера.
+    * @param port Порт сервера.
+    * @param credentials Логин и пароль.
+    * @param jobs Задания манифеста.
+    * @param workers Количество рабочих потоков.
+    * @param memory_limit Ограничение объёма одной порции векторов (в байтах).
+    * @param backend Способ чтения и записи файлов заданий.
+    * @param queue_depth Количество блоков в обработке для FileBackend::URING.
+    * @param cache Кеш результатов, общий для всех рабочих потоков (nullptr - без кеша).
+    * @param dedup Устранять ли повторы внутри порций.
+    */
+    BasicManifestRunner(
+        const std::string &config_path,
+        const std::string &address,
+        uint16_t port,
+        const std::array<std::string, 2> &credentials,
+        const std::vector<ManifestJob> &jobs,
+        size_t workers,
+        size_t memory_limit,
+        FileBackend backend = FileBackend::STREAM,
+        size_t queue_depth = 4,
+        ResultCache *cache = nullptr,
+        bool dedup = false);
+
+    /**
+    * @brief Метод для обработки всех заданий.
+    * @details Ошибка задания не останавливает остальные задания.
+    * @return Количество неудачных заданий.
+    */
+    size_t run();
+
+private:
+    std::string config_path; ///< Путь к файлу конфигурации.
+    std::string address; ///< Адрес сервера.
+    uint16_t port; ///< Порт сервера.
+    std::array<std::string, 2> credentials; ///< Логин и пароль.
+    std::vector<ManifestJob> jobs; ///< Задания манифеста.
+    size_t workers; ///< Количество рабочих потоков.
+    size_t memory_limit; ///< Ограничение объёма порции.
+    FileBackend backend; ///< Способ чтения и записи файлов заданий.
+    size_t queue_depth; ///< Количество блоков в обработке для FileBackend::URING.
+    ResultCache *cache; ///< Кеш результатов (nullptr - без кеша).
+    bool dedup; ///< Флаг устранения повторов внутри порций.
+
+
+    /**
+    * @brief Метод рабочего потока.
+    * @param worker Номер потока.
+    * @param queues Очереди заданий.
+    * @param failed Счётчик неудачных заданий.
+    */
+    void work(size_t worker, WorkStealingQueues &queues, std::atomic<size_t> &failed);
+};
+
+/// Обработка манифеста для векторов из значений uint32_t.
+typedef BasicManifestRunner<uint32_t> ManifestRunner;
+
+#endif // MANIFEST_H
@@ -0,0 +1,171 @@
+#include "mapped.h"
+#include "container.h"
+#include "text.h"
+#include "metrics.h"
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Конструктор
+template <typename T>
+BasicMappedInput<T>::BasicMappedInput(const std::string &path)
+    : fd(-1),
+      base(nullptr),
+      length(0),
+      position(sizeof(uint32_t)),
+      released(0),
+      num_vectors(0),
+      num_read(0)
+{
+    this->fd = ::open(path.c_str(), O_RDONLY);
+    if (this->fd < 0)
+    {
+        throw IOError("Failed to open input file for reading.", "MappedInput.MappedInput()");
+    }
+
+    struct stat st;
+    if (fstat(this->fd, &st) < 0)
+    {
+        ::close(this->fd);
+        throw IOError("Failed to get size of input file", "MappedInput.MappedInput()");
+    }
+    this->length = st.st_size;
+
+    if (this->length < sizeof(uint32_t))
+    {
+        ::close(this->fd);
+        throw DataDecodeError("Failed to read number of vectors", "MappedInput.MappedInput()");
+    }
+
+    void *mem = mmap(nullptr, this->length, PROT_READ, MAP_SHARED, this->fd, 0);
+    if (mem == MAP_FAILED)
+    {
+        ::close(this->fd);
+        throw IOError("Failed to map input file", "MappedInput.MappedInput()");
+    }
+    this->base = static_cast<const char *>(mem);
+
+    // Файл читается строго последовательно
+    madvise(mem, this->length, MADV_SEQUENTIAL);
+    madvise(mem, this->length, MADV_HUGEPAGE);
+
+    // Записи v2 не совпадают с форматом передачи по сети
+    if (this->length >= sizeof(CONTAINER_MAGIC) &&
+        std::memcmp(this->base, CONTAINER_MAGIC, sizeof(CONTAINER_MAGIC)) == 0)
+    {
+        munmap(mem, this->length);
+        this->base = nullptr;
+        ::close(this->fd);
+        throw DataDecodeError("Container (v2) input cannot be mapped, read it without --mmap",
+                              "MappedInput.MappedInput()");
+    }
+    if (isTextFile(path))
+    {
+        munmap(mem, this->length);
+        this->base = nullptr;
+        ::close(this->fd);
+        throw DataDecodeError("Text input cannot be mapped, read it without --mmap",
+                              "MappedInput.MappedInput()");
+    }
+
+    std::memcpy(&this->num_vectors, this->base, sizeof(this->num_vectors));
+}
+
+// Конструктор перемещения
+template <typename T>
+BasicMappedInput<T>::BasicMappedInput(BasicMappedInput &&other)
+    : fd(other.fd),
+      base(other.base),
+      length(other.length),
+      position(other.position),
+      released(other.released),
+      num_vectors(other.num_vectors),
+      num_read(other.num_read)
+{
+    other.fd = -1;
+    other.base = nullptr;
+    other.length = 0;
+}
+
+// Деструктор
+template <typename T>
+BasicMappedInput<T>::~BasicMappedInput()
+{
+    if (this->base != nullptr)
+        munmap(const_cast<char *>(this->base), this->length);
+    if (this->fd >= 0)
+        ::close(this->fd);
+}
+
+template <typename T>
+uint32_t BasicMappedInput<T>::count() const
+{
+    return this->num_vectors;
+}
+
+template <typename T>
+uint32_t BasicMappedInput<T>::remaining() const
+{
+    return this->num_vectors - this->num_read;
+}
+
+// Метод для получения очередной порции векторов
+template <typename T>
+bool BasicMappedInput<T>::next(size_t memory_limit, BasicMappedChunk<T> &chunk)
+{
+    PhaseTimer timer(Phase::READ);
+    // Освобождение страниц предыдущей порции, чтобы объём памяти оставался ограниченным
+    size_t page = sysconf(_SC_PAGESIZE);
+    size_t release_end = this->position / page * page;
+    if (release_end > this->released)
+    {
+        madvise(const_cast<char *>(this->base) + this->released,
+                release_end - this->released, MADV_DONTNEED);
+        this->released = release_end;
+    }
+
+    chunk.wire = this->base + this->position;
+    chunk.wire_bytes = 0;
+    chunk.views.clear();
+    size_t chunk_bytes = 0;
+
+    while (this->num_read < this->num_vectors)
+    {
+        // Проверка границ заголовка вектора
+        if (this->length - this->position < sizeof(uint32_t))
+        {
+            throw DataDecodeError("Unexpected end of input file", "MappedInput.next()");
+        }
+        uint32_t vector_size;
+        std::memcpy(&vector_size, this->base + this->position, sizeof(vector_size));
+
+        // Проверка границ значений вектора
+        size_t vector_bytes = static_cast<size_t>(vector_size) * sizeof(T);
+        if (this->length - this->position - sizeof(uint32_t) < vector_bytes)
+        {
+            throw DataDecodeError("Vector size exceeds input file length", "MappedInput.next()");
+        }
+
+        if (!chunk.views.empty() && chunk_bytes + vector_bytes > memory_limit)
+            break;
+
+        BasicVectorView<T> view;
+        view.data = reinterpret_cast<const T *>(this->base + this->position + sizeof(uint32_t));
+        view.size = vector_size;
+        chunk.views.push_back(view);
+
+        this->position += sizeof(uint32_t) + vector_bytes;
+        chunk.wire_bytes += sizeof(uint32_t) + vector_bytes;
+        chunk_bytes += vector_bytes;
+        ++this->num_read;
+    }
+
+    timer.stop(chunk.wire_bytes, chunk.views.size());
+    return !chunk.views.empty();
+}
+
+// Явное инстанцирование для поддерживаемых типов данных
+#define INSTANTIATE_MAPPED(T) template class BasicMappedInput<T>;
+FOR_EACH_DATA_TYPE(INSTANTIATE_MAPPED)
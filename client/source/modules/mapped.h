@@ -0,0 +1,107 @@
+#ifndef MAPPED_INPUT_H
+#define MAPPED_INPUT_H
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <vector>
+#include "batch.h"
+#include "errors.h"
+
+/**
+* @file mapped.h
+* @brief Определения классов для чтения входного файла через отображение в память.
+* @details Этот файл содержит определения классов для чтения бинарного входного файла
+* без копирования: векторы берутся прямо из отображённого файла.
+* @date 17.10.2026
+* @version 1.0
+* @authors Косов Р. С.
+* @copyright ИБСТ ПГУ
+*/
+
+/**
+* @brief Порция векторов, указывающая прямо в отображённый файл.
+* @details Формат записей файла (размер | значения) совпадает с форматом передачи
+* по сети, поэтому порция отправляется серверу без промежуточных буферов.
+* Значения 64-битных типов в отображённом файле могут быть не выровнены
+* (заголовки векторов 4-байтовые).
+* @tparam T Тип значений векторов.
+*/
+template <typename T>
+struct BasicMappedChunk
+{
+    const char *wire; ///< Начало записей порции в отображённом файле.
+    size_t wire_bytes; ///< Объём записей порции в байтах.
+    std::vector<BasicVectorView<T>> views; ///< Представления векторов порции.
+};
+
+/**
+* @brief Класс для чтения бинарного входного файла через mmap.
+* @tparam T Тип значений векторов.
+*/
+template <typename T>
+class BasicMappedInput
+{
+public:
+    /**
+    * @brief Конструктор класса BasicMappedInput.
+    * @param path Путь к входному файлу.
+    * @throw IOError Если не удалось открыть или отобразить входной файл.
+    * @throw DataDecodeError Если файл слишком мал для заголовка.
+    */
+    explicit BasicMappedInput(const std::string &path);
+
+    /**
+    * @brief Конструктор перемещения.
+    * @param other Перемещаемый объект.
+    */
+    BasicMappedInput(BasicMappedInput &&other);
+
+    BasicMappedInput(const BasicMappedInput &) = delete;
+    BasicMappedInput &operator=(const BasicMappedInput &) = delete;
+
+    /**
+    * @brief Деструктор класса BasicMappedInput.
+    */
+    ~BasicMappedInput();
+
+    /**
+    * @brief Метод для получения общего количества векторов.
+    * @return Количество векторов.
+    */
+    uint32_t count() const;
+
+    /**
+    * @brief Метод для получения количества ещё не прочитанных векторов.
+    * @return Количество оставшихся векторов.
+    */
+    uint32_t remaining() const;
+
+    /**
+    * @brief Метод для получения очередной порции векторов.
+    * @details Страницы предыдущей порции освобождаются, её представления
+    * становятся недействительными.
+    * @param memory_limit Ограничение объёма значений в порции (в байтах).
+    * @param chunk Порция векторов.
+    * @return false, если все векторы уже прочитаны.
+    * @throw DataDecodeError Если размер вектора выходит за границы файла.
+    */
+    bool next(size_t memory_limit, BasicMappedChunk<T> &chunk);
+
+private:
+    int fd; ///< Дескриптор входного файла.
+    const char *base; ///< Начало отображения.
+    size_t length; ///< Длина файла в байтах.
+    size_t position; ///< Смещение очередной записи.
+    size_t released; ///< Смещение, до которого страницы освобождены.
+    uint32_t num_vectors; ///< Общее количество векторов.
+    uint32_t num_read; ///< Количество прочитанных векторов.
+};
+
+/// Порция векторов из значений uint32_t в отображённом файле.
+typedef BasicMappedChunk<uint32_t> MappedChunk;
+
+/// Чтение векторов из значений uint32_t через mmap.
+typedef BasicMappedInput<uint32_t> MappedInput;
+
+#endif // MAPPED_INPUT_H
@@ -0,0 +1,337 @@
+#include "metrics.h"
+#include "log.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+std::atomic<bool> Metrics::active(false);
+
+// Перцентили, выгружаемые в файлы
+static const double QUANTILES[] = {0.5, 0.9, 0.99, 0.999};
+static const char *const QUANTILE_NAMES[] = {"p50", "p90", "p99", "p999"};
+
+// Функция для получения названия фазы
+const char *phaseName(Phase phase)
+{
+    static const char *const names[] = {"conf", "conn", "auth", "read", "calc_send", "calc_recv", "write", "compute"};
+    return names[static_cast<int>(phase)];
+}
+
+// Функция для получения категории фазы на временной шкале
+const char *phaseCategory(Phase phase)
+{
+    if (phase == Phase::COMPUTE)
+        return "cpu";
+    return phase == Phase::CONF || phase == Phase::READ || phase == Phase::WRITE ? "io" : "net";
+}
+
+// Конструктор гистограммы
+LatencyHistogram::LatencyHistogram()
+{
+    this->reset();
+}
+
+// Метод для получения номера интервала значения
+size_t LatencyHistogram::bucketOf(uint64_t value)
+{
+    // Значения меньше 2 * SUB_BUCKETS хранятся точно
+    if (value < 2 * SUB_BUCKETS)
+        return value;
+    unsigned exponent = 63 - __builtin_clzll(value);
+    unsigned shift = exponent - 5;
+    return SUB_BUCKETS * shift + (value >> shift);
+}
+
+// Метод для получения верхней границы интервала
+uint64_t LatencyHistogram::bucketUpper(size_t bucket)
+{
+    if (bucket < 2 * SUB_BUCKETS)
+        return bucket;
+    unsigned shift = bucket / SUB_BUCKETS - 1;
+    uint64_t top = bucket % SUB_BUCKETS + SUB_BUCKETS;
+    return ((top + 1) << shift) - 1;
+}
+
+// Метод для добавления значения
+void LatencyHistogram::record(uint64_t value)
+{
+    this->buckets[bucketOf(value)].fetch_add(1, std::memory_order_relaxed);
+    this->total.fetch_add(1, std::memory_order_relaxed);
+    this->total_sum.fetch_add(value, std::memory_order_relaxed);
+
+    uint64_t current = this->minimum.load(std::memory_order_relaxed);
+    while (value < current && !this->minimum.compare_exchange_weak(current, value, std::memory_order_relaxed))
+        ;
+    current = this->maximum.load(std::memory_order_relaxed);
+    while (value > current && !this->maximum.compare_exchange_weak(current, value, std::memory_order_relaxed))
+        ;
+}
+
+// Метод для сброса гистограммы
+void LatencyHistogram::reset()
+{
+    for (size_t i = 0; i < BUCKETS; ++i)
+        this->buckets[i].store(0, std::memory_order_relaxed);
+    this->total.store(0, std::memory_order_relaxed);
+    this->total_sum.store(0, std::memory_order_relaxed);
+    this->minimum.store(UINT64_MAX, std::memory_order_relaxed);
+    this->maximum.store(0, std::memory_order_relaxed);
+}
+
+uint64_t LatencyHistogram::count() const
+{
+    return this->total.load(std::memory_order_relaxed);
+}
+
+uint64_t LatencyHistogram::sum() const
+{
+    return this->total_sum.load(std::memory_order_relaxed);
+}
+
+uint64_t LatencyHistogram::min() const
+{
+    uint64_t value = this->minimum.load(std::memory_order_relaxed);
+    return value == UINT64_MAX ? 0 : value;
+}
+
+uint64_t LatencyHistogram::max() const
+{
+    return this->maximum.load(std::memory_order_relaxed);
+}
+
+// Метод для получения перцентиля
+uint64_t LatencyHistogram::percentile(double quantile) const
+{
+    uint64_t n = this->count();
+    if (n == 0)
+        return 0;
+    if (quantile <= 0)
+        return this->min();
+
+    uint64_t rank = static_cast<uint64_t>(std::ceil(quantile * n));
+    rank = std::max<uint64_t>(1, std::min(rank, n));
+    uint64_t seen = 0;
+    for (size_t i = 0; i < BUCKETS; ++i)
+    {
+        seen += this->buckets[i].load(std::memory_order_relaxed);
+        if (seen >= rank)
+            return std::min(bucketUpper(i), this->max());
+    }
+    return this->max();
+}
+
+// Конструктор метрик
+Metrics::Metrics()
+{
+    this->reset();
+}
+
+Metrics &Metrics::instance()
+{
+    static Metrics metrics;
+    return metrics;
+}
+
+void Metrics::enable(bool on)
+{
+    active.store(on, std::memory_order_relaxed);
+}
+
+// Метод для учёта одного выполнения фазы
+void Metrics::record(Phase phase, uint64_t nanos, uint64_t bytes, uint64_t vectors)
+{
+    int k = static_cast<int>(phase);
+    this->phases[k].record(nanos);
+    this->phase_bytes[k].fetch_add(bytes, std::memory_order_relaxed);
+    this->phase_vectors[k].fetch_add(vectors, std::memory_order_relaxed);
+}
+
+const LatencyHistogram &Metrics::histogram(Phase phase) const
+{
+    return this->phases[static_cast<int>(phase)];
+}
+
+uint64_t Metrics::bytes(Phase phase) const
+{
+    return this->phase_bytes[static_cast<int>(phase)].load(std::memory_order_relaxed);
+}
+
+uint64_t Metrics::vectors(Phase phase) const
+{
+    return this->phase_vectors[static_cast<int>(phase)].load(std::memory_order_relaxed);
+}
+
+LatencyHistogram &Metrics::rtt()
+{
+    return this->vector_rtt;
+}
+
+// Метод для сброса всех метрик
+void Metrics::reset()
+{
+    for (int k = 0; k < static_cast<int>(Phase::COUNT); ++k)
+    {
+        this->phases[k].reset();
+        this->phase_bytes[k].store(0, std::memory_order_relaxed);
+        this->phase_vectors[k].store(0, std::memory_order_relaxed);
+    }
+    this->vector_rtt.reset();
+    this->started.store(monotonicNanos(), std::memory_order_relaxed);
+}
+
+// Функция для записи гистограммы в JSON
+static void histogramJson(std::ostringstream &out, const LatencyHistogram &hist)
+{
+    out << "{\"count\": " << hist.count()
+        << ", \"sum\": " << hist.sum()
+        << ", \"min\": " << hist.min();
+    for (size_t q = 0; q < sizeof(QUANTILES) / sizeof(QUANTILES[0]); ++q)
+        out << ", \"" << QUANTILE_NAMES[q] << "\": " << hist.percentile(QUANTILES[q]);
+    out << ", \"max\": " << hist.max() << "}";
+}
+
+// Метод для формирования снимка метрик в формате JSON
+std::string Metrics::toJson() const
+{
+    std::ostringstream out;
+    out << "{\n  \"uptime_ns\": " << monotonicNanos() - this->started.load(std::memory_order_relaxed)
+        << ",\n  \"phases\": {\n";
+    for (int k = 0; k < static_cast<int>(Phase::COUNT); ++k)
+    {
+        Phase phase = static_cast<Phase>(k);
+        out << "    \"" << phaseName(phase) << "\": {\"bytes\": " << this->bytes(phase)
+            << ", \"vectors\": " << this->vectors(phase) << ", \"latency_ns\": ";
+        histogramJson(out, this->phases[k]);
+        out << "}" << (k + 1 < static_cast<int>(Phase::COUNT) ? ",\n" : "\n");
+    }
+    out << "  },\n  \"vector_rtt_ns\": ";
+    histogramJson(out, this->vector_rtt);
+    out << "\n}\n";
+    return out.str();
+}
+
+// Функция для записи гистограммы как summary Prometheus
+static void histogramPrometheus(std::ostringstream &out, const std::string &name,
+                                const std::string &labels, const LatencyHistogram &hist)
+{
+    std::string prefix = labels.empty() ? "{" : "{" + labels + ",";
+    for (size_t q = 0; q < sizeof(QUANTILES) / sizeof(QUANTILES[0]); ++q)
+        out << name << prefix << "quantile=\"" << QUANTILES[q] << "\"} "
+            << hist.percentile(QUANTILES[q]) * 1e-9 << "\n";
+    std::string suffix = labels.empty() ? "" : "{" + labels + "}";
+    out << name << "_sum" << suffix << " " << hist.sum() * 1e-9 << "\n";
+    out << name << "_count" << suffix << " " << hist.count() << "\n";
+}
+
+// Метод для формирования снимка метрик в текстовом формате Prometheus
+std::string Metrics::toPrometheus() const
+{
+    std::ostringstream out;
+    out << "# HELP vclient_phase_seconds Duration of one execution of a client phase.\n"
+        << "# TYPE vclient_phase_seconds summary\n";
+    for (int k = 0; k < static_cast<int>(Phase::COUNT); ++k)
+        histogramPrometheus(out, "vclient_phase_seconds",
+                            std::string("phase=\"") + phaseName(static_cast<Phase>(k)) + "\"", this->phases[k]);
+
+    out << "# HELP vclient_phase_bytes_total Bytes processed by a client phase.\n"
+        << "# TYPE vclient_phase_bytes_total counter\n";
+    for (int k = 0; k < static_cast<int>(Phase::COUNT); ++k)
+        out << "vclient_phase_bytes_total{phase=\"" << phaseName(static_cast<Phase>(k)) << "\"} "
+            << this->bytes(static_cast<Phase>(k)) << "\n";
+
+    out << "# HELP vclient_phase_vectors_total Vectors processed by a client phase.\n"
+        << "# TYPE vclient_phase_vectors_total counter\n";
+    for (int k = 0; k < static_cast<int>(Phase::COUNT); ++k)
+        out << "vclient_phase_vectors_total{phase=\"" << phaseName(static_cast<Phase>(k)) << "\"} "
+            << this->vectors(static_cast<Phase>(k)) << "\n";
+
+    out << "# HELP vclient_vector_rtt_seconds Time from sending a vector to receiving its result.\n"
+        << "# TYPE vclient_vector_rtt_seconds summary\n";
+    histogramPrometheus(out, "vclient_vector_rtt_seconds", "", this->vector_rtt);
+    return out.str();
+}
+
+// Метод для атомарной записи снимка в файл
+void Metrics::writeFile(const std::string &path, const std::string &text)
+{
+    std::string temp_path = path + ".tmp";
+    std::ofstream output_file(temp_path, std::ios::binary | std::ios::trunc);
+    output_file << text;
+    output_file.close();
+    if (!output_file || std::rename(temp_path.c_str(), path.c_str()) != 0)
+    {
+        std::remove(temp_path.c_str());
+        throw IOError("Failed to write metrics file \"" + path + "\"", "Metrics.writeFile()");
+    }
+}
+
+// Конструктор выгрузки метрик
+MetricsExporter::MetricsExporter(const std::string &json_path, const std::string &prometheus_path, unsigned interval)
+    : json_path(json_path),
+      prometheus_path(prometheus_path),
+      interval(interval),
+      stopping(false)
+{
+    if (this->json_path.empty() && this->prometheus_path.empty())
+        return;
+
+    Metrics::instance().reset();
+    Metrics::enable(true);
+    if (this->interval > 0)
+    {
+        this->worker = std::thread([this]
+                                   {
+            std::unique_lock<std::mutex> lock(this->mutex);
+            while (!this->wake.wait_for(lock, std::chrono::seconds(this->interval), [this]
+                                        { return this->stopping; }))
+            {
+                try
+                {
+                    this->write();
+                }
+                catch (const IOError &e)
+                {
+                    LOG_WARN("MetricsExporter.run()", e.what());
+                }
+            } });
+    }
+}
+
+// Деструктор выгрузки метрик
+MetricsExporter::~MetricsExporter()
+{
+    if (this->json_path.empty() && this->prometheus_path.empty())
+        return;
+
+    if (this->worker.joinable())
+    {
+        {
+            std::lock_guard<std::mutex> lock(this->mutex);
+            this->stopping = true;
+        }
+        this->wake.notify_all();
+        this->worker.join();
+    }
+
+    // Последний снимок записывается и при завершении с ошибкой
+    try
+    {
+        this->write();
+    }
+    catch (const IOError &e)
+    {
+        LOG_ERROR("MetricsExporter.~MetricsExporter()", e.what());
+    }
+    Metrics::enable(false);
+}
+
+// Метод для записи снимка метрик во все заданные файлы
+void MetricsExporter::write()
+{
+    if (!this->json_path.empty())
+        Metrics::writeFile(this->json_path, Metrics::instance().toJson());
+    if (!this->prometheus_path.empty())
+        Metrics::writeFile(this->prometheus_path, Metrics::instance().toPrometheus());
+}
@@ -0,0 +1,340 @@
+#ifndef METRICS_H
+#define METRICS_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstddef>
+#include <mutex>
+#include <string>
+#include <thread>
+#include "errors.h"
+#include "trace.h"
+
+/**
+* @file metrics.h
+* @brief Определения классов для сбора метрик по фазам работы клиента.
+* @details Для каждой фазы (чтение конфигурации, подключение, аутентификация,
+* чтение входного файла, отправка, приём, запись результатов) накапливаются
+* суммарное время, количество байтов и векторов и гистограмма длительностей.
+* Отдельно собирается гистограмма времени оборота каждого вектора: от момента,
+* когда его байты переданы ядру, до приёма его результата.
+* Гистограммы устроены как HDR: значения в наносекундах раскладываются
+* по степеням двойки, каждая степень делится на 32 линейных интервала, поэтому
+* относительная погрешность не превышает 1/32. Все счётчики атомарные, запись
+* из нескольких потоков не требует блокировок. Таймеры фаз также записывают
+* интервалы на временную шкалу (trace.h), если она включена. Пока не включены
+* ни метрики, ни шкала, таймеры фаз не читают часы.
+* @date 17.10.2026
+* @version 1.0
+* @authors Косов Р. С.
+* @copyright ИБСТ ПГУ
+*/
+
+/**
+* @brief Фаза работы клиента.
+*/
+enum class Phase : int
+{
+    CONF = 0,  ///< Чтение конфигурации.
+    CONN,      ///< Подключение к серверу.
+    AUTH,      ///< Аутентификация.
+    READ,      ///< Чтение порции входного файла.
+    CALC_SEND, ///< Отправка порции векторов.
+    CALC_RECV, ///< Ожидание и приём результатов.
+    WRITE,     ///< Запись порции результатов.
+    COMPUTE,   ///< Локальное вычисление результатов.
+    COUNT      ///< Количество фаз.
+};
+
+/**
+* @brief Функция для получения названия фазы.
+* @param phase Фаза.
+* @return Название фазы (conf, conn, auth, read, calc_send, calc_recv, write).
+*/
+const char *phaseName(Phase phase);
+
+/**
+* @brief Функция для получения категории фазы на временной шкале.
+* @param phase Фаза.
+* @return io для работы с файлами, net для работы с сервером.
+*/
+const char *phaseCategory(Phase phase);
+
+/**
+* @brief Класс гистограммы длительностей с логарифмически-линейными интервалами.
+*/
+class LatencyHistogram
+{
+public:
+    /// Количество линейных интервалов на степень двойки.
+    static const unsigned SUB_BUCKETS = 32;
+
+    /// Общее количество интервалов (для значений до 2^64 - 1).
+    static const size_t BUCKETS = SUB_BUCKETS * 60;
+
+    /**
+    * @brief Конструктор класса LatencyHistogram.
+    */
+    LatencyHistogram();
+
+    LatencyHistogram(const LatencyHistogram &) = delete;
+    LatencyHistogram &operator=(const LatencyHistogram &) = delete;
+
+    /**
+    * @brief Метод для добавления значения.
+    * @param value Длительность в наносекундах.
+    */
+    void record(uint64_t value);
+
+    /**
+    * @brief Метод для сброса гистограммы.
+    */
+    void reset();
+
+    /**
+    * @brief Метод для получения количества значений.
+    * @return Количество значений.
+    */
+    uint64_t count() const;
+
+    /**
+    * @brief Метод для получения суммы значений.
+    * @return Сумма в наносекундах.
+    */
+    uint64_t sum() const;
+
+    /**
+    * @brief Метод для получения минимального значения.
+    * @return Минимум (0, если значений нет).
+    */
+    uint64_t min() const;
+
+    /**
+    * @brief Метод для получения максимального значения.
+    * @return Максимум (0, если значений нет).
+    */
+    uint64_t max() const;
+
+    /**
+    * @brief Метод для получения перцентиля.
+    * @param quantile Доля значений от 0 до 1.
+    * @return Верхняя граница интервала, в который попадает перцентиль (не больше максимума).
+    */
+    uint64_t percentile(double quantile) const;
+
+    /**
+    * @brief Метод для получения номера интервала значения.
+    * @param value Значение.
+    * @return Номер интервала.
+    */
+    static size_t bucketOf(uint64_t value);
+
+    /**
+    * @brief Метод для получения верхней границы интервала.
+    * @param bucket Номер интервала.
+    * @return Наибольшее значение, попадающее в интервал.
+    */
+    static uint64_t bucketUpper(size_t bucket);
+
+private:
+    std::atomic<uint64_t> buckets[BUCKETS]; ///< Счётчики интервалов.
+    std::atomic<uint64_t> total; ///< Количество значений.
+    std::atomic<uint64_t> total_sum; ///< Сумма значений.
+    std::atomic<uint64_t> minimum; ///< Минимальное значение.
+    std::atomic<uint64_t> maximum; ///< Максимальное значение.
+};
+
+/**
+* @brief Класс для накопления метрик клиента.
+*/
+class Metrics
+{
+public:
+    /**
+    * @brief Метод для получения единственного экземпляра.
+    * @return Метрики клиента.
+    */
+    static Metrics &instance();
+
+    /**
+    * @brief Метод для проверки, включён ли сбор метрик.
+    * @return true, если метрики собираются.
+    */
+    static bool enabled()
+    {
+        return active.load(std::memory_order_relaxed);
+    }
+
+    /**
+    * @brief Метод для включения или отключения сбора метрик.
+    * @param on Включить ли сбор.
+    */
+    static void enable(bool on);
+
+    /**
+    * @brief Метод для учёта одного выполнения фазы.
+    * @param phase Фаза.
+    * @param nanos Длительность в наносекундах.
+    * @param bytes Количество обработанных байтов.
+    * @param vectors Количество обработанных векторов.
+    */
+    void record(Phase phase, uint64_t nanos, uint64_t bytes, uint64_t vectors);
+
+    /**
+    * @brief Метод для получения гистограммы длительностей фазы.
+    * @param phase Фаза.
+    * @return Гистограмма.
+    */
+    const LatencyHistogram &histogram(Phase phase) const;
+
+    /**
+    * @brief Метод для получения количества байтов фазы.
+    * @param phase Фаза.
+    * @return Количество байтов.
+    */
+    uint64_t bytes(Phase phase) const;
+
+    /**
+    * @brief Метод для получения количества векторов фазы.
+    * @param phase Фаза.
+    * @return Количество векторов.
+    */
+    uint64_t vectors(Phase phase) const;
+
+    /**
+    * @brief Метод для получения гистограммы времени оборота векторов.
+    * @return Гистограмма.
+    */
+    LatencyHistogram &rtt();
+
+    /**
+    * @brief Метод для сброса всех метрик.
+    */
+    void reset();
+
+    /**
+    * @brief Метод для формирования снимка метрик в формате JSON.
+    * @return Текст JSON.
+    */
+    std::string toJson() const;
+
+    /**
+    * @brief Метод для формирования снимка метрик в текстовом формате Prometheus.
+    * @return Текст для textfile collector.
+    */
+    std::string toPrometheus() const;
+
+    /**
+    * @brief Метод для атомарной записи снимка в файл (через временный файл и rename).
+    * @param path Путь к файлу.
+    * @param text Содержимое файла.
+    * @throw IOError Если не удалось записать файл.
+    */
+    static void writeFile(const std::string &path, const std::string &text);
+
+private:
+    static std::atomic<bool> active; ///< Флаг сбора метрик.
+
+    LatencyHistogram phases[static_cast<int>(Phase::COUNT)]; ///< Гистограммы фаз.
+    std::atomic<uint64_t> phase_bytes[static_cast<int>(Phase::COUNT)]; ///< Байты по фазам.
+    std::atomic<uint64_t> phase_vectors[static_cast<int>(Phase::COUNT)]; ///< Векторы по фазам.
+    LatencyHistogram vector_rtt; ///< Время оборота векторов.
+    std::atomic<uint64_t> started; ///< Время начала сбора.
+
+    /**
+    * @brief Конструктор класса Metrics.
+    */
+    Metrics();
+};
+
+/**
+* @brief Класс таймера одного выполнения фазы.
+* @details Выполнение учитывается в метриках и записывается интервалом
+* на временную шкалу. Если ни то, ни другое не включено, часы не читаются.
+*/
+class PhaseTimer
+{
+public:
+    /**
+    * @brief Конструктор класса PhaseTimer.
+    * @param phase Измеряемая фаза.
+    */
+    explicit PhaseTimer(Phase phase)
+        : phase(phase),
+          running(Metrics::enabled() || Tracer::enabled()),
+          started(running ? monotonicNanos() : 0) {}
+
+    /**
+    * @brief Метод для завершения измерения.
+    * @details Повторный вызов ничего не делает; если stop() не вызван
+    * (например, при исключении), фаза не учитывается.
+    * @param bytes Количество обработанных байтов.
+    * @param vectors Количество обработанных векторов.
+    */
+    void stop(uint64_t bytes = 0, uint64_t vectors = 0)
+    {
+        if (this->running)
+        {
+            uint64_t finished = monotonicNanos();
+            if (Metrics::enabled())
+                Metrics::instance().record(this->phase, finished - this->started, bytes, vectors);
+            if (Tracer::enabled())
+            {
+                Tracer::instance().record(phaseName(this->phase), phaseCategory(this->phase),
+                                          this->started, finished, bytes, vectors);
+            }
+            this->running = false;
+        }
+    }
+
+private:
+    Phase phase; ///< Измеряемая фаза.
+    bool running; ///< Флаг незавершённого измерения.
+    uint64_t started; ///< Время начала измерения.
+};
+
+/**
+* @brief Класс для выгрузки метрик в файлы.
+* @details Включает сбор метрик, если задан хотя бы один путь. При положительном
+* интервале снимки записываются периодически фоновым потоком, последний снимок
+* записывается при уничтожении объекта.
+*/
+class MetricsExporter
+{
+public:
+    /**
+    * @brief Конструктор класса MetricsExporter.
+    * @param json_path Путь к файлу JSON (пустой - не выгружать).
+    * @param prometheus_path Путь к файлу Prometheus (пустой - не выгружать).
+    * @param interval Интервал периодической выгрузки в секундах (0 - только при завершении).
+    */
+    MetricsExporter(const std::string &json_path, const std::string &prometheus_path, unsigned interval);
+
+    MetricsExporter(const MetricsExporter &) = delete;
+    MetricsExporter &operator=(const MetricsExporter &) = delete;
+
+    /**
+    * @brief Деструктор класса MetricsExporter.
+    * @details Останавливает фоновый поток и записывает последний снимок.
+    */
+    ~MetricsExporter();
+
+    /**
+    * @brief Метод для записи снимка метрик во все заданные файлы.
+    * @throw IOError Если не удалось записать файл.
+    */
+    void write();
+
+private:
+    std::string json_path; ///< Путь к файлу JSON.
+    std::string prometheus_path; ///< Путь к файлу Prometheus.
+    unsigned interval; ///< Интервал выгрузки в секундах.
+    bool stopping; ///< Флаг остановки фонового потока.
+    std::mutex mutex; ///< Мьютекс флага остановки.
+    std::condition_variable wake; ///< Условная переменная остановки.
+    std::thread worker; ///< Поток периодической выгрузки.
+};
+
+#endif // METRICS_H
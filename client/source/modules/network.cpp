@@ -1,5 +1,6 @@
 #include "network.h"
 #include <cstring>
+#include <memory>
 #include <stdexcept>
 #include <sys/types.h>
 #include <sys/socket.h>
@@ -7,11 +8,14 @@
 #include <unistd.h>
 #include "crypt.h"
 #include "errors.h"
-#include <iostream>
+#include "log.h"
+#include "metrics.h"
+#include "trace.h"
 
 // Конструктор
 NetworkManager::NetworkManager(const std::string &address, uint16_t port)
-    : address(address), port(port), socket(-1) {}
+    : socket(-1), address(address), port(port), cache(nullptr), dedup(false), dedup_counters(),
+      verifier(nullptr), verify_position(0) {}
 
 std::string &NetworkManager::getAddress()
 {
@@ -24,6 +28,7 @@ uint16_t &NetworkManager::getPort()
 // Метод для установки соединения
 void NetworkManager::conn()
 {
+    PhaseTimer timer(Phase::CONN);
     this->socket = ::socket(AF_INET, SOCK_STREAM, 0);
     if (this->socket < 0)
     {
@@ -40,82 +45,389 @@ void NetworkManager::conn()
 
     if (connect(this->socket, (struct sockaddr *)&server_addr, sizeof(server_addr)) < 0)
         throw NetworkError("Connection failed", "NetworkManager.conn()");
+
+    this->codec.attach(this->socket);
+    timer.stop();
 }
 
 // Метод для аутентификации
 void NetworkManager::auth(const std::string &login, const std::string &password)
 {
-    std::string salt = CryptManager::get_salt();
-    std::string hash = CryptManager::get_hash(salt, password);
+    SaltHash token;
+    {
+        // Модуль криптографии собирается и в сервер, поэтому интервал отмечается здесь
+        TraceSpan span("hash_batch", "crypto");
+        CryptManager::get_batch(password, &token, 1);
+    }
+    this->auth(login, token);
+}
 
-    std::string auth_message = login + salt + hash;
-    if (send(this->socket, auth_message.c_str(), auth_message.size(), 0) < 0)
+// Метод для аутентификации с заранее вычисленными солью и хешем
+void NetworkManager::auth(const std::string &login, const SaltHash &token)
+{
+    PhaseTimer timer(Phase::AUTH);
+    std::string auth_message;
+    auth_message.reserve(login.size() + SALT_HEX_LENGTH + HASH_HEX_LENGTH);
+    auth_message.append(login);
+    auth_message.append(token.salt, SALT_HEX_LENGTH);
+    auth_message.append(token.hash, HASH_HEX_LENGTH);
+    if (::send(this->socket, auth_message.c_str(), auth_message.size(), MSG_NOSIGNAL) < 0)
         throw AuthError("Failed to send auth message", "NetworkManager.auth()");
 
     char response[1024];
-    int response_length = recv(this->socket, response, sizeof(response) - 1, 0);
+    int response_length = ::recv(this->socket, response, sizeof(response) - 1, 0);
     if (response_length < 0)
     {
         throw AuthError("Failed to receive auth response", "NetworkManager.auth()");
     }
 
+    // Сервер, закрывший соединение вместо ответа, аутентификацию не подтвердил
+    if (response_length == 0)
+    {
+        throw AuthError("Connection closed during authentication", "NetworkManager.auth()");
+    }
+
     response[response_length] = '\0';
     if (std::string(response) == "ERR")
     {
         throw AuthError("Authentication failed", "NetworkManager.auth()");
     }
+    timer.stop();
 }
 
 // Метод для передачи данных и получения результата
-std::vector<uint32_t> NetworkManager::calc(const std::vector<std::vector<uint32_t>> &data)
+template <typename T>
+std::vector<T> NetworkManager::calc(const BasicVectorBatch<T> &data)
+{
+    this->begin(data.size());
+    std::vector<T> results = this->exchange(data);
+
+    // Сводка вместо полного вывода, выборка результатов - на уровне DEBUG
+    LOG_INFO("NetworkManager.calc()", "Results: count=" << results.size());
+    LOG_DEBUG("NetworkManager.calc()", "Results: " << logSample(results.begin(), results.end(), 16));
+
+    return results;
+}
+
+// Метод для начала потоковой передачи данных
+void NetworkManager::begin(uint32_t num_vectors)
 {
-    // Передача количества векторов
-    uint32_t num_vectors = data.size();
-    if (send(this->socket, &num_vectors, sizeof(num_vectors), 0) < 0)
+    // С кешем или устранением повторов количество векторов отправляется перед каждой порцией
+    if (this->filtered())
     {
-        throw NetworkError("Failed to send number of vectors", "NetworkManager.calc()");
+        this->beginRounds();
+        return;
     }
+    this->dedup_counters = DedupStats();
+    this->verify_position = 0;
+    this->verify_pending.clear();
+    this->codec.begin(num_vectors);
+}
+
+// Метод для начала передачи отдельными раундами
+void NetworkManager::beginRounds()
+{
+    this->dedup_counters = DedupStats();
+    this->codec.reset();
+    this->rounds.clear();
+    this->verify_position = 0;
+    this->verify_pending.clear();
+}
+
+void NetworkManager::setCache(ResultCache *cache)
+{
+    this->cache = cache;
+}
+
+void NetworkManager::setDedup(bool enabled)
+{
+    this->dedup = enabled;
+}
+
+const DedupStats &NetworkManager::dedupStats() const
+{
+    return this->dedup_counters;
+}
 
-    // Передача каждого вектора
-    for (const auto &vec : data)
+void NetworkManager::setVerifier(ResultVerifier *verifier)
+{
+    this->verifier = verifier;
+}
+
+// Метод для проверки, отбираются ли векторы перед отправкой
+bool NetworkManager::filtered() const
+{
+    return this->cache != nullptr || this->dedup;
+}
+
+// Метод для отбора векторов порции, которые нужно отправить серверу
+template <typename T>
+std::vector<BasicVectorView<T>> NetworkManager::filter(const BasicVectorView<T> *views, size_t count, PreparedRound &round)
+{
+    std::vector<CacheKey> keys(count);
+    for (size_t i = 0; i < count; ++i)
+        keys[i] = ResultCache::key(DataTypeOf<T>::value, views[i].data, static_cast<size_t>(views[i].size) * sizeof(T));
+
+    round.count = count;
+    round.owner.clear();
+    const BasicVectorView<T> *unique_views = views;
+    const CacheKey *unique_keys = keys.data();
+    size_t unique = count;
+
+    // Индекс повторов хранит номер первого вхождения + 1 (0 - ячейка пуста),
+    // совпадение ключей подтверждается сравнением значений
+    std::vector<BasicVectorView<T>> distinct;
+    std::vector<CacheKey> distinct_keys;
+    if (this->dedup)
     {
-        uint32_t vec_size = vec.size();
-        if (send(this->socket, &vec_size, sizeof(vec_size), 0) < 0)
-        {
-            throw NetworkError("Failed to send vector size", "NetworkManager.calc()");
-        }
-        if (send(this->socket, vec.data(), vec_size * sizeof(uint32_t), 0) < 0)
+        size_t capacity = 16;
+        while (capacity < count * 2)
+            capacity *= 2;
+        this->dedup_index.assign(capacity, 0);
+        size_t mask = capacity - 1;
+        round.owner.resize(count);
+
+        for (size_t i = 0; i < count; ++i)
         {
-            throw NetworkError("Failed to send vector data", "NetworkManager.calc()");
+            size_t slot = keys[i].lo & mask;
+            for (;;)
+            {
+                uint32_t entry = this->dedup_index[slot];
+                if (entry == 0)
+                {
+                    this->dedup_index[slot] = static_cast<uint32_t>(distinct.size() + 1);
+                    round.owner[i] = static_cast<uint32_t>(distinct.size());
+                    distinct.push_back(views[i]);
+                    distinct_keys.push_back(keys[i]);
+                    break;
+                }
+                const BasicVectorView<T> &first = distinct[entry - 1];
+                if (distinct_keys[entry - 1].lo == keys[i].lo && distinct_keys[entry - 1].hi == keys[i].hi &&
+                    first.size == views[i].size &&
+                    std::memcmp(first.data, views[i].data, static_cast<size_t>(first.size) * sizeof(T)) == 0)
+                {
+                    round.owner[i] = entry - 1;
+                    break;
+                }
+                slot = (slot + 1) & mask;
+            }
         }
+        unique_views = distinct.data();
+        unique_keys = distinct_keys.data();
+        unique = distinct.size();
+    }
+    this->dedup_counters.vectors += count;
+    this->dedup_counters.unique += unique;
+
+    // Поиск различных векторов в кеше
+    round.results.assign(unique, 0);
+    round.misses.clear();
+    round.keys.clear();
+    std::unique_ptr<bool[]> found(new bool[unique]());
+    if (this->cache != nullptr)
+        this->cache->find(unique_keys, unique, round.results.data(), found.get());
+
+    std::vector<BasicVectorView<T>> missed;
+    for (size_t u = 0; u < unique; ++u)
+    {
+        if (found[u])
+            continue;
+        round.misses.push_back(static_cast<uint32_t>(u));
+        if (this->cache != nullptr)
+            round.keys.push_back(unique_keys[u]);
+        missed.push_back(unique_views[u]);
     }
+    return missed;
+}
 
-    // Получение результатов
-    std::vector<uint32_t> results(num_vectors);
-    for (uint32_t i = 0; i < num_vectors; ++i)
+// Метод для сборки результатов порции
+template <typename T>
+std::vector<T> NetworkManager::merge(PreparedRound &round, const std::vector<T> &computed)
+{
+    for (size_t j = 0; j < computed.size(); ++j)
+        std::memcpy(&round.results[round.misses[j]], &computed[j], sizeof(T));
+
+    // Новые результаты сохраняются в кеш
+    if (this->cache != nullptr && !round.keys.empty())
     {
-        if (recv(this->socket, &results[i], sizeof(uint32_t), 0) < 0)
+        std::vector<uint64_t> raw(round.misses.size());
+        for (size_t j = 0; j < raw.size(); ++j)
+            raw[j] = round.results[round.misses[j]];
+        this->cache->store(round.keys.data(), raw.data(), raw.size());
+    }
+
+    // Результат различного вектора раздаётся всем его повторам
+    std::vector<T> results(round.count);
+    for (size_t i = 0; i < results.size(); ++i)
+    {
+        size_t source = round.owner.empty() ? i : round.owner[i];
+        std::memcpy(&results[i], &round.results[source], sizeof(T));
+    }
+    return results;
+}
+
+// Метод для обмена порцией с отбором векторов
+template <typename T>
+std::vector<T> NetworkManager::exchangeFiltered(const BasicVectorView<T> *views, size_t count)
+{
+    PreparedRound round;
+    std::vector<BasicVectorView<T>> missed = this->filter(views, count, round);
+
+    // Порция, целиком найденная в кеше, серверу не отправляется
+    std::vector<T> computed;
+    if (!missed.empty())
+    {
+        this->codec.round(static_cast<uint32_t>(missed.size()));
+        computed = this->codec.exchange(missed);
+    }
+    return this->merge(round, computed);
+}
+
+// Метод для отбора векторов порции на проверку
+template <typename T>
+VerifySample NetworkManager::sampleChunk(const BasicVectorView<T> *views, size_t count)
+{
+    VerifySample sample = this->verifier->prepare(views, count, this->verify_position);
+    this->verify_position += count;
+    return sample;
+}
+
+// Метод для передачи порции векторов и получения результатов
+template <typename T>
+std::vector<T> NetworkManager::exchange(const BasicVectorBatch<T> &chunk)
+{
+    if (!this->filtered() && this->verifier == nullptr)
+        return this->codec.exchange(chunk);
+
+    std::vector<BasicVectorView<T>> views(chunk.size());
+    for (size_t i = 0; i < chunk.size(); ++i)
+        views[i] = chunk[i];
+    std::vector<T> results = this->filtered() ? this->exchangeFiltered(views.data(), views.size())
+                                              : this->codec.exchange(chunk);
+    if (this->verifier != nullptr)
+        this->verifier->submit(this->sampleChunk(views.data(), views.size()), results.data());
+    return results;
+}
+
+// Метод для передачи порции векторов из отображённого файла
+template <typename T>
+std::vector<T> NetworkManager::exchange(const BasicMappedChunk<T> &chunk)
+{
+    // Отобранные записи тоже отправляются без копирования значений
+    std::vector<T> results = this->filtered() ? this->exchangeFiltered(chunk.views.data(), chunk.views.size())
+                                              : this->codec.exchange(chunk);
+    if (this->verifier != nullptr)
+        this->verifier->submit(this->sampleChunk(chunk.views.data(), chunk.views.size()), results.data());
+    return results;
+}
+
+// Метод для обмена набором векторов отдельным раундом
+template <typename T>
+std::vector<T> NetworkManager::exchange(const std::vector<BasicVectorView<T>> &views)
+{
+    std::vector<T> results;
+    if (this->filtered())
+    {
+        results = this->exchangeFiltered(views.data(), views.size());
+    }
+    else if (!views.empty())
+    {
+        this->codec.round(static_cast<uint32_t>(views.size()));
+        results = this->codec.exchange(views);
+    }
+    if (this->verifier != nullptr)
+        this->verifier->submit(this->sampleChunk(views.data(), views.size()), results.data());
+    return results;
+}
+
+// Метод для отправки порции векторов без ожидания результатов
+template <typename T>
+void NetworkManager::send(const BasicVectorBatch<T> &chunk)
+{
+    if (!this->filtered() && this->verifier == nullptr)
+    {
+        this->codec.send(chunk);
+        return;
+    }
+
+    std::vector<BasicVectorView<T>> views(chunk.size());
+    for (size_t i = 0; i < chunk.size(); ++i)
+        views[i] = chunk[i];
+
+    // Порция возвращается в пул сразу после отправки, поэтому векторы для проверки копируются заранее
+    VerifySample sample;
+    if (this->verifier != nullptr)
+        sample = this->sampleChunk(views.data(), views.size());
+
+    PreparedRound round;
+    if (this->filtered())
+    {
+        std::vector<BasicVectorView<T>> missed = this->filter(views.data(), views.size(), round);
+        if (!missed.empty())
         {
-            throw NetworkError("Failed to receive result", "NetworkManager.calc()");
+            this->codec.round(static_cast<uint32_t>(missed.size()));
+            this->codec.send(missed);
         }
     }
+    else
+    {
+        this->codec.send(chunk);
+    }
+
+    std::lock_guard<std::mutex> lock(this->rounds_mutex);
+    if (this->filtered())
+        this->rounds.push_back(std::move(round));
+    if (this->verifier != nullptr)
+        this->verify_pending.push_back(std::move(sample));
+}
 
-    // Логирование результата
-    std::cout << "Log: \"NetworkManager.calc()\"\n";
-    std::cout << "Results: {";
-    for (const auto &val : results)
+// Метод для приёма результатов ранее отправленных векторов
+template <typename T>
+std::vector<T> NetworkManager::recv(size_t count)
+{
+    std::vector<T> results;
+    if (this->filtered())
     {
-        std::cout << val << ", ";
+        PreparedRound round;
+        {
+            std::lock_guard<std::mutex> lock(this->rounds_mutex);
+            if (this->rounds.empty() || this->rounds.front().count != count)
+                throw NetworkError("Results requested for a chunk that was not sent", "NetworkManager.recv()");
+            round = std::move(this->rounds.front());
+            this->rounds.pop_front();
+        }
+        std::vector<T> computed(round.misses.size());
+        if (!computed.empty())
+            this->codec.recv(computed.data(), computed.size());
+        results = this->merge(round, computed);
     }
-    if (!results.empty())
+    else
     {
-        std::cout << "\b\b"; // Удалить последнюю запятую и пробел
+        results.resize(count);
+        this->codec.recv(results.data(), count);
     }
-    std::cout << "}\n";
 
+    if (this->verifier != nullptr)
+    {
+        VerifySample sample;
+        {
+            std::lock_guard<std::mutex> lock(this->rounds_mutex);
+            if (this->verify_pending.empty())
+                throw NetworkError("Results requested for a chunk that was not sent", "NetworkManager.recv()");
+            sample = std::move(this->verify_pending.front());
+            this->verify_pending.pop_front();
+        }
+        this->verifier->submit(std::move(sample), results.data());
+    }
     return results;
 }
 
+// Метод для получения счётчиков системных вызовов
+const SyscallStats &NetworkManager::stats() const
+{
+    return this->codec.stats();
+}
+
 // Метод для закрытия соединения
 void NetworkManager::close()
 {
@@ -125,3 +437,20 @@ void NetworkManager::close()
         this->socket = -1;
     }
 }
+
+// Метод для прерывания передачи
+void NetworkManager::shutdown()
+{
+    if (this->socket >= 0)
+        ::shutdown(this->socket, SHUT_RDWR);
+}
+
+// Явное инстанцирование для поддерживаемых типов данных
+#define INSTANTIATE_NETWORK(T)                                                                    \
+    template std::vector<T> NetworkManager::calc<T>(const BasicVectorBatch<T> &);                 \
+    template std::vector<T> NetworkManager::exchange<T>(const BasicVectorBatch<T> &);             \
+    template std::vector<T> NetworkManager::exchange<T>(const BasicMappedChunk<T> &);             \
+    template std::vector<T> NetworkManager::exchange<T>(const std::vector<BasicVectorView<T>> &); \
+    template void NetworkManager::send<T>(const BasicVectorBatch<T> &);                           \
+    template std::vector<T> NetworkManager::recv<T>(size_t);
+FOR_EACH_DATA_TYPE(INSTANTIATE_NETWORK)
@@ -3,7 +3,15 @@
 
 #include <string>
 #include <vector>
+#include <deque>
+#include <mutex>
 #include <cstdint>
+#include "batch.h"
+#include "cache.h"
+#include "mapped.h"
+#include "codec.h"
+#include "crypt.h"
+#include "verify.h"
 
 /** 
 * @file network.h
@@ -15,8 +23,25 @@
 * @copyright ИБСТ ПГУ
 */
 
+/**
+* @brief Счётчики устранения повторов в порциях.
+*/
+struct DedupStats
+{
+    uint64_t vectors; ///< Количество векторов в порциях.
+    uint64_t unique; ///< Количество различных векторов внутри порций.
+};
+
 /** 
 * @brief Класс для управления сетевым подключением и взаимодействием.
+* @details Методы обмена параметризованы типом значений векторов T,
+* результаты сервера имеют тот же тип. Если включено устранение повторов,
+* каждый различный вектор порции отправляется один раз, а его результат
+* раздаётся всем повторам. Если подключён кеш результатов, различные векторы
+* ищутся в кеше. В обоих случаях серверу отдельным раундом отправляются
+* только отобранные векторы. Раунды опираются на протокол сервера: после
+* каждого вычисления он снова ждёт количество векторов, поэтому одна сессия
+* выдерживает любое число вычислений подряд.
 */
 class NetworkManager
 {
@@ -54,23 +79,209 @@ public:
     */
     void auth(const std::string &username, const std::string &password);
 
+    /**
+    * @brief Метод для аутентификации пользователя с заранее вычисленными солью и хешем.
+    * @param username Имя пользователя.
+    * @param token Соль и хеш соли и пароля.
+    * @throw AuthError Если не удалось отправить сообщение об аутентификации или аутентификация не удалась.
+    */
+    void auth(const std::string &username, const SaltHash &token);
+
     /**
     * @brief Метод для передачи данных и получения результата.
     * @param data Данные для обработки.
     * @return Результаты обработки данных.
     * @throw NetworkError Если не удалось отправить или получить данные.
     */
-    std::vector<uint32_t> calc(const std::vector<std::vector<uint32_t>> &data);
+    template <typename T>
+    std::vector<T> calc(const BasicVectorBatch<T> &data);
+
+    /**
+    * @brief Метод для начала потоковой передачи данных.
+    * @details Передаёт серверу общее количество векторов, которые затем
+    * отправляются порциями через exchange().
+    * @param num_vectors Общее количество векторов.
+    * @throw NetworkError Если не удалось отправить количество векторов.
+    */
+    void begin(uint32_t num_vectors);
+
+    /**
+    * @brief Метод для начала передачи отдельными раундами.
+    * @details Общее количество векторов заранее не передаётся: каждый вызов
+    * exchange() с набором представлений отправляет свой раунд.
+    */
+    void beginRounds();
+
+    /**
+    * @brief Метод для подключения кеша результатов.
+    * @details С кешем количество векторов передаётся серверу не в begin(),
+    * а перед каждой порцией - только для векторов, которых нет в кеше.
+    * @param cache Кеш результатов (nullptr - без кеша), должен жить дольше менеджера.
+    */
+    void setCache(ResultCache *cache);
+
+    /**
+    * @brief Метод для включения устранения повторов внутри порций.
+    * @details Как и с кешем, количество векторов передаётся серверу перед каждой порцией.
+    * Индекс повторов хранит 4-байтовые номера в 2-4 ячейках на вектор порции.
+    * @param enabled Устранять ли повторы.
+    */
+    void setDedup(bool enabled);
+
+    /**
+    * @brief Метод для получения счётчиков устранения повторов.
+    * @return Счётчики с момента последнего вызова begin().
+    */
+    const DedupStats &dedupStats() const;
+
+    /**
+    * @brief Метод для подключения выборочной проверки результатов.
+    * @details Отобранные векторы каждой порции вместе с итоговыми результатами
+    * передаются проверяющему; номера векторов отсчитываются от begin().
+    * @param verifier Проверяющий (nullptr - без проверки), должен жить дольше менеджера.
+    */
+    void setVerifier(ResultVerifier *verifier);
+
+    /**
+    * @brief Метод для передачи порции векторов и получения их результатов.
+    * @param chunk Порция векторов.
+    * @return Результаты обработки порции.
+    * @throw NetworkError Если не удалось отправить или получить данные.
+    */
+    template <typename T>
+    std::vector<T> exchange(const BasicVectorBatch<T> &chunk);
+
+    /**
+    * @brief Метод для передачи порции векторов из отображённого файла.
+    * @details Записи порции отправляются прямо из страничного кэша,
+    * без копирования в промежуточные буферы.
+    * @param chunk Порция векторов.
+    * @return Результаты обработки порции.
+    * @throw NetworkError Если не удалось отправить или получить данные.
+    */
+    template <typename T>
+    std::vector<T> exchange(const BasicMappedChunk<T> &chunk);
+
+    /**
+    * @brief Метод для обмена набором векторов отдельным раундом.
+    * @details Используется после beginRounds(). Пустой набор серверу не отправляется.
+    * @param views Представления векторов.
+    * @return Результаты обработки векторов.
+    * @throw NetworkError Если не удалось отправить или получить данные.
+    */
+    template <typename T>
+    std::vector<T> exchange(const std::vector<BasicVectorView<T>> &views);
+
+    /**
+    * @brief Метод для отправки порции векторов без ожидания результатов.
+    * @details Может вызываться одновременно с recv() из другого потока.
+    * @param chunk Порция векторов.
+    * @throw NetworkError Если не удалось отправить данные.
+    */
+    template <typename T>
+    void send(const BasicVectorBatch<T> &chunk);
+
+    /**
+    * @brief Метод для приёма результатов ранее отправленных векторов.
+    * @details Может вызываться одновременно с send() из другого потока.
+    * @tparam T Тип результатов.
+    * @param count Количество результатов.
+    * @return Результаты обработки.
+    * @throw NetworkError Если не удалось получить данные.
+    */
+    template <typename T = uint32_t>
+    std::vector<T> recv(size_t count);
+
+    /**
+    * @brief Метод для получения счётчиков системных вызовов текущей передачи.
+    * @return Счётчики с момента последнего вызова begin().
+    */
+    const SyscallStats &stats() const;
 
     /**
     * @brief Метод для закрытия сетевого подключения.
     */
     void close();
 
+    /**
+    * @brief Метод для прерывания передачи в обоих направлениях.
+    * @details Разблокирует потоки, ожидающие отправки или приёма.
+    */
+    void shutdown();
+
 private:
+    /**
+    * @brief Порция, из которой отобраны векторы для отправки.
+    */
+    struct PreparedRound
+    {
+        size_t count; ///< Количество векторов порции.
+        std::vector<uint32_t> owner; ///< Номер различного вектора для каждого вектора (пусто - без устранения повторов).
+        std::vector<uint64_t> results; ///< Результаты различных векторов (найденные в кеше заполнены).
+        std::vector<uint32_t> misses; ///< Номера различных векторов, отправленных серверу.
+        std::vector<CacheKey> keys; ///< Ключи отправленных векторов (при подключённом кеше).
+    };
+
     int socket; ///< Сокет подключения.
     std::string address; ///< Адрес сервера.
     uint16_t port; ///< Порт сервера.
+    WireCodec codec; ///< Кодек обмена векторами.
+    ResultCache *cache; ///< Кеш результатов (nullptr - без кеша).
+    bool dedup; ///< Флаг устранения повторов внутри порции.
+    DedupStats dedup_counters; ///< Счётчики устранения повторов.
+    std::vector<uint32_t> dedup_index; ///< Индекс повторов порции (переиспользуется между порциями).
+    std::deque<PreparedRound> rounds; ///< Отправленные порции, результаты которых ещё не приняты.
+    std::mutex rounds_mutex; ///< Мьютекс очереди порций.
+    ResultVerifier *verifier; ///< Проверяющий результаты (nullptr - без проверки).
+    uint64_t verify_position; ///< Номер первого вектора следующей порции с начала передачи.
+    std::deque<VerifySample> verify_pending; ///< Отобранные векторы отправленных порций (под rounds_mutex).
+
+    /**
+    * @brief Метод для проверки, отбираются ли векторы перед отправкой.
+    * @return true, если подключён кеш или включено устранение повторов.
+    */
+    bool filtered() const;
+
+    /**
+    * @brief Метод для отбора векторов порции, которые нужно отправить серверу.
+    * @details Повторы внутри порции сводятся к первому вхождению, различные
+    * векторы ищутся в кеше.
+    * @param views Представления векторов порции.
+    * @param count Количество векторов.
+    * @param round Порция с найденными результатами и сведениями об отобранных векторах.
+    * @return Представления векторов для отправки.
+    */
+    template <typename T>
+    std::vector<BasicVectorView<T>> filter(const BasicVectorView<T> *views, size_t count, PreparedRound &round);
+
+    /**
+    * @brief Метод для сборки результатов порции.
+    * @details Сохраняет новые результаты в кеш и раздаёт результат каждого
+    * различного вектора всем его повторам.
+    * @param round Порция с найденными результатами.
+    * @param computed Результаты сервера для отправленных векторов.
+    * @return Результаты всей порции.
+    */
+    template <typename T>
+    std::vector<T> merge(PreparedRound &round, const std::vector<T> &computed);
+
+    /**
+    * @brief Метод для обмена порцией с отбором векторов.
+    * @param views Представления векторов порции.
+    * @param count Количество векторов.
+    * @return Результаты обработки порции.
+    */
+    template <typename T>
+    std::vector<T> exchangeFiltered(const BasicVectorView<T> *views, size_t count);
+
+    /**
+    * @brief Метод для отбора векторов порции на проверку.
+    * @param views Представления векторов порции.
+    * @param count Количество векторов.
+    * @return Отобранные векторы.
+    */
+    template <typename T>
+    VerifySample sampleChunk(const BasicVectorView<T> *views, size_t count);
 };
 
 #endif // NETWORK_MANAGER_H
@@ -0,0 +1,172 @@
+#include "pipeline.h"
+#include <chrono>
+#include "log.h"
+#include "trace.h"
+#include <memory>
+#include <thread>
+#include <vector>
+
+// Конструктор
+template <typename T>
+BasicPipeline<T>::BasicPipeline(
+    IOManager &io_man,
+    NetworkManager &net_man,
+    size_t memory_limit,
+    size_t queue_depth,
+    bool huge_pages)
+    : io_man(io_man),
+      net_man(net_man),
+      memory_limit(memory_limit),
+      queue_depth(queue_depth > 0 ? queue_depth : 1),
+      huge_pages(huge_pages) {}
+
+// Метод для запуска конвейера
+template <typename T>
+void BasicPipeline<T>::run()
+{
+    typedef std::chrono::steady_clock clock;
+    clock::time_point started = clock::now();
+
+    // Пул порций: одна читается, queue_depth ждут отправки, одна отправляется
+    size_t pool_size = this->queue_depth + 2;
+    size_t chunk_limit = this->memory_limit / pool_size;
+    std::vector<std::unique_ptr<BasicVectorBatch<T>>> pool;
+    BoundedQueue<BasicVectorBatch<T> *> free_queue(pool_size);
+    for (size_t i = 0; i < pool_size; ++i)
+    {
+        pool.emplace_back(new BasicVectorBatch<T>(this->huge_pages));
+        free_queue.push(pool.back().get());
+    }
+
+    BoundedQueue<BasicVectorBatch<T> *> send_queue(this->queue_depth);
+    BoundedQueue<size_t> recv_queue(this->queue_depth);
+    BoundedQueue<std::vector<T>> write_queue(this->queue_depth);
+
+    BasicVectorReader<T> reader = this->io_man.template reader<T>(chunk_limit);
+    BasicResultWriter<T> writer = this->io_man.template writer<T>(reader.count());
+    this->net_man.begin(reader.count());
+
+    // Остановка всех стадий при первой ошибке
+    auto fail = [&](std::exception_ptr e)
+    {
+        {
+            std::lock_guard<std::mutex> lock(this->error_mutex);
+            if (!this->error)
+                this->error = e;
+        }
+        free_queue.close(true);
+        send_queue.close(true);
+        recv_queue.close(true);
+        write_queue.close(true);
+        this->net_man.shutdown();
+    };
+
+    clock::duration read_time(0), send_time(0), recv_time(0), write_time(0);
+
+    // Стадия чтения
+    std::thread read_stage([&]
+                           {
+        if (Tracer::enabled())
+            Tracer::instance().nameThread("pipeline read");
+        try
+        {
+            BasicVectorBatch<T> *batch;
+            while (free_queue.pop(batch))
+            {
+                clock::time_point t = clock::now();
+                bool more = reader.next(*batch);
+                read_time += clock::now() - t;
+                if (!more || !send_queue.push(batch))
+                    break;
+            }
+            send_queue.close();
+        }
+        catch (...)
+        {
+            fail(std::current_exception());
+        } });
+
+    // Стадия отправки
+    std::thread send_stage([&]
+                           {
+        if (Tracer::enabled())
+            Tracer::instance().nameThread("pipeline send");
+        try
+        {
+            BasicVectorBatch<T> *batch;
+            while (send_queue.pop(batch))
+            {
+                clock::time_point t = clock::now();
+                this->net_man.send(*batch);
+                send_time += clock::now() - t;
+                size_t count = batch->size();
+                if (!recv_queue.push(count) || !free_queue.push(batch))
+                    break;
+            }
+            recv_queue.close();
+        }
+        catch (...)
+        {
+            fail(std::current_exception());
+        } });
+
+    // Стадия приёма
+    std::thread recv_stage([&]
+                           {
+        if (Tracer::enabled())
+            Tracer::instance().nameThread("pipeline recv");
+        try
+        {
+            size_t count;
+            while (recv_queue.pop(count))
+            {
+                clock::time_point t = clock::now();
+                std::vector<T> results = this->net_man.template recv<T>(count);
+                recv_time += clock::now() - t;
+                if (!write_queue.push(std::move(results)))
+                    break;
+            }
+            write_queue.close();
+        }
+        catch (...)
+        {
+            fail(std::current_exception());
+        } });
+
+    // Стадия записи выполняется в текущем потоке
+    try
+    {
+        std::vector<T> results;
+        while (write_queue.pop(results))
+        {
+            clock::time_point t = clock::now();
+            writer.append(results);
+            write_time += clock::now() - t;
+        }
+    }
+    catch (...)
+    {
+        fail(std::current_exception());
+    }
+
+    read_stage.join();
+    send_stage.join();
+    recv_stage.join();
+
+    if (this->error)
+        std::rethrow_exception(this->error);
+    writer.close();
+
+    // Логирование времени работы стадий
+    auto ms = [](clock::duration d)
+    { return std::chrono::duration_cast<std::chrono::milliseconds>(d).count(); };
+    LOG_INFO("Pipeline.run()", "Stages: read=" << ms(read_time)
+                                                << "ms send=" << ms(send_time)
+                                                << "ms recv=" << ms(recv_time)
+                                                << "ms write=" << ms(write_time)
+                                                << "ms wall=" << ms(clock::now() - started) << "ms");
+}
+
+// Явное инстанцирование для поддерживаемых типов данных
+#define INSTANTIATE_PIPELINE(T) template class BasicPipeline<T>;
+FOR_EACH_DATA_TYPE(INSTANTIATE_PIPELINE)
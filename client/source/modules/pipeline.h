@@ -0,0 +1,148 @@
+#ifndef PIPELINE_H
+#define PIPELINE_H
+
+#include <cstdint>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <condition_variable>
+#include <exception>
+#include "io.h"
+#include "network.h"
+
+/**
+* @file pipeline.h
+* @brief Определения классов для конвейерной обработки данных.
+* @details Этот файл содержит определения ограниченной очереди и конвейера,
+* в котором чтение файла, отправка векторов, приём результатов и запись
+* выполняются одновременно в отдельных потоках.
+* @date 17.10.2026
+* @version 1.0
+* @authors Косов Р. С.
+* @copyright ИБСТ ПГУ
+*/
+
+/**
+* @brief Потокобезопасная очередь ограниченной длины.
+* @tparam T Тип элементов очереди.
+*/
+template <typename T>
+class BoundedQueue
+{
+public:
+    /**
+    * @brief Конструктор класса BoundedQueue.
+    * @param capacity Максимальное количество элементов в очереди.
+    */
+    explicit BoundedQueue(size_t capacity)
+        : capacity(capacity), closed(false), discarded(false) {}
+
+    /**
+    * @brief Метод для добавления элемента (блокируется, пока очередь заполнена).
+    * @param item Добавляемый элемент.
+    * @return false, если очередь закрыта.
+    */
+    bool push(T item)
+    {
+        std::unique_lock<std::mutex> lock(this->mutex);
+        this->not_full.wait(lock, [this]
+                            { return this->items.size() < this->capacity || this->closed; });
+        if (this->closed)
+            return false;
+
+        this->items.push_back(std::move(item));
+        this->not_empty.notify_one();
+        return true;
+    }
+
+    /**
+    * @brief Метод для извлечения элемента (блокируется, пока очередь пуста).
+    * @param item Извлечённый элемент.
+    * @return false, если очередь закрыта и пуста (или сброшена).
+    */
+    bool pop(T &item)
+    {
+        std::unique_lock<std::mutex> lock(this->mutex);
+        this->not_empty.wait(lock, [this]
+                             { return !this->items.empty() || this->closed; });
+        if (this->items.empty() || this->discarded)
+            return false;
+
+        item = std::move(this->items.front());
+        this->items.pop_front();
+        this->not_full.notify_one();
+        return true;
+    }
+
+    /**
+    * @brief Метод для закрытия очереди.
+    * @param discard Сбросить ли оставшиеся элементы (при ошибке).
+    */
+    void close(bool discard = false)
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->closed = true;
+        this->discarded = this->discarded || discard;
+        this->not_empty.notify_all();
+        this->not_full.notify_all();
+    }
+
+private:
+    std::mutex mutex; ///< Мьютекс очереди.
+    std::condition_variable not_empty; ///< Условие непустой очереди.
+    std::condition_variable not_full; ///< Условие незаполненной очереди.
+    std::deque<T> items; ///< Элементы очереди.
+    size_t capacity; ///< Максимальное количество элементов.
+    bool closed; ///< Флаг закрытия очереди.
+    bool discarded; ///< Флаг сброса оставшихся элементов.
+};
+
+/**
+* @brief Класс для конвейерной обработки входного файла.
+* @details Стадии чтения, отправки, приёма и записи связаны ограниченными очередями.
+* Общий объём памяти под векторы не превышает заданного ограничения: он делится
+* между порциями, одновременно находящимися в конвейере.
+* @tparam T Тип значений векторов.
+*/
+template <typename T>
+class BasicPipeline
+{
+public:
+    /**
+    * @brief Конструктор класса BasicPipeline.
+    * @param io_man Менеджер ввода-вывода.
+    * @param net_man Менеджер сетевого взаимодействия (подключён и аутентифицирован).
+    * @param memory_limit Общее ограничение памяти под порции векторов (в байтах).
+    * @param queue_depth Длина очередей между стадиями.
+    * @param huge_pages Размещать ли порции в больших страницах памяти.
+    */
+    BasicPipeline(
+        IOManager &io_man,
+        NetworkManager &net_man,
+        size_t memory_limit,
+        size_t queue_depth,
+        bool huge_pages);
+
+    /**
+    * @brief Метод для запуска конвейера.
+    * @throw IOError Если произошла ошибка ввода-вывода.
+    * @throw DataDecodeError Если входной файл повреждён.
+    * @throw NetworkError Если произошла сетевая ошибка.
+    */
+    void run();
+
+private:
+    IOManager &io_man; ///< Менеджер ввода-вывода.
+    NetworkManager &net_man; ///< Менеджер сетевого взаимодействия.
+    size_t memory_limit; ///< Общее ограничение памяти.
+    size_t queue_depth; ///< Длина очередей между стадиями.
+    bool huge_pages; ///< Флаг размещения порций в больших страницах.
+
+    std::mutex error_mutex; ///< Мьютекс первой ошибки.
+    std::exception_ptr error; ///< Первая ошибка, возникшая в любой из стадий.
+};
+
+/// Конвейер для векторов из значений uint32_t.
+typedef BasicPipeline<uint32_t> Pipeline;
+
+#endif // PIPELINE_H
@@ -0,0 +1,248 @@
+#include "resume.h"
+#include "crc32c.h"
+#include "log.h"
+#include "metrics.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <thread>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Сигнатура файла контрольной точки
+static const char CHECKPOINT_MAGIC[8] = {'V', 'C', 'C', 'K', 'P', 'T', '0', '1'};
+
+// Функция для записи всего буфера в заданное место файла
+static void pwriteAll(int fd, const void *data, size_t bytes, off_t offset, const std::string &path)
+{
+    const char *p = static_cast<const char *>(data);
+    while (bytes > 0)
+    {
+        ssize_t written = pwrite(fd, p, bytes, offset);
+        if (written <= 0)
+            throw IOError("Failed to write file \"" + path + "\"", "ResumableCalc.run()");
+        p += written;
+        bytes -= written;
+        offset += written;
+    }
+}
+
+// Конструктор
+template <typename T>
+BasicResumableCalc<T>::BasicResumableCalc(
+    IOManager &io_man,
+    NetworkManager &net_man,
+    const std::array<std::string, 2> &credentials,
+    const std::string &input_path,
+    const std::string &output_path,
+    size_t memory_limit,
+    bool huge_pages,
+    unsigned retries)
+    : io_man(io_man),
+      net_man(net_man),
+      credentials(credentials),
+      input_path(input_path),
+      output_path(output_path),
+      memory_limit(memory_limit),
+      huge_pages(huge_pages),
+      retries(retries),
+      counters() {}
+
+// Метод для чтения контрольной точки прошлого запуска
+template <typename T>
+uint64_t BasicResumableCalc<T>::loadCheckpoint(const Checkpoint &expected)
+{
+    int fd = ::open((this->output_path + ".ckpt").c_str(), O_RDONLY);
+    if (fd < 0)
+        return 0;
+    Checkpoint stored;
+    ssize_t length = pread(fd, &stored, sizeof(stored), 0);
+    ::close(fd);
+
+    uint32_t crc = stored.crc;
+    stored.crc = 0;
+    if (length != static_cast<ssize_t>(sizeof(stored)) || crc32c(&stored, sizeof(stored)) != crc ||
+        std::memcmp(stored.magic, CHECKPOINT_MAGIC, sizeof(CHECKPOINT_MAGIC)) != 0)
+    {
+        LOG_WARN("ResumableCalc.run()", "Checkpoint of \"" << this->output_path << "\" is damaged and is ignored");
+        return 0;
+    }
+
+    // Контрольная точка другого входного файла не используется
+    if (stored.type != expected.type || stored.input_size != expected.input_size ||
+        stored.input_mtime != expected.input_mtime || stored.total != expected.total ||
+        stored.done > stored.total)
+    {
+        LOG_INFO("ResumableCalc.run()", "Input file changed since the checkpoint, starting over");
+        return 0;
+    }
+
+    struct stat part;
+    if (stat((this->output_path + ".part").c_str(), &part) < 0 ||
+        static_cast<uint64_t>(part.st_size) < sizeof(uint32_t) + stored.done * sizeof(T))
+        return 0;
+    return stored.done;
+}
+
+// Метод для записи контрольной точки
+template <typename T>
+void BasicResumableCalc<T>::saveCheckpoint(Checkpoint checkpoint)
+{
+    checkpoint.crc = 0;
+    checkpoint.crc = crc32c(&checkpoint, sizeof(checkpoint));
+
+    // Контрольная точка заменяется целиком, чтобы при сбое осталась прежняя
+    std::string path = this->output_path + ".ckpt";
+    int fd = ::open((path + ".tmp").c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0)
+        throw IOError("Failed to create checkpoint \"" + path + ".tmp\"", "ResumableCalc.run()");
+    bool written = write(fd, &checkpoint, sizeof(checkpoint)) == static_cast<ssize_t>(sizeof(checkpoint)) &&
+                   fdatasync(fd) == 0;
+    if (::close(fd) < 0 || !written || std::rename((path + ".tmp").c_str(), path.c_str()) < 0)
+        throw IOError("Failed to write checkpoint \"" + path + "\"", "ResumableCalc.run()");
+    ++this->counters.checkpoints;
+}
+
+// Метод для подключения и аутентификации с повторными попытками
+template <typename T>
+void BasicResumableCalc<T>::connect(uint32_t remaining, unsigned attempt)
+{
+    for (;; ++attempt)
+    {
+        if (attempt > 0)
+        {
+            // Пауза удваивается с каждой попыткой
+            unsigned delay = std::min<unsigned>(BACKOFF_MS << std::min(attempt - 1, 16u), MAX_BACKOFF_MS);
+            std::this_thread::sleep_for(std::chrono::milliseconds(delay));
+            ++this->counters.reconnects;
+        }
+        try
+        {
+            this->net_man.close();
+            this->net_man.conn();
+            this->net_man.auth(this->credentials[0], this->credentials[1]);
+            this->net_man.begin(remaining);
+            return;
+        }
+        catch (const NetworkError &e)
+        {
+            if (attempt >= this->retries)
+                throw;
+            LOG_WARN("ResumableCalc.run()", "Connection attempt " << attempt + 1 << " failed: " << e.what());
+        }
+        catch (const AuthError &e)
+        {
+            if (attempt >= this->retries)
+                throw;
+            LOG_WARN("ResumableCalc.run()", "Authentication attempt " << attempt + 1 << " failed: " << e.what());
+        }
+    }
+}
+
+// Метод для запуска обработки
+template <typename T>
+void BasicResumableCalc<T>::run()
+{
+    struct stat input;
+    if (stat(this->input_path.c_str(), &input) < 0)
+        throw IOError("Failed to open input file for reading.", "ResumableCalc.run()");
+
+    BasicVectorReader<T> reader = this->io_man.template reader<T>(this->memory_limit);
+    uint32_t total = reader.count();
+
+    Checkpoint checkpoint;
+    std::memset(&checkpoint, 0, sizeof(checkpoint));
+    std::memcpy(checkpoint.magic, CHECKPOINT_MAGIC, sizeof(CHECKPOINT_MAGIC));
+    checkpoint.type = static_cast<uint32_t>(DataTypeOf<T>::value);
+    checkpoint.input_size = input.st_size;
+    checkpoint.input_mtime = static_cast<int64_t>(input.st_mtim.tv_sec) * 1000000000 + input.st_mtim.tv_nsec;
+    checkpoint.total = total;
+
+    this->counters = ResumeStats();
+    uint64_t done = this->loadCheckpoint(checkpoint);
+    this->counters.resumed_from = done;
+
+    // Результаты дописываются во временный файл, недописанный хвост отбрасывается
+    std::string part = this->output_path + ".part";
+    int fd = ::open(part.c_str(), O_WRONLY | O_CREAT, 0644);
+    if (fd < 0)
+        throw IOError("Failed to open output file \"" + part + "\"", "ResumableCalc.run()");
+
+    try
+    {
+        if (ftruncate(fd, sizeof(uint32_t) + done * sizeof(T)) < 0)
+            throw IOError("Failed to truncate output file \"" + part + "\"", "ResumableCalc.run()");
+        pwriteAll(fd, &total, sizeof(total), 0, part);
+
+        // Векторы с готовыми результатами читаются, но не отправляются
+        BasicVectorBatch<T> chunk(this->huge_pages);
+        for (uint64_t skipped = 0; skipped < done; skipped += chunk.size())
+        {
+            if (!reader.next(chunk, done - skipped))
+                throw DataDecodeError("Unexpected end of input file", "ResumableCalc.run()");
+        }
+        if (done > 0)
+            LOG_INFO("ResumableCalc.run()", "Resuming from vector " << done << " of " << total);
+
+        if (done < total)
+            this->connect(static_cast<uint32_t>(total - done), 0);
+        while (done < total && reader.next(chunk))
+        {
+            // Порция отправляется заново, пока не получены её результаты
+            std::vector<T> results;
+            for (unsigned attempt = 0;; ++attempt)
+            {
+                try
+                {
+                    results = this->net_man.exchange(chunk);
+                    break;
+                }
+                catch (const NetworkError &e)
+                {
+                    if (attempt >= this->retries)
+                        throw;
+                    LOG_WARN("ResumableCalc.run()", "Connection lost at vector " << done << ": " << e.what());
+                    this->connect(static_cast<uint32_t>(total - done), attempt + 1);
+                }
+            }
+
+            PhaseTimer timer(Phase::WRITE);
+            pwriteAll(fd, results.data(), results.size() * sizeof(T), sizeof(uint32_t) + done * sizeof(T), part);
+            if (fdatasync(fd) < 0)
+                throw IOError("Failed to flush output file \"" + part + "\"", "ResumableCalc.run()");
+            timer.stop(results.size() * sizeof(T), results.size());
+
+            done += results.size();
+            checkpoint.done = done;
+            this->saveCheckpoint(checkpoint);
+        }
+        if (done != total)
+            throw IOError("Not all results were written", "ResumableCalc.run()");
+    }
+    catch (...)
+    {
+        ::close(fd);
+        throw;
+    }
+
+    // Выходной файл появляется только целиком
+    if (::close(fd) < 0 || std::rename(part.c_str(), this->output_path.c_str()) < 0)
+        throw IOError("Failed to write output file \"" + this->output_path + "\"", "ResumableCalc.run()");
+    std::remove((this->output_path + ".ckpt").c_str());
+
+    LOG_INFO("ResumableCalc.run()", "Resume: resumed_from=" << this->counters.resumed_from
+                                                            << " reconnects=" << this->counters.reconnects
+                                                            << " checkpoints=" << this->counters.checkpoints);
+}
+
+template <typename T>
+const ResumeStats &BasicResumableCalc<T>::stats() const
+{
+    return this->counters;
+}
+
+// Явное инстанцирование для поддерживаемых типов данных
+#define INSTANTIATE_RESUME(T) template class BasicResumableCalc<T>;
+FOR_EACH_DATA_TYPE(INSTANTIATE_RESUME)
@@ -0,0 +1,143 @@
+#ifndef RESUME_H
+#define RESUME_H
+
+#include <array>
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include "io.h"
+#include "network.h"
+#include "errors.h"
+#include "types.h"
+
+/**
+* @file resume.h
+* @brief Определения классов для обработки с контрольными точками и переподключением.
+* @details Результаты пишутся не в выходной файл, а в OUTPUT.part; после
+* каждой порции он сбрасывается на диск, и количество готовых результатов
+* сохраняется в файл контрольной точки OUTPUT.ckpt (через временный файл
+* и переименование). При обрыве соединения клиент переподключается и
+* повторяет аутентификацию с экспоненциально растущей паузой и продолжает
+* с первого вектора без результата. Если процесс завершился, следующий
+* запуск с теми же файлами продолжает с контрольной точки, если входной
+* файл не изменился. Выходной файл появляется только после записи всех
+* результатов - переименованием OUTPUT.part.
+* @date 17.10.2026
+* @version 1.0
+* @authors Косов Р. С.
+* @copyright ИБСТ ПГУ
+*/
+
+/**
+* @brief Счётчики обработки с контрольными точками.
+*/
+struct ResumeStats
+{
+    uint64_t resumed_from; ///< Номер вектора, с которого продолжен прошлый запуск.
+    uint64_t reconnects; ///< Количество переподключений.
+    uint64_t checkpoints; ///< Количество записанных контрольных точек.
+};
+
+/**
+* @brief Класс для обработки входного файла с контрольными точками и переподключением.
+* @tparam T Тип значений векторов.
+*/
+template <typename T>
+class BasicResumableCalc
+{
+public:
+    /// Начальная пауза перед переподключением в миллисекундах.
+    static constexpr unsigned BACKOFF_MS = 100;
+
+    /// Наибольшая пауза перед переподключением в миллисекундах.
+    static constexpr unsigned MAX_BACKOFF_MS = 10000;
+
+    /**
+    * @brief Конструктор класса BasicResumableCalc.
+    * @param io_man Менеджер ввода-вывода.
+    * @param net_man Менеджер сети (подключается в run()).
+    * @param credentials Логин и пароль.
+    * @param input_path Путь к входному файлу.
+    * @param output_path Путь к выходному файлу.
+    * @param memory_limit Ограничение объёма одной порции векторов (в байтах).
+    * @param huge_pages Размещать ли порции в больших страницах памяти.
+    * @param retries Количество попыток переподключения подряд.
+    */
+    BasicResumableCalc(
+        IOManager &io_man,
+        NetworkManager &net_man,
+        const std::array<std::string, 2> &credentials,
+        const std::string &input_path,
+        const std::string &output_path,
+        size_t memory_limit,
+        bool huge_pages,
+        unsigned retries);
+
+    /**
+    * @brief Метод для запуска обработки.
+    * @throw IOError Если произошла ошибка ввода-вывода.
+    * @throw DataDecodeError Если входной файл повреждён.
+    * @throw NetworkError Если соединение не восстановлено за заданное число попыток.
+    * @throw AuthError Если повторная аутентификация не удалась за заданное число попыток.
+    */
+    void run();
+
+    /**
+    * @brief Метод для получения счётчиков последнего запуска.
+    * @return Счётчики обработки.
+    */
+    const ResumeStats &stats() const;
+
+private:
+    /**
+    * @brief Контрольная точка.
+    */
+    struct Checkpoint
+    {
+        char magic[8]; ///< Сигнатура "VCCKPT01".
+        uint32_t type; ///< Тип значений векторов.
+        uint32_t crc; ///< CRC32C остальных полей.
+        uint64_t input_size; ///< Размер входного файла.
+        int64_t input_mtime; ///< Время изменения входного файла в наносекундах.
+        uint64_t total; ///< Общее количество векторов.
+        uint64_t done; ///< Количество записанных результатов.
+    };
+
+    IOManager &io_man; ///< Менеджер ввода-вывода.
+    NetworkManager &net_man; ///< Менеджер сети.
+    std::array<std::string, 2> credentials; ///< Логин и пароль.
+    std::string input_path; ///< Путь к входному файлу.
+    std::string output_path; ///< Путь к выходному файлу.
+    size_t memory_limit; ///< Ограничение объёма порции.
+    bool huge_pages; ///< Флаг размещения порций в больших страницах.
+    unsigned retries; ///< Количество попыток переподключения подряд.
+    ResumeStats counters; ///< Счётчики обработки.
+
+    /**
+    * @brief Метод для чтения контрольной точки прошлого запуска.
+    * @param expected Контрольная точка текущего входного файла (с done = 0).
+    * @return Количество готовых результатов (0, если продолжить нельзя).
+    */
+    uint64_t loadCheckpoint(const Checkpoint &expected);
+
+    /**
+    * @brief Метод для записи контрольной точки.
+    * @param checkpoint Контрольная точка.
+    * @throw IOError Если запись не удалась.
+    */
+    void saveCheckpoint(Checkpoint checkpoint);
+
+    /**
+    * @brief Метод для подключения и аутентификации с повторными попытками.
+    * @param remaining Количество векторов, которые осталось отправить.
+    * @param attempt Номер первой попытки (0 - первое подключение).
+    * @throw NetworkError Если попытки исчерпаны.
+    * @throw AuthError Если попытки исчерпаны на аутентификации.
+    */
+    void connect(uint32_t remaining, unsigned attempt);
+};
+
+/// Обработка векторов из значений uint32_t с контрольными точками.
+typedef BasicResumableCalc<uint32_t> ResumableCalc;
+
+#endif // RESUME_H
@@ -0,0 +1,273 @@
+#include "shard.h"
+#include "pipeline.h"
+#include "log.h"
+#include "trace.h"
+#include <algorithm>
+#include <memory>
+#include <thread>
+#include <utility>
+
+// Конструктор буфера восстановления порядка
+template <typename T>
+BasicReorderBuffer<T>::BasicReorderBuffer(size_t window)
+    : next(0),
+      window(window > 0 ? window : 1),
+      aborted(false) {}
+
+// Метод для добавления порции результатов
+template <typename T>
+bool BasicReorderBuffer<T>::push(size_t index, std::vector<T> results)
+{
+    std::unique_lock<std::mutex> lock(this->mutex);
+    this->changed.wait(lock, [&]
+                       { return index < this->next + this->window || this->aborted; });
+    if (this->aborted)
+        return false;
+
+    this->pending[index] = std::move(results);
+    this->changed.notify_all();
+    return true;
+}
+
+// Метод для извлечения очередной по порядку порции
+template <typename T>
+bool BasicReorderBuffer<T>::pop(std::vector<T> &results)
+{
+    std::unique_lock<std::mutex> lock(this->mutex);
+    this->changed.wait(lock, [&]
+                       { return this->pending.count(this->next) > 0 || this->aborted; });
+    if (this->aborted)
+        return false;
+
+    auto it = this->pending.find(this->next);
+    results = std::move(it->second);
+    this->pending.erase(it);
+    ++this->next;
+    this->changed.notify_all();
+    return true;
+}
+
+// Метод для прерывания ожидания
+template <typename T>
+void BasicReorderBuffer<T>::abort()
+{
+    std::lock_guard<std::mutex> lock(this->mutex);
+    this->aborted = true;
+    this->changed.notify_all();
+}
+
+// Конструктор
+template <typename T>
+BasicShardedCalc<T>::BasicShardedCalc(
+    IOManager &io_man,
+    const std::string &address,
+    uint16_t port,
+    const std::array<std::string, 2> &credentials,
+    size_t connections,
+    size_t chunk_vectors,
+    size_t memory_limit,
+    size_t queue_depth,
+    bool huge_pages,
+    ResultCache *cache,
+    bool dedup)
+    : io_man(io_man),
+      address(address),
+      port(port),
+      credentials(credentials),
+      connections(connections > 0 ? connections : 1),
+      chunk_vectors(chunk_vectors > 0 ? chunk_vectors : 1),
+      memory_limit(memory_limit),
+      queue_depth(queue_depth > 0 ? queue_depth : 1),
+      huge_pages(huge_pages),
+      cache(cache),
+      dedup(dedup) {}
+
+// Метод для вычисления количества векторов сессии
+template <typename T>
+uint32_t BasicShardedCalc<T>::sessionCount(uint32_t total, size_t chunk_vectors, size_t connections, size_t session)
+{
+    uint64_t num_chunks = (static_cast<uint64_t>(total) + chunk_vectors - 1) / chunk_vectors;
+    if (num_chunks <= session)
+        return 0;
+
+    uint64_t session_chunks = (num_chunks - session + connections - 1) / connections;
+    uint64_t count = session_chunks * chunk_vectors;
+
+    // Последняя (неполная) порция принадлежит сессии (num_chunks - 1) mod N
+    if ((num_chunks - 1) % connections == session)
+        count -= num_chunks * chunk_vectors - total;
+
+    return static_cast<uint32_t>(count);
+}
+
+// Метод для запуска обработки
+template <typename T>
+void BasicShardedCalc<T>::run()
+{
+    typedef std::pair<size_t, BasicVectorBatch<T> *> Task;
+
+    // Ограничение памяти делится между всеми порциями пула
+    size_t pool_size = this->connections * (this->queue_depth + 1) + 1;
+    size_t chunk_limit = std::max<size_t>(this->memory_limit / pool_size, 1);
+    BasicVectorReader<T> reader = this->io_man.template reader<T>(chunk_limit);
+    uint32_t total = reader.count();
+    size_t num_chunks = (static_cast<size_t>(total) + this->chunk_vectors - 1) / this->chunk_vectors;
+    BasicResultWriter<T> writer = this->io_man.template writer<T>(total);
+
+    // Соли и хеши всех сессий вычисляются одним пакетом
+    std::vector<SaltHash> tokens(this->connections);
+    {
+        TraceSpan span("hash_batch", "crypto");
+        CryptManager::get_batch(this->credentials[1], tokens.data(), tokens.size());
+    }
+
+    // Открытие и аутентификация всех сессий
+    std::vector<std::unique_ptr<NetworkManager>> sessions;
+    for (size_t s = 0; s < this->connections; ++s)
+    {
+        sessions.emplace_back(new NetworkManager(this->address, this->port));
+        sessions.back()->setCache(this->cache);
+        sessions.back()->setDedup(this->dedup);
+        sessions.back()->conn();
+        sessions.back()->auth(this->credentials[0], tokens[s]);
+        sessions.back()->begin(sessionCount(total, this->chunk_vectors, this->connections, s));
+    }
+
+    // Пул порций и очереди сессий
+    std::vector<std::unique_ptr<BasicVectorBatch<T>>> pool;
+    BoundedQueue<BasicVectorBatch<T> *> free_queue(pool_size);
+    for (size_t i = 0; i < pool_size; ++i)
+    {
+        pool.emplace_back(new BasicVectorBatch<T>(this->huge_pages));
+        free_queue.push(pool.back().get());
+    }
+
+    std::vector<std::unique_ptr<BoundedQueue<Task>>> queues;
+    for (size_t s = 0; s < this->connections; ++s)
+        queues.emplace_back(new BoundedQueue<Task>(this->queue_depth));
+
+    BasicReorderBuffer<T> reorder(this->connections * (this->queue_depth + 1));
+
+    // Остановка всех потоков при первой ошибке
+    auto fail = [&](std::exception_ptr e)
+    {
+        {
+            std::lock_guard<std::mutex> lock(this->error_mutex);
+            if (!this->error)
+                this->error = e;
+        }
+        free_queue.close(true);
+        for (auto &queue : queues)
+            queue->close(true);
+        reorder.abort();
+        for (auto &session : sessions)
+            session->shutdown();
+    };
+
+    // Поток чтения: порция c отправляется в сессию c mod N
+    std::thread read_stage([&]
+                           {
+        if (Tracer::enabled())
+            Tracer::instance().nameThread("shard read");
+        try
+        {
+            // Части порций нумеруются подряд, порядок результатов восстанавливается по этим номерам
+            size_t part = 0;
+            bool accepting = true;
+            for (size_t c = 0; c < num_chunks && accepting; ++c)
+            {
+                size_t left = std::min<size_t>(this->chunk_vectors, total - c * this->chunk_vectors);
+                BasicVectorBatch<T> *batch;
+                while (left > 0 && (accepting = free_queue.pop(batch)))
+                {
+                    if (!reader.next(*batch, left))
+                        throw DataDecodeError("Unexpected end of input file", "ShardedCalc.run()");
+                    left -= batch->size();
+                    if (!(accepting = queues[c % this->connections]->push(Task(part++, batch))))
+                        break;
+                }
+            }
+            for (auto &queue : queues)
+                queue->close();
+        }
+        catch (...)
+        {
+            fail(std::current_exception());
+        } });
+
+    // Потоки сессий
+    std::vector<std::thread> session_stages;
+    for (size_t s = 0; s < this->connections; ++s)
+    {
+        session_stages.emplace_back([&, s]
+                                    {
+            if (Tracer::enabled())
+                Tracer::instance().nameThread("session " + std::to_string(s));
+            try
+            {
+                Task task;
+                while (queues[s]->pop(task))
+                {
+                    std::vector<T> results = sessions[s]->exchange(*task.second);
+                    if (!free_queue.push(task.second) || !reorder.push(task.first, std::move(results)))
+                        break;
+                }
+            }
+            catch (...)
+            {
+                fail(std::current_exception());
+            } });
+    }
+
+    // Запись результатов в исходном порядке выполняется в текущем потоке
+    try
+    {
+        std::vector<T> results;
+        for (size_t written = 0; written < total && reorder.pop(results); written += results.size())
+            writer.append(results);
+    }
+    catch (...)
+    {
+        fail(std::current_exception());
+    }
+
+    read_stage.join();
+    for (auto &stage : session_stages)
+        stage.join();
+
+    if (this->error)
+        std::rethrow_exception(this->error);
+    writer.close();
+
+    // Логирование количества системных вызовов всех сессий
+    SyscallStats total_stats = SyscallStats();
+    DedupStats total_dedup = DedupStats();
+    for (auto &session : sessions)
+    {
+        const SyscallStats &stats = session->stats();
+        total_stats.send_calls += stats.send_calls;
+        total_stats.recv_calls += stats.recv_calls;
+        total_stats.poll_calls += stats.poll_calls;
+        total_stats.bytes_sent += stats.bytes_sent;
+        total_stats.bytes_received += stats.bytes_received;
+        total_dedup.vectors += session->dedupStats().vectors;
+        total_dedup.unique += session->dedupStats().unique;
+        session->close();
+    }
+    LOG_INFO("ShardedCalc.run()", "Connections: " << this->connections
+                                                  << " Syscalls: send=" << total_stats.send_calls
+                                                  << " recv=" << total_stats.recv_calls
+                                                  << " poll=" << total_stats.poll_calls
+                                                  << " bytes_sent=" << total_stats.bytes_sent
+                                                  << " bytes_received=" << total_stats.bytes_received);
+    if (this->dedup && total_dedup.unique > 0)
+        LOG_INFO("ShardedCalc.run()", "Dedup: vectors=" << total_dedup.vectors
+                                                        << " unique=" << total_dedup.unique
+                                                        << " ratio=" << static_cast<double>(total_dedup.vectors) / total_dedup.unique);
+}
+
+// Явное инстанцирование для поддерживаемых типов данных
+#define INSTANTIATE_SHARD(T)              \
+    template class BasicReorderBuffer<T>; \
+    template class BasicShardedCalc<T>;
+FOR_EACH_DATA_TYPE(INSTANTIATE_SHARD)
@@ -0,0 +1,154 @@
+#ifndef SHARD_H
+#define SHARD_H
+
+#include <cstdint>
+#include <cstddef>
+#include <array>
+#include <map>
+#include <mutex>
+#include <condition_variable>
+#include <exception>
+#include <string>
+#include <vector>
+#include "io.h"
+#include "network.h"
+
+/**
+* @file shard.h
+* @brief Определения классов для обработки данных через несколько подключений.
+* @details Этот файл содержит определения буфера упорядочивания результатов и класса,
+* распределяющего порции векторов между несколькими сессиями с сервером.
+* @date 17.10.2026
+* @version 1.0
+* @authors Косов Р. С.
+* @copyright ИБСТ ПГУ
+*/
+
+/**
+* @brief Буфер восстановления порядка результатов.
+* @details Порции результатов поступают в произвольном порядке и выдаются
+* строго по возрастанию номера. Номер поступающей порции не может опережать
+* очередную выдаваемую более чем на размер окна, что ограничивает память.
+* @tparam T Тип результатов.
+*/
+template <typename T>
+class BasicReorderBuffer
+{
+public:
+    /**
+    * @brief Конструктор класса BasicReorderBuffer.
+    * @param window Максимальное опережение номера порции.
+    */
+    explicit BasicReorderBuffer(size_t window);
+
+    /**
+    * @brief Метод для добавления порции результатов (блокируется, пока порция вне окна).
+    * @param index Номер порции.
+    * @param results Результаты порции.
+    * @return false, если буфер прерван.
+    */
+    bool push(size_t index, std::vector<T> results);
+
+    /**
+    * @brief Метод для извлечения очередной по порядку порции результатов.
+    * @param results Результаты порции.
+    * @return false, если буфер прерван.
+    */
+    bool pop(std::vector<T> &results);
+
+    /**
+    * @brief Метод для прерывания ожидания во всех потоках.
+    */
+    void abort();
+
+private:
+    std::mutex mutex; ///< Мьютекс буфера.
+    std::condition_variable changed; ///< Условие изменения состояния буфера.
+    std::map<size_t, std::vector<T>> pending; ///< Порции, ожидающие выдачи.
+    size_t next; ///< Номер очередной выдаваемой порции.
+    size_t window; ///< Размер окна.
+    bool aborted; ///< Флаг прерывания.
+};
+
+/**
+* @brief Класс для обработки входного файла через несколько подключений.
+* @details Векторы разбиваются на порции фиксированного размера, порция с номером c
+* отправляется в сессию c mod N. Поэтому количество векторов каждой сессии
+* известно заранее, а результаты собираются в исходном порядке через BasicReorderBuffer.
+* Порция, не помещающаяся в долю ограничения памяти на одну порцию пула, читается
+* и отправляется в ту же сессию несколькими частями.
+* @tparam T Тип значений векторов.
+*/
+template <typename T>
+class BasicShardedCalc
+{
+public:
+    /**
+    * @brief Конструктор класса BasicShardedCalc.
+    * @param io_man Менеджер ввода-вывода.
+    * @param address Адрес сервера.
+    * @param port Порт сервера.
+    * @param credentials Логин и пароль.
+    * @param connections Количество подключений.
+    * @param chunk_vectors Количество векторов в порции.
+    * @param memory_limit Ограничение объёма всех порций в пуле (в байтах).
+    * @param queue_depth Длина очереди порций каждой сессии.
+    * @param huge_pages Размещать ли порции в больших страницах памяти.
+    * @param cache Кеш результатов, общий для всех сессий (nullptr - без кеша).
+    * @param dedup Устранять ли повторы внутри порций.
+    */
+    BasicShardedCalc(
+        IOManager &io_man,
+        const std::string &address,
+        uint16_t port,
+        const std::array<std::string, 2> &credentials,
+        size_t connections,
+        size_t chunk_vectors,
+        size_t memory_limit,
+        size_t queue_depth,
+        bool huge_pages,
+        ResultCache *cache = nullptr,
+        bool dedup = false);
+
+    /**
+    * @brief Метод для запуска обработки.
+    * @throw IOError Если произошла ошибка ввода-вывода.
+    * @throw AuthError Если не удалась аутентификация какой-либо сессии.
+    * @throw NetworkError Если произошла сетевая ошибка.
+    */
+    void run();
+
+    /**
+    * @brief Метод для вычисления количества векторов сессии.
+    * @param total Общее количество векторов.
+    * @param chunk_vectors Количество векторов в порции.
+    * @param connections Количество подключений.
+    * @param session Номер сессии.
+    * @return Количество векторов, отправляемых в сессию.
+    */
+    static uint32_t sessionCount(uint32_t total, size_t chunk_vectors, size_t connections, size_t session);
+
+private:
+    IOManager &io_man; ///< Менеджер ввода-вывода.
+    std::string address; ///< Адрес сервера.
+    uint16_t port; ///< Порт сервера.
+    std::array<std::string, 2> credentials; ///< Логин и пароль.
+    size_t connections; ///< Количество подключений.
+    size_t chunk_vectors; ///< Количество векторов в порции.
+    size_t memory_limit; ///< Ограничение объёма всех порций в пуле.
+    size_t queue_depth; ///< Длина очереди порций каждой сессии.
+    bool huge_pages; ///< Флаг размещения порций в больших страницах.
+    ResultCache *cache; ///< Кеш результатов (nullptr - без кеша).
+    bool dedup; ///< Флаг устранения повторов внутри порций.
+
+    std::mutex error_mutex; ///< Мьютекс первой ошибки.
+    std::exception_ptr error; ///< Первая ошибка, возникшая в любом из потоков.
+};
+
+/// Буфер восстановления порядка результатов uint32_t.
+typedef BasicReorderBuffer<uint32_t> ReorderBuffer;
+
+/// Обработка векторов из значений uint32_t через несколько подключений.
+typedef BasicShardedCalc<uint32_t> ShardedCalc;
+
+#endif // SHARD_H
@@ -0,0 +1,275 @@
+#include "text.h"
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <fstream>
+#include <thread>
+#include "trace.h"
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Объём строк значений, разбираемых за один раунд
+static const size_t ROUND_BYTES = 16 * 1024 * 1024;
+
+// Минимальный объём строк на один поток разбора
+static const size_t SLICE_BYTES = 1024 * 1024;
+
+// Функция для пропуска разделителей значений
+static const char *skipBlanks(const char *p, const char *end)
+{
+    while (p < end && (*p == ' ' || *p == '\t' || *p == '\r'))
+        ++p;
+    return p;
+}
+
+// Функция для разбора строки из одного беззнакового числа
+static bool parseNumberLine(const char *&p, const char *end, uint32_t &value)
+{
+    std::from_chars_result res = std::from_chars(p, end, value);
+    if (res.ec != std::errc() || res.ptr == p)
+        return false;
+    const char *q = res.ptr;
+    if (q < end && *q == '\r')
+        ++q;
+    if (q < end && *q != '\n')
+        return false;
+    p = q < end ? q + 1 : q;
+    return true;
+}
+
+// Функция для проверки, записан ли файл в текстовом формате
+bool isTextFile(const std::string &path)
+{
+    std::ifstream input_file(path, std::ios::binary);
+    char head[64];
+    input_file.read(head, sizeof(head));
+    const char *p = head;
+    const char *end = head + input_file.gcount();
+
+    // Строка количества и строка размера первого вектора должны быть числами;
+    // строка, обрезанная концом буфера, не считается
+    uint32_t value;
+    const char *line_end = static_cast<const char *>(std::memchr(p, '\n', end - p));
+    if (line_end == nullptr || !parseNumberLine(p, line_end + 1, value))
+        return false;
+    if (p == end)
+        return input_file.eof();
+    line_end = static_cast<const char *>(std::memchr(p, '\n', end - p));
+    return line_end != nullptr && parseNumberLine(p, line_end + 1, value);
+}
+
+// Функция для разбора строки значений вектора
+template <typename T>
+bool parseTextValues(const char *begin, const char *end, T *values, uint32_t size)
+{
+    const char *p = skipBlanks(begin, end);
+    for (uint32_t k = 0; k < size; ++k)
+    {
+        std::from_chars_result res = std::from_chars(p, end, values[k]);
+        if (res.ec != std::errc())
+            return false;
+        // За значением должен следовать разделитель или конец строки
+        if (res.ptr < end && *res.ptr != ' ' && *res.ptr != '\t' && *res.ptr != '\r')
+            return false;
+        p = skipBlanks(res.ptr, end);
+    }
+    return p == end;
+}
+
+// Конструктор
+template <typename T>
+BasicTextInput<T>::BasicTextInput(const std::string &path, unsigned threads)
+    : fd(-1),
+      base(nullptr),
+      length(0),
+      position(0),
+      num_vectors(0),
+      num_read(0),
+      threads(threads > 0 ? threads : std::max(1u, std::thread::hardware_concurrency()))
+{
+    this->fd = ::open(path.c_str(), O_RDONLY);
+    if (this->fd < 0)
+    {
+        throw IOError("Failed to open input file for reading.", "TextInput.TextInput()");
+    }
+
+    struct stat st;
+    if (fstat(this->fd, &st) < 0)
+    {
+        ::close(this->fd);
+        throw IOError("Failed to get size of input file", "TextInput.TextInput()");
+    }
+    this->length = st.st_size;
+    if (this->length == 0)
+    {
+        ::close(this->fd);
+        throw DataDecodeError("Failed to read number of vectors", "TextInput.TextInput()");
+    }
+
+    void *mem = mmap(nullptr, this->length, PROT_READ, MAP_SHARED, this->fd, 0);
+    if (mem == MAP_FAILED)
+    {
+        ::close(this->fd);
+        throw IOError("Failed to map input file", "TextInput.TextInput()");
+    }
+    this->base = static_cast<const char *>(mem);
+    madvise(mem, this->length, MADV_SEQUENTIAL);
+
+    // Чтение количества векторов
+    const char *p = this->base;
+    if (!parseNumberLine(p, this->base + this->length, this->num_vectors))
+    {
+        munmap(mem, this->length);
+        ::close(this->fd);
+        throw DataDecodeError("Failed to read number of vectors", "TextInput.TextInput()");
+    }
+    this->position = p - this->base;
+}
+
+// Деструктор
+template <typename T>
+BasicTextInput<T>::~BasicTextInput()
+{
+    if (this->base != nullptr)
+        munmap(const_cast<char *>(this->base), this->length);
+    if (this->fd >= 0)
+        ::close(this->fd);
+}
+
+template <typename T>
+uint32_t BasicTextInput<T>::count() const
+{
+    return this->num_vectors;
+}
+
+// Метод для чтения очередных векторов в порцию
+template <typename T>
+size_t BasicTextInput<T>::read(size_t max_vectors, size_t memory_limit, BasicVectorBatch<T> &chunk)
+{
+    chunk.clear();
+    size_t chunk_bytes = 0;
+    const char *end = this->base + this->length;
+    bool full = false;
+
+    while (!full && this->num_read < this->num_vectors && chunk.size() < max_vectors)
+    {
+        // Границы строк ищутся последовательно - это намного быстрее разбора
+        this->lines.clear();
+        size_t text_bytes = 0;
+        size_t num_values = 0;
+        const char *p = this->base + this->position;
+        while (this->num_read + this->lines.size() < this->num_vectors &&
+               chunk.size() + this->lines.size() < max_vectors &&
+               text_bytes < ROUND_BYTES)
+        {
+            uint32_t vector = this->num_read + this->lines.size();
+            if (p == end)
+            {
+                throw DataDecodeError("Unexpected end of input file", "TextInput.read()");
+            }
+            uint32_t size;
+            const char *q = p;
+            if (!parseNumberLine(q, end, size))
+            {
+                throw DataDecodeError(
+                    "Malformed size of vector " + std::to_string(vector),
+                    "TextInput.read()");
+            }
+            if (q == end && size > 0)
+            {
+                throw DataDecodeError("Unexpected end of input file", "TextInput.read()");
+            }
+
+            // Порция заполнена - вектор остаётся для следующей порции
+            size_t vector_bytes = static_cast<size_t>(size) * sizeof(T);
+            if ((!chunk.empty() || !this->lines.empty()) && chunk_bytes + vector_bytes > memory_limit)
+            {
+                full = true;
+                break;
+            }
+
+            const char *line_end = static_cast<const char *>(std::memchr(q, '\n', end - q));
+            if (line_end == nullptr)
+                line_end = end;
+            this->lines.push_back(Line{q, line_end, size, nullptr});
+            chunk_bytes += vector_bytes;
+            num_values += size;
+            text_bytes += line_end - q;
+            p = line_end < end ? line_end + 1 : end;
+        }
+        if (this->lines.empty())
+            break;
+
+        // Место под значения выделяется до разбора, потоки пишут в свои векторы
+        chunk.reserve(chunk.size() + this->lines.size(),
+                      std::max(chunk.values() + num_values, 2 * chunk.values()));
+        for (Line &line : this->lines)
+            line.values = chunk.append(line.size);
+
+        this->parse(this->num_read, text_bytes);
+        this->num_read += this->lines.size();
+        this->position = p - this->base;
+    }
+
+    return chunk.size();
+}
+
+// Метод для разбора строк значений в несколько потоков
+template <typename T>
+void BasicTextInput<T>::parse(uint32_t first, size_t text_bytes)
+{
+    size_t workers = std::min<size_t>(this->threads, std::max<size_t>(1, text_bytes / SLICE_BYTES));
+
+    // Строки делятся на диапазоны примерно равной длины
+    std::vector<size_t> bounds(1, 0);
+    size_t acc = 0;
+    for (size_t i = 0; i < this->lines.size() && bounds.size() < workers; ++i)
+    {
+        acc += this->lines[i].end - this->lines[i].begin;
+        if (acc * workers >= text_bytes * bounds.size())
+            bounds.push_back(i + 1);
+    }
+    bounds.push_back(this->lines.size());
+
+    std::vector<size_t> failed(bounds.size() - 1, SIZE_MAX);
+    auto work = [this, &bounds, &failed](size_t w)
+    {
+        TraceSpan span("parse", "io");
+        for (size_t i = bounds[w]; i < bounds[w + 1]; ++i)
+        {
+            const Line &line = this->lines[i];
+            if (!parseTextValues(line.begin, line.end, line.values, line.size))
+            {
+                failed[w] = i;
+                return;
+            }
+        }
+    };
+
+    std::vector<std::thread> pool;
+    for (size_t w = 1; w < failed.size(); ++w)
+        pool.emplace_back([&work, w]
+                          {
+            if (Tracer::enabled())
+                Tracer::instance().nameThread("parse " + std::to_string(w));
+            work(w); });
+    work(0);
+    for (std::thread &t : pool)
+        t.join();
+
+    size_t bad = *std::min_element(failed.begin(), failed.end());
+    if (bad != SIZE_MAX)
+    {
+        throw DataDecodeError(
+            "Malformed values of vector " + std::to_string(first + bad),
+            "TextInput.read()");
+    }
+}
+
+// Явное инстанцирование для поддерживаемых типов данных
+#define INSTANTIATE_TEXT(T)                                                  \
+    template bool parseTextValues<T>(const char *, const char *, T *, uint32_t); \
+    template class BasicTextInput<T>;
+FOR_EACH_DATA_TYPE(INSTANTIATE_TEXT)
@@ -0,0 +1,126 @@
+#ifndef TEXT_INPUT_H
+#define TEXT_INPUT_H
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <vector>
+#include "batch.h"
+#include "errors.h"
+#include "types.h"
+
+/**
+* @file text.h
+* @brief Определения классов для чтения текстового формата входных файлов.
+* @details Текстовый формат (filer -ft txt) состоит из строк:
+* - количество векторов;
+* - для каждого вектора строка с размером и строка со значениями через пробел.
+* Файл отображается в память. Порция читается в два прохода: сначала
+* последовательно находятся границы строк (memchr), затем строки значений
+* делятся на диапазоны по границам строк и разбираются std::from_chars
+* в нескольких потоках прямо в буфер порции.
+* @date 17.10.2026
+* @version 1.0
+* @authors Косов Р. С.
+* @copyright ИБСТ ПГУ
+*/
+
+/**
+* @brief Функция для проверки, записан ли файл в текстовом формате.
+* @details Файл считается текстовым, если первая строка (количество векторов)
+* состоит только из цифр и за ней следует конец файла или строка размера,
+* также состоящая только из цифр.
+* @param path Путь к файлу.
+* @return true, если файл начинается с текстового заголовка.
+*/
+bool isTextFile(const std::string &path);
+
+/**
+* @brief Функция для разбора строки значений вектора.
+* @details Значения разделяются пробелами или табуляциями, в конце строки
+* допускаются пробелы и '\r'.
+* @tparam T Тип значений.
+* @param begin Начало строки.
+* @param end Конец строки (без '\n').
+* @param values Буфер для значений.
+* @param size Ожидаемое количество значений.
+* @return true, если строка содержит ровно size корректных значений типа T.
+*/
+template <typename T>
+bool parseTextValues(const char *begin, const char *end, T *values, uint32_t size);
+
+/**
+* @brief Класс для последовательного чтения файла в текстовом формате.
+* @tparam T Тип значений векторов.
+*/
+template <typename T>
+class BasicTextInput
+{
+public:
+    /**
+    * @brief Конструктор класса BasicTextInput.
+    * @param path Путь к файлу.
+    * @param threads Количество потоков разбора (0 - по числу ядер).
+    * @throw IOError Если не удалось открыть или отобразить файл.
+    * @throw DataDecodeError Если не удалось прочитать количество векторов.
+    */
+    explicit BasicTextInput(const std::string &path, unsigned threads = 0);
+
+    BasicTextInput(const BasicTextInput &) = delete;
+    BasicTextInput &operator=(const BasicTextInput &) = delete;
+
+    /**
+    * @brief Деструктор класса BasicTextInput.
+    */
+    ~BasicTextInput();
+
+    /**
+    * @brief Метод для получения количества векторов.
+    * @return Количество векторов.
+    */
+    uint32_t count() const;
+
+    /**
+    * @brief Метод для чтения очередных векторов в порцию.
+    * @param max_vectors Максимальное количество векторов в порции.
+    * @param memory_limit Ограничение объёма значений в порции (в байтах).
+    * @param chunk Порция векторов (очищается перед заполнением).
+    * @return Количество прочитанных векторов (0, если все векторы прочитаны).
+    * @throw DataDecodeError Если файл обрывается раньше времени или строка не разбирается.
+    */
+    size_t read(size_t max_vectors, size_t memory_limit, BasicVectorBatch<T> &chunk);
+
+private:
+    /**
+    * @brief Строка значений одного вектора.
+    */
+    struct Line
+    {
+        const char *begin; ///< Начало строки значений.
+        const char *end; ///< Конец строки значений (без '\n').
+        uint32_t size; ///< Количество значений.
+        T *values; ///< Место для значений в порции.
+    };
+
+    int fd; ///< Дескриптор файла.
+    const char *base; ///< Начало отображения.
+    size_t length; ///< Длина файла в байтах.
+    size_t position; ///< Смещение первого непрочитанного вектора.
+    uint32_t num_vectors; ///< Количество векторов.
+    uint32_t num_read; ///< Количество прочитанных векторов.
+    unsigned threads; ///< Количество потоков разбора.
+    std::vector<Line> lines; ///< Строки текущего раунда разбора.
+
+    /**
+    * @brief Метод для разбора строк значений в несколько потоков.
+    * @param first Номер вектора первой строки (для сообщения об ошибке).
+    * @param text_bytes Суммарная длина строк.
+    * @throw DataDecodeError Если строка не разбирается.
+    */
+    void parse(uint32_t first, size_t text_bytes);
+};
+
+/// Чтение текстового файла из значений uint32_t.
+typedef BasicTextInput<uint32_t> TextInput;
+
+#endif // TEXT_INPUT_H
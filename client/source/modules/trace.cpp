@@ -0,0 +1,222 @@
+#include "trace.h"
+#include "log.h"
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <unistd.h>
+
+std::atomic<bool> Tracer::active(false);
+
+// Буферы принадлежат Tracer и переживают свои потоки
+thread_local Tracer::ThreadBuffer *Tracer::current = nullptr;
+
+// Функция для экранирования строки JSON
+static std::string jsonEscape(const std::string &text)
+{
+    std::string escaped;
+    for (char c : text)
+    {
+        if (c == '"' || c == '\\')
+            escaped += '\\';
+        if (static_cast<unsigned char>(c) >= 0x20)
+            escaped += c;
+    }
+    return escaped;
+}
+
+// Функция для записи времени в микросекундах относительно начала шкалы
+static void micros(std::ostringstream &out, int64_t nanos)
+{
+    if (nanos < 0)
+    {
+        out << '-';
+        nanos = -nanos;
+    }
+    char fraction[4];
+    std::snprintf(fraction, sizeof(fraction), "%03d", static_cast<int>(nanos % 1000));
+    out << nanos / 1000 << '.' << fraction;
+}
+
+// Конструктор
+Tracer::Tracer()
+    : started(monotonicNanos()) {}
+
+Tracer &Tracer::instance()
+{
+    static Tracer tracer;
+    return tracer;
+}
+
+void Tracer::enable(bool on)
+{
+    active.store(on, std::memory_order_relaxed);
+}
+
+// Метод для получения буфера текущего потока
+Tracer::ThreadBuffer &Tracer::local()
+{
+    if (current == nullptr)
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        std::unique_ptr<ThreadBuffer> buffer(new ThreadBuffer());
+        buffer->tid = static_cast<uint32_t>(this->buffers.size() + 1);
+        buffer->name = "thread " + std::to_string(buffer->tid);
+        buffer->size.store(0, std::memory_order_relaxed);
+        buffer->lost.store(0, std::memory_order_relaxed);
+        current = buffer.get();
+        this->buffers.push_back(std::move(buffer));
+    }
+    return *current;
+}
+
+// Метод для записи интервала в буфер текущего потока
+void Tracer::record(const char *name, const char *category, uint64_t start, uint64_t end,
+                    uint64_t bytes, uint64_t vectors)
+{
+    ThreadBuffer &buffer = this->local();
+    size_t size = buffer.size.load(std::memory_order_relaxed);
+    if (size >= MAX_EVENTS)
+    {
+        buffer.lost.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    // Новый блок выделяется раз в CHUNK_EVENTS событий
+    if (size / CHUNK_EVENTS >= buffer.chunks.size())
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        buffer.chunks.emplace_back(new Event[CHUNK_EVENTS]);
+    }
+
+    Event &event = buffer.chunks[size / CHUNK_EVENTS][size % CHUNK_EVENTS];
+    event.name = name;
+    event.category = category;
+    event.start = start;
+    event.duration = end - start;
+    event.bytes = bytes;
+    event.vectors = vectors;
+    buffer.size.store(size + 1, std::memory_order_release);
+}
+
+// Метод для задания имени дорожки текущего потока
+void Tracer::nameThread(const std::string &name)
+{
+    ThreadBuffer &buffer = this->local();
+    std::lock_guard<std::mutex> lock(this->mutex);
+    buffer.name = name;
+}
+
+// Метод для очистки записанных интервалов
+void Tracer::reset()
+{
+    std::lock_guard<std::mutex> lock(this->mutex);
+    for (auto &buffer : this->buffers)
+    {
+        buffer->size.store(0, std::memory_order_relaxed);
+        buffer->lost.store(0, std::memory_order_relaxed);
+    }
+    this->started.store(monotonicNanos(), std::memory_order_relaxed);
+}
+
+uint64_t Tracer::count() const
+{
+    std::lock_guard<std::mutex> lock(this->mutex);
+    uint64_t total = 0;
+    for (auto &buffer : this->buffers)
+        total += buffer->size.load(std::memory_order_acquire);
+    return total;
+}
+
+uint64_t Tracer::dropped() const
+{
+    std::lock_guard<std::mutex> lock(this->mutex);
+    uint64_t total = 0;
+    for (auto &buffer : this->buffers)
+        total += buffer->lost.load(std::memory_order_relaxed);
+    return total;
+}
+
+// Метод для формирования шкалы в формате Chrome trace-event JSON
+std::string Tracer::toJson() const
+{
+    std::lock_guard<std::mutex> lock(this->mutex);
+    int64_t origin = static_cast<int64_t>(this->started.load(std::memory_order_relaxed));
+    int pid = static_cast<int>(getpid());
+    uint64_t lost = 0;
+
+    std::ostringstream out;
+    out << "{\"displayTimeUnit\": \"ns\", \"traceEvents\": [\n";
+    out << "{\"name\": \"process_name\", \"ph\": \"M\", \"pid\": " << pid
+        << ", \"tid\": 0, \"args\": {\"name\": \"vclient\"}}";
+    for (auto &buffer : this->buffers)
+    {
+        size_t size = buffer->size.load(std::memory_order_acquire);
+        lost += buffer->lost.load(std::memory_order_relaxed);
+        if (size == 0)
+            continue;
+
+        out << ",\n{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": " << pid
+            << ", \"tid\": " << buffer->tid
+            << ", \"args\": {\"name\": \"" << jsonEscape(buffer->name) << "\"}}";
+        for (size_t i = 0; i < size; ++i)
+        {
+            const Event &event = buffer->chunks[i / CHUNK_EVENTS][i % CHUNK_EVENTS];
+            out << ",\n{\"name\": \"" << event.name << "\", \"cat\": \"" << event.category
+                << "\", \"ph\": \"X\", \"pid\": " << pid << ", \"tid\": " << buffer->tid << ", \"ts\": ";
+            micros(out, static_cast<int64_t>(event.start) - origin);
+            out << ", \"dur\": ";
+            micros(out, static_cast<int64_t>(event.duration));
+            if (event.bytes != 0 || event.vectors != 0)
+                out << ", \"args\": {\"bytes\": " << event.bytes << ", \"vectors\": " << event.vectors << "}";
+            out << "}";
+        }
+    }
+    out << "\n], \"otherData\": {\"dropped_events\": " << lost << "}}\n";
+    return out.str();
+}
+
+// Метод для атомарной записи шкалы в файл
+void Tracer::writeFile(const std::string &path) const
+{
+    std::string temp_path = path + ".tmp";
+    std::ofstream output_file(temp_path, std::ios::binary | std::ios::trunc);
+    output_file << this->toJson();
+    output_file.close();
+    if (!output_file || std::rename(temp_path.c_str(), path.c_str()) != 0)
+    {
+        std::remove(temp_path.c_str());
+        throw IOError("Failed to write trace file \"" + path + "\"", "Tracer.writeFile()");
+    }
+}
+
+// Конструктор сеанса записи
+TraceSession::TraceSession(const std::string &path)
+    : path(path)
+{
+    if (this->path.empty())
+        return;
+    Tracer::instance().reset();
+    Tracer::instance().nameThread("main");
+    Tracer::enable(true);
+}
+
+// Деструктор сеанса записи
+TraceSession::~TraceSession()
+{
+    if (this->path.empty())
+        return;
+    Tracer::enable(false);
+
+    // Шкала записывается и при завершении с ошибкой
+    try
+    {
+        Tracer &tracer = Tracer::instance();
+        tracer.writeFile(this->path);
+        LOG_INFO("TraceSession.~TraceSession()", "Trace: " << this->path << " events=" << tracer.count()
+                                                           << " dropped=" << tracer.dropped());
+    }
+    catch (const IOError &e)
+    {
+        LOG_ERROR("TraceSession.~TraceSession()", e.what());
+    }
+}
@@ -0,0 +1,233 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "errors.h"
+
+/**
+* @file trace.h
+* @brief Определения классов для записи временной шкалы работы клиента.
+* @details Интервалы (фазы работы, пакеты отправки и приёма, вычисление хешей)
+* записываются в буфер своего потока без блокировок и выгружаются в формате
+* Chrome trace-event JSON, который открывается в Perfetto и chrome://tracing.
+* Каждому потоку соответствует отдельная дорожка, поэтому видно, как чтение,
+* хеширование и обмен с сервером перекрываются и где возникают простои.
+* Пока запись не включена, интервалы не читают часы.
+* @date 17.10.2026
+* @version 1.0
+* @authors Косов Р. С.
+* @copyright ИБСТ ПГУ
+*/
+
+/**
+* @brief Функция для получения монотонного времени.
+* @return Время в наносекундах.
+*/
+inline uint64_t monotonicNanos()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+/**
+* @brief Класс для записи интервалов временной шкалы.
+*/
+class Tracer
+{
+public:
+    /// Количество событий в одном блоке буфера потока.
+    static const size_t CHUNK_EVENTS = 1024;
+
+    /// Наибольшее количество событий одного потока (остальные отбрасываются).
+    static const size_t MAX_EVENTS = 1 << 20;
+
+    /**
+    * @brief Метод для получения единственного экземпляра.
+    * @return Журнал интервалов.
+    */
+    static Tracer &instance();
+
+    /**
+    * @brief Метод для проверки, включена ли запись интервалов.
+    * @return true, если интервалы записываются.
+    */
+    static bool enabled()
+    {
+        return active.load(std::memory_order_relaxed);
+    }
+
+    /**
+    * @brief Метод для включения или отключения записи интервалов.
+    * @param on Включить ли запись.
+    */
+    static void enable(bool on);
+
+    /**
+    * @brief Метод для записи завершённого интервала в буфер текущего потока.
+    * @param name Название интервала (строковый литерал).
+    * @param category Категория интервала (строковый литерал).
+    * @param start Время начала в наносекундах.
+    * @param end Время окончания в наносекундах.
+    * @param bytes Количество обработанных байтов.
+    * @param vectors Количество обработанных векторов.
+    */
+    void record(const char *name, const char *category, uint64_t start, uint64_t end,
+                uint64_t bytes = 0, uint64_t vectors = 0);
+
+    /**
+    * @brief Метод для задания имени дорожки текущего потока.
+    * @param name Имя потока.
+    */
+    void nameThread(const std::string &name);
+
+    /**
+    * @brief Метод для очистки записанных интервалов.
+    * @details Начало шкалы переносится на текущий момент.
+    */
+    void reset();
+
+    /**
+    * @brief Метод для получения количества записанных интервалов.
+    * @return Количество интервалов во всех потоках.
+    */
+    uint64_t count() const;
+
+    /**
+    * @brief Метод для получения количества отброшенных интервалов.
+    * @return Количество интервалов, не поместившихся в буферы.
+    */
+    uint64_t dropped() const;
+
+    /**
+    * @brief Метод для формирования шкалы в формате Chrome trace-event JSON.
+    * @return Текст JSON.
+    */
+    std::string toJson() const;
+
+    /**
+    * @brief Метод для атомарной записи шкалы в файл (через временный файл и rename).
+    * @param path Путь к файлу.
+    * @throw IOError Если не удалось записать файл.
+    */
+    void writeFile(const std::string &path) const;
+
+    Tracer(const Tracer &) = delete;
+    Tracer &operator=(const Tracer &) = delete;
+
+private:
+    /**
+    * @brief Запись об одном интервале.
+    */
+    struct Event
+    {
+        const char *name; ///< Название интервала.
+        const char *category; ///< Категория интервала.
+        uint64_t start; ///< Время начала в наносекундах.
+        uint64_t duration; ///< Длительность в наносекундах.
+        uint64_t bytes; ///< Количество байтов.
+        uint64_t vectors; ///< Количество векторов.
+    };
+
+    /**
+    * @brief Буфер интервалов одного потока.
+    * @details Пишет только поток-владелец; количество событий публикуется
+    * атомарно, поэтому выгрузка возможна одновременно с записью.
+    */
+    struct ThreadBuffer
+    {
+        uint32_t tid; ///< Номер дорожки.
+        std::string name; ///< Имя потока.
+        std::vector<std::unique_ptr<Event[]>> chunks; ///< Блоки событий.
+        std::atomic<size_t> size; ///< Количество записанных событий.
+        std::atomic<uint64_t> lost; ///< Количество отброшенных событий.
+    };
+
+    static std::atomic<bool> active; ///< Флаг записи интервалов.
+    static thread_local ThreadBuffer *current; ///< Буфер текущего потока.
+
+    mutable std::mutex mutex; ///< Мьютекс списка буферов, имён и блоков.
+    std::vector<std::unique_ptr<ThreadBuffer>> buffers; ///< Буферы всех потоков.
+    std::atomic<uint64_t> started; ///< Начало шкалы.
+
+    /**
+    * @brief Конструктор класса Tracer.
+    */
+    Tracer();
+
+    /**
+    * @brief Метод для получения буфера текущего потока.
+    * @return Буфер, созданный при первом обращении потока.
+    */
+    ThreadBuffer &local();
+};
+
+/**
+* @brief Класс интервала, записываемого при выходе из области видимости.
+* @details Интервал записывается и при выходе по исключению.
+*/
+class TraceSpan
+{
+public:
+    /**
+    * @brief Конструктор класса TraceSpan.
+    * @param name Название интервала (строковый литерал).
+    * @param category Категория интервала (строковый литерал).
+    */
+    TraceSpan(const char *name, const char *category)
+        : name(name),
+          category(category),
+          started(Tracer::enabled() ? monotonicNanos() : 0) {}
+
+    /**
+    * @brief Деструктор класса TraceSpan.
+    */
+    ~TraceSpan()
+    {
+        if (this->started != 0)
+            Tracer::instance().record(this->name, this->category, this->started, monotonicNanos());
+    }
+
+    TraceSpan(const TraceSpan &) = delete;
+    TraceSpan &operator=(const TraceSpan &) = delete;
+
+private:
+    const char *name; ///< Название интервала.
+    const char *category; ///< Категория интервала.
+    uint64_t started; ///< Время начала (0 - запись не включена).
+};
+
+/**
+* @brief Класс сеанса записи временной шкалы.
+* @details Включает запись, если задан путь, и записывает файл при уничтожении,
+* в том числе при завершении с ошибкой.
+*/
+class TraceSession
+{
+public:
+    /**
+    * @brief Конструктор класса TraceSession.
+    * @param path Путь к файлу шкалы (пустой - не записывать).
+    */
+    explicit TraceSession(const std::string &path);
+
+    /**
+    * @brief Деструктор класса TraceSession.
+    */
+    ~TraceSession();
+
+    TraceSession(const TraceSession &) = delete;
+    TraceSession &operator=(const TraceSession &) = delete;
+
+private:
+    std::string path; ///< Путь к файлу шкалы.
+};
+
+#endif // TRACE_H
@@ -0,0 +1,50 @@
+#include "types.h"
+#include "errors.h"
+
+// Функция для разбора имени типа данных
+DataType parseDataType(const std::string &name)
+{
+    if (name == "uint16_t")
+        return DataType::UINT16;
+    if (name == "int16_t")
+        return DataType::INT16;
+    if (name == "uint32_t")
+        return DataType::UINT32;
+    if (name == "int32_t")
+        return DataType::INT32;
+    if (name == "uint64_t")
+        return DataType::UINT64;
+    if (name == "int64_t")
+        return DataType::INT64;
+    if (name == "float")
+        return DataType::FLOAT;
+    if (name == "double")
+        return DataType::DOUBLE;
+
+    throw ArgsDecodeError("Unsupported data type: " + name, "parseDataType()");
+}
+
+// Функция для получения имени типа данных
+const char *dataTypeName(DataType type)
+{
+    switch (type)
+    {
+    case DataType::UINT16:
+        return "uint16_t";
+    case DataType::INT16:
+        return "int16_t";
+    case DataType::UINT32:
+        return "uint32_t";
+    case DataType::INT32:
+        return "int32_t";
+    case DataType::UINT64:
+        return "uint64_t";
+    case DataType::INT64:
+        return "int64_t";
+    case DataType::FLOAT:
+        return "float";
+    case DataType::DOUBLE:
+        return "double";
+    }
+    return "unknown";
+}
@@ -0,0 +1,78 @@
+#ifndef DATA_TYPES_H
+#define DATA_TYPES_H
+
+#include <cstdint>
+#include <string>
+
+/**
+* @file types.h
+* @brief Определения поддерживаемых типов данных векторов.
+* @details Этот файл содержит перечисление типов значений векторов, функцию разбора
+* имени типа и макрос для явного инстанцирования шаблонов для всех типов.
+* @date 17.10.2026
+* @version 1.0
+* @authors Косов Р. С.
+* @copyright ИБСТ ПГУ
+*/
+
+/**
+* @brief Тип значений векторов.
+*/
+enum class DataType
+{
+    UINT16, ///< uint16_t
+    INT16,  ///< int16_t
+    UINT32, ///< uint32_t
+    INT32,  ///< int32_t
+    UINT64, ///< uint64_t
+    INT64,  ///< int64_t
+    FLOAT,  ///< float
+    DOUBLE  ///< double
+};
+
+/**
+* @brief Функция для разбора имени типа данных.
+* @param name Имя типа (как у параметра -T сервера: uint16_t, ..., double).
+* @return Тип данных.
+* @throw ArgsDecodeError Если тип не поддерживается.
+*/
+DataType parseDataType(const std::string &name);
+
+/**
+* @brief Функция для получения имени типа данных.
+* @param type Тип данных.
+* @return Имя типа.
+*/
+const char *dataTypeName(DataType type);
+
+/**
+* @brief Тип данных, соответствующий типу значений T.
+* @tparam T Тип значений векторов.
+*/
+template <typename T>
+struct DataTypeOf;
+
+template <> struct DataTypeOf<uint16_t> { static const DataType value = DataType::UINT16; };
+template <> struct DataTypeOf<int16_t> { static const DataType value = DataType::INT16; };
+template <> struct DataTypeOf<uint32_t> { static const DataType value = DataType::UINT32; };
+template <> struct DataTypeOf<int32_t> { static const DataType value = DataType::INT32; };
+template <> struct DataTypeOf<uint64_t> { static const DataType value = DataType::UINT64; };
+template <> struct DataTypeOf<int64_t> { static const DataType value = DataType::INT64; };
+template <> struct DataTypeOf<float> { static const DataType value = DataType::FLOAT; };
+template <> struct DataTypeOf<double> { static const DataType value = DataType::DOUBLE; };
+
+/**
+* @brief Макрос для применения макроса M ко всем поддерживаемым типам значений.
+* @details Используется для явного инстанцирования шаблонов в файлах реализации.
+*/
+#define FOR_EACH_DATA_TYPE(M) \
+    M(uint16_t)               \
+    M(int16_t)                \
+    M(uint32_t)               \
+    M(int32_t)                \
+    M(uint64_t)               \
+    M(int64_t)                \
+    M(float)                  \
+    M(double)
+
+#endif // DATA_TYPES_H
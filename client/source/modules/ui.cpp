@@ -1,17 +1,43 @@
 #include "ui.h"
 #include <iostream>
 #include <cstring>
+#include <csignal>
+#include <algorithm>
+#include <memory>
+#include <thread>
 
 // Конструктор
 UserInterface::UserInterface(int argc, char *argv[])
     : address("127.0.0.1"),
       port(33333),
       config_path("./config/vclient.conf"),
-      help_flag(false),
+      memory_limit(64 * 1024 * 1024),
+      huge_pages(false),
+      mmap_flag(false),
+      pipeline_flag(false),
+      io_uring_flag(false),
+      queue_depth(4),
+      connections(1),
+      chunk_vectors(1024),
+      data_type(DataType::UINT32),
+      sessions(4),
+      workers(std::max(std::thread::hardware_concurrency(), 1u)),
+      log_level(LogLevel::INFO),
+      metrics_interval(0),
+      cache_size(64 * 1024 * 1024),
+      dedup_flag(false),
+      incremental_flag(false),
+      resume_flag(false),
+      retries(5),
+      local_flag(false),
+      verify_sample(0),
       io_man(nullptr),
-      net_man(nullptr)
+      net_man(nullptr),
+      cache(nullptr),
+      help_flag(false)
 {
     this->parseArgs(argc, argv);
+    Logger::setLevel(this->log_level);
 
     if (this->help_flag)
     {
@@ -19,8 +45,9 @@ UserInterface::UserInterface(int argc, char *argv[])
         exit(0);
     }
 
-    // Проверка, что все обязательные параметры заданы
-    if (this->input_path.empty() || this->output_path.empty())
+    // Проверка, что все обязательные параметры заданы (в режимах демона и манифеста файлы задаются заданиями)
+    bool job_mode = !this->daemon_path.empty() || !this->manifest_path.empty();
+    if (!job_mode && (this->input_path.empty() || this->output_path.empty()))
     {
         this->showHelp();
         throw ArgsDecodeError(
@@ -28,10 +55,98 @@ UserInterface::UserInterface(int argc, char *argv[])
             "UserInterface::UserInterface()");
     }
 
+    if (this->mmap_flag && this->pipeline_flag)
+    {
+        throw ArgsDecodeError(
+            "Options --mmap and --pipeline are mutually exclusive",
+            "UserInterface::UserInterface()");
+    }
+
+    if (this->connections == 0)
+    {
+        throw ArgsDecodeError(
+            "Number of connections must be positive",
+            "UserInterface::UserInterface()");
+    }
+
+    if (this->connections > 1 && (this->mmap_flag || this->pipeline_flag))
+    {
+        throw ArgsDecodeError(
+            "Option --connections cannot be combined with --mmap or --pipeline",
+            "UserInterface::UserInterface()");
+    }
+
+    if (!this->daemon_path.empty() && (this->connections > 1 || this->mmap_flag || this->pipeline_flag))
+    {
+        throw ArgsDecodeError(
+            "Option --daemon cannot be combined with --connections, --mmap or --pipeline",
+            "UserInterface::UserInterface()");
+    }
+
+    if (!this->manifest_path.empty() &&
+        (!this->daemon_path.empty() || this->connections > 1 || this->mmap_flag || this->pipeline_flag))
+    {
+        throw ArgsDecodeError(
+            "Option --manifest cannot be combined with --daemon, --connections, --mmap or --pipeline",
+            "UserInterface::UserInterface()");
+    }
+
+    if (this->incremental_flag &&
+        (!this->daemon_path.empty() || !this->manifest_path.empty() || this->connections > 1 ||
+         this->mmap_flag || this->pipeline_flag))
+    {
+        throw ArgsDecodeError(
+            "Option --incremental cannot be combined with --daemon, --manifest, --connections, --mmap or --pipeline",
+            "UserInterface::UserInterface()");
+    }
+
+    if (this->resume_flag &&
+        (!this->daemon_path.empty() || !this->manifest_path.empty() || this->connections > 1 ||
+         this->mmap_flag || this->pipeline_flag || this->incremental_flag))
+    {
+        throw ArgsDecodeError(
+            "Option --resume cannot be combined with --daemon, --manifest, --connections, --mmap, --pipeline or --incremental",
+            "UserInterface::UserInterface()");
+    }
+
+    if (this->local_flag &&
+        (!this->daemon_path.empty() || !this->manifest_path.empty() || this->connections > 1 ||
+         this->pipeline_flag || this->incremental_flag || this->resume_flag || !this->cache_path.empty() ||
+         this->dedup_flag))
+    {
+        throw ArgsDecodeError(
+            "Option --local cannot be combined with --daemon, --manifest, --connections, --pipeline, --incremental, --resume, --cache or --dedup",
+            "UserInterface::UserInterface()");
+    }
+
+    if (this->verify_sample < 0 || this->verify_sample > 1)
+    {
+        throw ArgsDecodeError(
+            "Verify sample must be between 0 and 1",
+            "UserInterface::UserInterface()");
+    }
+
+    if (this->verify_sample > 0 &&
+        (this->local_flag || !this->daemon_path.empty() || !this->manifest_path.empty() || this->connections > 1))
+    {
+        throw ArgsDecodeError(
+            "Option --verify-sample cannot be combined with --local, --daemon, --manifest or --connections",
+            "UserInterface::UserInterface()");
+    }
+
+    if (this->sessions == 0 || this->workers == 0)
+    {
+        throw ArgsDecodeError(
+            "Number of sessions and workers must be positive",
+            "UserInterface::UserInterface()");
+    }
+
     this->io_man = new IOManager(
         this->config_path,
         this->input_path,
         this->output_path);
+    if (this->io_uring_flag)
+        this->io_man->setBackend(FileBackend::URING, this->queue_depth);
     this->net_man = new NetworkManager(
         this->address,
         this->port);
@@ -42,6 +157,7 @@ UserInterface::~UserInterface()
 {
     delete this->io_man;
     delete this->net_man;
+    delete this->cache;
 }
 std::string &UserInterface::getAddress()
 {
@@ -63,6 +179,63 @@ std::string &UserInterface::getConfigPath()
 {
     return this->config_path;
 };
+size_t &UserInterface::getMemoryLimit()
+{
+    return this->memory_limit;
+};
+size_t &UserInterface::getConnections()
+{
+    return this->connections;
+};
+DataType &UserInterface::getDataType()
+{
+    return this->data_type;
+};
+std::string &UserInterface::getDaemonPath()
+{
+    return this->daemon_path;
+};
+LogLevel &UserInterface::getLogLevel()
+{
+    return this->log_level;
+};
+std::string &UserInterface::getTracePath()
+{
+    return this->trace_path;
+};
+std::string &UserInterface::getCachePath()
+{
+    return this->cache_path;
+};
+
+bool &UserInterface::getDedupFlag()
+{
+    return this->dedup_flag;
+};
+
+bool &UserInterface::getIncrementalFlag()
+{
+    return this->incremental_flag;
+};
+
+unsigned &UserInterface::getRetries()
+{
+    return this->retries;
+};
+
+bool &UserInterface::getLocalFlag()
+{
+    return this->local_flag;
+};
+
+double &UserInterface::getVerifySample()
+{
+    return this->verify_sample;
+};
+std::string &UserInterface::getManifestPath()
+{
+    return this->manifest_path;
+};
 // Метод для разбора аргументов
 void UserInterface::parseArgs(int argc, char *argv[])
 {
@@ -125,6 +298,198 @@ void UserInterface::parseArgs(int argc, char *argv[])
                     "Missing value for config parameter",
                     "UserInterface::parseArgs()");
         }
+        else if (
+            std::strcmp(argv[i], "-m") == 0 ||
+            std::strcmp(argv[i], "--memory") == 0)
+        {
+            if (i + 1 < argc)
+                this->memory_limit = std::stoull(argv[++i]);
+            else
+                throw ArgsDecodeError(
+                    "Missing value for memory parameter",
+                    "UserInterface::parseArgs()");
+        }
+        else if (std::strcmp(argv[i], "--huge-pages") == 0)
+            this->huge_pages = true;
+        else if (std::strcmp(argv[i], "--mmap") == 0)
+            this->mmap_flag = true;
+        else if (std::strcmp(argv[i], "--pipeline") == 0)
+            this->pipeline_flag = true;
+        else if (std::strcmp(argv[i], "--io-uring") == 0)
+            this->io_uring_flag = true;
+        else if (
+            std::strcmp(argv[i], "-q") == 0 ||
+            std::strcmp(argv[i], "--queue-depth") == 0)
+        {
+            if (i + 1 < argc)
+                this->queue_depth = std::stoul(argv[++i]);
+            else
+                throw ArgsDecodeError(
+                    "Missing value for queue depth parameter",
+                    "UserInterface::parseArgs()");
+        }
+        else if (std::strcmp(argv[i], "--connections") == 0)
+        {
+            if (i + 1 < argc)
+                this->connections = std::stoul(argv[++i]);
+            else
+                throw ArgsDecodeError(
+                    "Missing value for connections parameter",
+                    "UserInterface::parseArgs()");
+        }
+        else if (std::strcmp(argv[i], "--chunk-vectors") == 0)
+        {
+            if (i + 1 < argc)
+                this->chunk_vectors = std::stoul(argv[++i]);
+            else
+                throw ArgsDecodeError(
+                    "Missing value for chunk vectors parameter",
+                    "UserInterface::parseArgs()");
+        }
+        else if (
+            std::strcmp(argv[i], "-t") == 0 ||
+            std::strcmp(argv[i], "--type") == 0)
+        {
+            if (i + 1 < argc)
+                this->data_type = parseDataType(argv[++i]);
+            else
+                throw ArgsDecodeError(
+                    "Missing value for type parameter",
+                    "UserInterface::parseArgs()");
+        }
+        else if (std::strcmp(argv[i], "--daemon") == 0)
+        {
+            if (i + 1 < argc)
+                this->daemon_path = argv[++i];
+            else
+                throw ArgsDecodeError(
+                    "Missing value for daemon parameter",
+                    "UserInterface::parseArgs()");
+        }
+        else if (std::strcmp(argv[i], "--sessions") == 0)
+        {
+            if (i + 1 < argc)
+                this->sessions = std::stoul(argv[++i]);
+            else
+                throw ArgsDecodeError(
+                    "Missing value for sessions parameter",
+                    "UserInterface::parseArgs()");
+        }
+        else if (std::strcmp(argv[i], "--manifest") == 0)
+        {
+            if (i + 1 < argc)
+                this->manifest_path = argv[++i];
+            else
+                throw ArgsDecodeError(
+                    "Missing value for manifest parameter",
+                    "UserInterface::parseArgs()");
+        }
+        else if (std::strcmp(argv[i], "--workers") == 0)
+        {
+            if (i + 1 < argc)
+                this->workers = std::stoul(argv[++i]);
+            else
+                throw ArgsDecodeError(
+                    "Missing value for workers parameter",
+                    "UserInterface::parseArgs()");
+        }
+        else if (std::strcmp(argv[i], "--metrics-json") == 0)
+        {
+            if (i + 1 < argc)
+                this->metrics_json = argv[++i];
+            else
+                throw ArgsDecodeError(
+                    "Missing value for metrics JSON parameter",
+                    "UserInterface::parseArgs()");
+        }
+        else if (std::strcmp(argv[i], "--metrics-prom") == 0)
+        {
+            if (i + 1 < argc)
+                this->metrics_prom = argv[++i];
+            else
+                throw ArgsDecodeError(
+                    "Missing value for metrics Prometheus parameter",
+                    "UserInterface::parseArgs()");
+        }
+        else if (std::strcmp(argv[i], "--metrics-interval") == 0)
+        {
+            if (i + 1 < argc)
+                this->metrics_interval = std::stoul(argv[++i]);
+            else
+                throw ArgsDecodeError(
+                    "Missing value for metrics interval parameter",
+                    "UserInterface::parseArgs()");
+        }
+        else if (std::strcmp(argv[i], "--trace") == 0)
+        {
+            if (i + 1 < argc)
+                this->trace_path = argv[++i];
+            else
+                throw ArgsDecodeError(
+                    "Missing value for trace parameter",
+                    "UserInterface::parseArgs()");
+        }
+        else if (std::strcmp(argv[i], "--cache") == 0)
+        {
+            if (i + 1 < argc)
+                this->cache_path = argv[++i];
+            else
+                throw ArgsDecodeError(
+                    "Missing value for cache parameter",
+                    "UserInterface::parseArgs()");
+        }
+        else if (std::strcmp(argv[i], "--cache-size") == 0)
+        {
+            if (i + 1 < argc)
+                this->cache_size = std::stoull(argv[++i]);
+            else
+                throw ArgsDecodeError(
+                    "Missing value for cache size parameter",
+                    "UserInterface::parseArgs()");
+        }
+        else if (std::strcmp(argv[i], "--dedup") == 0)
+        {
+            this->dedup_flag = true;
+        }
+        else if (std::strcmp(argv[i], "--incremental") == 0)
+        {
+            this->incremental_flag = true;
+        }
+        else if (std::strcmp(argv[i], "--resume") == 0)
+        {
+            this->resume_flag = true;
+        }
+        else if (std::strcmp(argv[i], "--retries") == 0)
+        {
+            if (i + 1 < argc)
+                this->retries = std::stoul(argv[++i]);
+            else
+                throw ArgsDecodeError(
+                    "Missing value for retries parameter",
+                    "UserInterface::parseArgs()");
+        }
+        else if (std::strcmp(argv[i], "--local") == 0)
+        {
+            this->local_flag = true;
+        }
+        else if (std::strcmp(argv[i], "--verify-sample") == 0)
+        {
+            if (i + 1 < argc)
+                this->verify_sample = std::stod(argv[++i]);
+            else
+                throw ArgsDecodeError(
+                    "Missing value for verify sample parameter",
+                    "UserInterface::parseArgs()");
+        }
+        else if (std::strcmp(argv[i], "--log-level") == 0)
+        {
+            if (i + 1 < argc)
+                this->log_level = parseLogLevel(argv[++i]);
+            else
+                throw ArgsDecodeError(
+                    "Missing value for log level parameter",
+                    "UserInterface::parseArgs()");
+        }
         else
             throw ArgsDecodeError(
                 "Unknown parameter: " + std::string(argv[i]),
@@ -142,20 +507,315 @@ void UserInterface::showHelp()
               << "  -p, --port PORT       Server port (default: 33333)\n"
               << "  -i, --input PATH      Path to input data file\n"
               << "  -o, --output PATH     Path to output data file\n"
-              << "  -c, --config PATH     Path to config file (default: ./config/vclient.conf)\n";
+              << "  -c, --config PATH     Path to config file (default: ./config/vclient.conf)\n"
+              << "  -m, --memory BYTES    Memory limit for one chunk of vectors (default: 67108864)\n"
+              << "      --huge-pages      Place chunk buffers in huge pages\n"
+              << "      --mmap            Send input data straight from the mapped file\n"
+              << "      --pipeline        Overlap reading, sending, receiving and writing\n"
+              << "      --io-uring        Read input ahead and write results asynchronously via io_uring\n"
+              << "                        (falls back to pread/pwrite if io_uring is unavailable)\n"
+              << "  -q, --queue-depth N   Chunks queued between pipeline stages, blocks in flight\n"
+              << "                        with --io-uring (default: 4)\n"
+              << "      --connections N   Number of parallel server sessions (default: 1)\n"
+              << "      --chunk-vectors K Vectors per chunk with several sessions (default: 1024)\n"
+              << "  -t, --type TYPE       Vector value type: uint16_t, int16_t, uint32_t, int32_t,\n"
+              << "                        uint64_t, int64_t, float, double (default: uint32_t)\n"
+              << "      --daemon SOCKET   Serve \"INPUT OUTPUT\" jobs on a Unix socket with warm sessions\n"
+              << "      --sessions N      Pre-authenticated sessions kept by the daemon (default: 4)\n"
+              << "      --manifest FILE   Process \"INPUT OUTPUT\" lines of FILE on a worker pool\n"
+              << "      --workers N       Worker threads for --manifest and --local, verifying threads\n"
+              << "                        for --verify-sample (default: number of cores)\n"
+              << "      --log-level LEVEL Log level: debug (samples of data), info (summaries),\n"
+              << "                        warn, error, off (default: info)\n"
+              << "      --metrics-json FILE Write per-phase timers, counters and latency histograms as JSON\n"
+              << "      --metrics-prom FILE Write the same metrics in Prometheus text format\n"
+              << "      --metrics-interval S Rewrite metrics files every S seconds (default: 0, only at exit)\n"
+              << "      --trace FILE      Write a per-thread timeline of phases and send/recv batches\n"
+              << "                        in Chrome trace-event JSON (open in Perfetto or chrome://tracing)\n"
+              << "      --cache FILE      Keep results of vectors in an on-disk cache and send only misses\n"
+              << "      --cache-size BYTES Size limit of the cache file, old entries are evicted (default: 67108864)\n"
+              << "      --dedup           Send each distinct vector of a chunk once and copy its result\n"
+              << "                        to every repeat\n"
+              << "      --incremental     Send only vectors changed since the last run and patch the output\n"
+              << "                        in place, using fingerprints kept in OUTPUT.vcinc\n"
+              << "      --resume          Checkpoint results to OUTPUT.part/OUTPUT.ckpt, reconnect with backoff\n"
+              << "                        on connection loss and continue an interrupted run\n"
+              << "      --retries N       Reconnect attempts in a row with --resume (default: 5)\n"
+              << "      --local           Compute results in-process with SIMD kernels, without the server\n"
+              << "      --verify-sample P Recompute a fraction P (0..1) of server results locally on spare cores\n"
+              << "                        and fail if any differs\n";
 }
 
 // Метод для запуска программы
 void UserInterface::run()
 {
-    // Пример использования методов io_man и net_man
-    auto credentials = this->io_man->conf();
-    this->net_man->conn();
-    this->net_man->auth(credentials[0], credentials[1]);
+    // Временная шкала и метрики выгружаются при любом завершении
+    TraceSession trace(this->trace_path);
+    MetricsExporter exporter(this->metrics_json, this->metrics_prom, this->metrics_interval);
+    TraceSpan span("run", "ui");
+
+    // Локальному вычислению сервер и учётные данные не нужны
+    std::array<std::string, 2> credentials;
+    if (!this->local_flag)
+        credentials = this->io_man->conf();
+
+    // Кеш недоступен (например, занят другим процессом) - работа продолжается без него
+    if (!this->cache_path.empty() && this->cache == nullptr)
+    {
+        try
+        {
+            this->cache = new ResultCache(this->cache_path, this->cache_size);
+        }
+        catch (const IOError &e)
+        {
+            LOG_WARN("UserInterface::run()", "Result cache disabled: " << e.what());
+        }
+    }
+    this->net_man->setCache(this->cache);
+    this->net_man->setDedup(this->dedup_flag);
+
+    // Проверка занимает потоки, оставшиеся от основного
+    std::unique_ptr<ResultVerifier> verifier;
+    if (this->verify_sample > 0)
+        verifier.reset(new ResultVerifier(this->verify_sample, std::max<size_t>(this->workers - 1, 1)));
+    this->net_man->setVerifier(verifier.get());
+
+    // Тип значений выбирается один раз, дальше весь путь данных типизирован
+    switch (this->data_type)
+    {
+    case DataType::UINT16:
+        this->runTyped<uint16_t>(credentials);
+        break;
+    case DataType::INT16:
+        this->runTyped<int16_t>(credentials);
+        break;
+    case DataType::UINT32:
+        this->runTyped<uint32_t>(credentials);
+        break;
+    case DataType::INT32:
+        this->runTyped<int32_t>(credentials);
+        break;
+    case DataType::UINT64:
+        this->runTyped<uint64_t>(credentials);
+        break;
+    case DataType::INT64:
+        this->runTyped<int64_t>(credentials);
+        break;
+    case DataType::FLOAT:
+        this->runTyped<float>(credentials);
+        break;
+    case DataType::DOUBLE:
+        this->runTyped<double>(credentials);
+        break;
+    }
+
+    if (verifier)
+    {
+        verifier->finish();
+        this->net_man->setVerifier(nullptr);
+        LOG_INFO("UserInterface::run()", "Verify: checked=" << verifier->checked()
+                                                             << " mismatches=" << verifier->mismatches()
+                                                             << " simd=" << simdLevelName(simdLevel()));
+        if (verifier->mismatches() > 0)
+        {
+            throw NetworkError(
+                std::to_string(verifier->mismatches()) + " of " + std::to_string(verifier->checked()) +
+                    " sampled server results differ from local computation",
+                "UserInterface::run()");
+        }
+    }
+
+    if (this->cache != nullptr)
+    {
+        LOG_INFO("UserInterface::run()", "Cache: hits=" << this->cache->hits()
+                                                         << " misses=" << this->cache->misses()
+                                                         << " evictions=" << this->cache->evictions()
+                                                         << " entries=" << this->cache->size()
+                                                         << "/" << this->cache->capacity());
+    }
+}
+
+// Метод для обработки данных с заданным типом значений
+template <typename T>
+void UserInterface::runTyped(const std::array<std::string, 2> &credentials)
+{
+    if (!this->daemon_path.empty())
+    {
+        // Задания принимаются через Unix-сокет до получения SIGINT или SIGTERM
+        BasicSessionDaemon<T> daemon(
+            this->config_path,
+            this->address,
+            this->port,
+            credentials,
+            this->daemon_path,
+            this->sessions,
+            this->memory_limit,
+            this->io_uring_flag ? FileBackend::URING : FileBackend::STREAM,
+            this->queue_depth,
+            this->cache,
+            this->dedup_flag);
+        std::signal(SIGINT, [](int)
+                    { BasicSessionDaemon<T>::stop(); });
+        std::signal(SIGTERM, [](int)
+                    { BasicSessionDaemon<T>::stop(); });
+        daemon.run();
+        return;
+    }
+
+    if (!this->manifest_path.empty())
+    {
+        // Задания манифеста обрабатываются пулом потоков с перехватом работы
+        std::vector<ManifestJob> jobs = readManifest(this->manifest_path);
+        BasicManifestRunner<T> runner(
+            this->config_path,
+            this->address,
+            this->port,
+            credentials,
+            jobs,
+            this->workers,
+            this->memory_limit,
+            this->io_uring_flag ? FileBackend::URING : FileBackend::STREAM,
+            this->queue_depth,
+            this->cache,
+            this->dedup_flag);
+        size_t failed = runner.run();
+        if (failed > 0)
+        {
+            throw IOError(
+                std::to_string(failed) + " of " + std::to_string(jobs.size()) + " manifest jobs failed",
+                "UserInterface::run()");
+        }
+        return;
+    }
+
+    if (this->connections > 1)
+    {
+        // Порции векторов распределяются между несколькими сессиями
+        BasicShardedCalc<T> sharded(
+            *this->io_man,
+            this->address,
+            this->port,
+            credentials,
+            this->connections,
+            this->chunk_vectors,
+            this->memory_limit,
+            this->queue_depth,
+            this->huge_pages,
+            this->cache,
+            this->dedup_flag);
+        sharded.run();
+        return;
+    }
+
+    if (this->local_flag)
+    {
+        // Результаты вычисляются в процессе той же операцией, что и на сервере
+        BasicLocalEngine<T> engine(this->workers);
+        if (this->mmap_flag)
+        {
+            BasicMappedInput<T> input = this->io_man->map<T>();
+            BasicResultWriter<T> writer = this->io_man->writer<T>(input.count());
+            BasicMappedChunk<T> chunk;
+            while (input.next(this->memory_limit, chunk))
+                writer.append(engine.calc(chunk));
+            writer.close();
+        }
+        else
+        {
+            BasicVectorReader<T> reader = this->io_man->reader<T>(this->memory_limit);
+            BasicResultWriter<T> writer = this->io_man->writer<T>(reader.count());
+            BasicVectorBatch<T> chunk(this->huge_pages);
+            while (reader.next(chunk))
+                writer.append(engine.calc(chunk));
+            writer.close();
+        }
+        LOG_INFO("UserInterface::run()", "Local: simd=" << simdLevelName(simdLevel())
+                                                         << " threads=" << this->workers);
+        return;
+    }
+
+    if (!this->resume_flag)
+    {
+        this->net_man->conn();
+        this->net_man->auth(credentials[0], credentials[1]);
+    }
 
-    auto data = this->io_man->read();
-    auto results = this->net_man->calc(data);
-    this->io_man->write(results);
+    if (this->resume_flag)
+    {
+        // Результаты сохраняются по порциям, после обрыва соединения обработка продолжается
+        BasicResumableCalc<T> resumable(
+            *this->io_man,
+            *this->net_man,
+            credentials,
+            this->input_path,
+            this->output_path,
+            this->memory_limit,
+            this->huge_pages,
+            this->retries);
+        resumable.run();
+    }
+    else if (this->incremental_flag)
+    {
+        // Отправляются только векторы, изменившиеся с прошлого запуска
+        BasicIncrementalCalc<T> incremental(
+            *this->io_man,
+            *this->net_man,
+            this->output_path,
+            this->memory_limit,
+            this->huge_pages);
+        incremental.run();
+    }
+    else if (this->pipeline_flag)
+    {
+        // Чтение, отправка, приём и запись выполняются одновременно
+        BasicPipeline<T> pipeline(
+            *this->io_man,
+            *this->net_man,
+            this->memory_limit,
+            this->queue_depth,
+            this->huge_pages);
+        pipeline.run();
+    }
+    else if (this->mmap_flag)
+    {
+        // Векторы отправляются прямо из отображённого файла
+        BasicMappedInput<T> input = this->io_man->map<T>();
+        BasicResultWriter<T> writer = this->io_man->writer<T>(input.count());
+        this->net_man->begin(input.count());
+
+        BasicMappedChunk<T> chunk;
+        while (input.next(this->memory_limit, chunk))
+            writer.append(this->net_man->exchange(chunk));
+        writer.close();
+    }
+    else
+    {
+        // Потоковая обработка: в памяти находится не более одной порции векторов
+        BasicVectorReader<T> reader = this->io_man->reader<T>(this->memory_limit);
+        BasicResultWriter<T> writer = this->io_man->writer<T>(reader.count());
+        this->net_man->begin(reader.count());
+
+        BasicVectorBatch<T> chunk(this->huge_pages);
+        while (reader.next(chunk))
+            writer.append(this->net_man->exchange(chunk));
+        writer.close();
+    }
+
+    // Логирование количества системных вызовов обмена
+    const SyscallStats &stats = this->net_man->stats();
+    LOG_INFO("NetworkManager.calc()", "Syscalls: send=" << stats.send_calls
+                                                        << " recv=" << stats.recv_calls
+                                                        << " poll=" << stats.poll_calls
+                                                        << " bytes_sent=" << stats.bytes_sent
+                                                        << " bytes_received=" << stats.bytes_received);
+
+    const DedupStats &dedup = this->net_man->dedupStats();
+    if (this->dedup_flag && dedup.unique > 0)
+    {
+        LOG_INFO("UserInterface::run()", "Dedup: vectors=" << dedup.vectors
+                                                            << " unique=" << dedup.unique
+                                                            << " ratio=" << static_cast<double>(dedup.vectors) / dedup.unique);
+    }
 
     this->net_man->close();
 }
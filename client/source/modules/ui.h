@@ -3,8 +3,22 @@
 
 #include "io.h"
 #include "network.h"
+#include "pipeline.h"
+#include "shard.h"
+#include "daemon.h"
+#include "manifest.h"
+#include "log.h"
+#include "metrics.h"
+#include "trace.h"
+#include "cache.h"
+#include "incremental.h"
+#include "resume.h"
+#include "compute.h"
+#include "verify.h"
 #include "errors.h"
+#include "types.h"
 #include <string>
+#include <array>
 #include <vector>
 
 /** 
@@ -66,6 +80,84 @@ public:
     */
     std::string &getConfigPath();
 
+    /**
+    * @brief Метод для получения ограничения памяти на порцию векторов.
+    * @return Ограничение памяти в байтах.
+    */
+    size_t &getMemoryLimit();
+
+    /**
+    * @brief Метод для получения количества подключений к серверу.
+    * @return Количество подключений.
+    */
+    size_t &getConnections();
+
+    /**
+    * @brief Метод для получения типа значений векторов.
+    * @return Тип значений.
+    */
+    DataType &getDataType();
+
+    /**
+    * @brief Метод для получения пути к Unix-сокету режима демона.
+    * @return Путь к сокету (пустой, если режим демона не включён).
+    */
+    std::string &getDaemonPath();
+
+    /**
+    * @brief Метод для получения пути к манифесту заданий.
+    * @return Путь к манифесту (пустой, если манифест не задан).
+    */
+    std::string &getManifestPath();
+
+    /**
+    * @brief Метод для получения уровня журнала.
+    * @return Минимальный записываемый уровень сообщений.
+    */
+    LogLevel &getLogLevel();
+
+    /**
+    * @brief Метод для получения пути к файлу временной шкалы.
+    * @return Путь к файлу (пустой, если шкала не записывается).
+    */
+    std::string &getTracePath();
+
+    /**
+    * @brief Метод для получения пути к файлу кеша результатов.
+    * @return Путь к файлу (пустой, если кеш не используется).
+    */
+    std::string &getCachePath();
+
+    /**
+    * @brief Метод для получения флага устранения повторов.
+    * @return true, если повторы внутри порций отправляются один раз.
+    */
+    bool &getDedupFlag();
+
+    /**
+    * @brief Метод для получения флага инкрементальной обработки.
+    * @return true, если отправляются только векторы, изменившиеся с прошлого запуска.
+    */
+    bool &getIncrementalFlag();
+
+    /**
+    * @brief Метод для получения количества попыток переподключения.
+    * @return Количество попыток подряд в режиме с контрольными точками.
+    */
+    unsigned &getRetries();
+
+    /**
+    * @brief Метод для получения флага локального вычисления.
+    * @return true, если результаты вычисляются в процессе, без сервера.
+    */
+    bool &getLocalFlag();
+
+    /**
+    * @brief Метод для получения доли проверяемых результатов сервера.
+    * @return Доля векторов (0 - без проверки).
+    */
+    double &getVerifySample();
+
     /**
     * @brief Метод для запуска интерфейса.
     */
@@ -77,9 +169,36 @@ private:
     std::string input_path; ///< Путь к входному файлу.
     std::string output_path; ///< Путь к выходному файлу.
     std::string config_path; ///< Путь к файлу конфигурации.
+    size_t memory_limit; ///< Ограничение памяти на порцию векторов (в байтах).
+    bool huge_pages; ///< Флаг размещения порций в больших страницах памяти.
+    bool mmap_flag; ///< Флаг чтения входного файла через отображение в память.
+    bool pipeline_flag; ///< Флаг конвейерной обработки.
+    bool io_uring_flag; ///< Флаг чтения и записи файлов через io_uring.
+    size_t queue_depth; ///< Длина очередей между стадиями конвейера.
+    size_t connections; ///< Количество подключений к серверу.
+    size_t chunk_vectors; ///< Количество векторов в порции при нескольких подключениях.
+    DataType data_type; ///< Тип значений векторов.
+    std::string daemon_path; ///< Путь к Unix-сокету режима демона (пустой - обычный режим).
+    size_t sessions; ///< Количество заранее открытых сессий в режиме демона.
+    std::string manifest_path; ///< Путь к манифесту заданий (пустой - обычный режим).
+    size_t workers; ///< Количество рабочих потоков обработки манифеста.
+    LogLevel log_level; ///< Минимальный записываемый уровень журнала.
+    std::string metrics_json; ///< Путь к файлу метрик в формате JSON (пустой - не выгружать).
+    std::string metrics_prom; ///< Путь к файлу метрик в формате Prometheus (пустой - не выгружать).
+    unsigned metrics_interval; ///< Интервал периодической выгрузки метрик в секундах (0 - при завершении).
+    std::string trace_path; ///< Путь к файлу временной шкалы (пустой - не записывать).
+    std::string cache_path; ///< Путь к файлу кеша результатов (пустой - без кеша).
+    size_t cache_size; ///< Наибольший размер файла кеша в байтах.
+    bool dedup_flag; ///< Флаг устранения повторов внутри порций.
+    bool incremental_flag; ///< Флаг инкрементальной обработки.
+    bool resume_flag; ///< Флаг обработки с контрольными точками и переподключением.
+    unsigned retries; ///< Количество попыток переподключения подряд.
+    bool local_flag; ///< Флаг локального вычисления без сервера.
+    double verify_sample; ///< Доля результатов сервера, проверяемых локально (0 - без проверки).
 
     IOManager *io_man; ///< Менеджер ввода-вывода.
     NetworkManager *net_man; ///< Менеджер сетевого взаимодействия.
+    ResultCache *cache; ///< Кеш результатов (nullptr - без кеша).
 
     bool help_flag; ///< Флаг для отображения справки.
 
@@ -95,6 +214,14 @@ private:
     * @brief Метод для отображения справки.
     */
     void showHelp();
+
+    /**
+    * @brief Метод для обработки данных с заданным типом значений.
+    * @tparam T Тип значений векторов.
+    * @param credentials Логин и пароль.
+    */
+    template <typename T>
+    void runTyped(const std::array<std::string, 2> &credentials);
 };
 
 #endif // UI_H
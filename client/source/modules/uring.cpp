@@ -0,0 +1,501 @@
+#include "uring.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <fcntl.h>
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+// Размер одного блока чтения или буфера записи
+static const size_t RING_BLOCK_SIZE = 256 * 1024;
+
+// Выравнивание буферов (подходит и для O_DIRECT)
+static const size_t RING_BLOCK_ALIGN = 4096;
+
+// Системные вызовы io_uring (liburing не требуется)
+static int io_uring_setup(unsigned entries, struct io_uring_params *params)
+{
+    return static_cast<int>(syscall(__NR_io_uring_setup, entries, params));
+}
+
+static int io_uring_enter(int fd, unsigned to_submit, unsigned min_complete, unsigned flags)
+{
+    return static_cast<int>(syscall(__NR_io_uring_enter, fd, to_submit, min_complete, flags, nullptr, 0));
+}
+
+static int io_uring_register(int fd, unsigned opcode, const void *arg, unsigned nr_args)
+{
+    return static_cast<int>(syscall(__NR_io_uring_register, fd, opcode, arg, nr_args));
+}
+
+// Функция для выделения выровненных буферов
+static std::vector<char *> allocateBlocks(size_t count)
+{
+    std::vector<char *> blocks;
+    for (size_t i = 0; i < count; ++i)
+    {
+        void *block = nullptr;
+        if (posix_memalign(&block, RING_BLOCK_ALIGN, RING_BLOCK_SIZE) != 0)
+        {
+            for (char *allocated : blocks)
+                free(allocated);
+            throw std::bad_alloc();
+        }
+        blocks.push_back(static_cast<char *>(block));
+    }
+    return blocks;
+}
+
+// Функция для описания буферов для кольца
+static std::vector<struct iovec> describeBlocks(const std::vector<char *> &blocks)
+{
+    std::vector<struct iovec> buffers(blocks.size());
+    for (size_t i = 0; i < blocks.size(); ++i)
+    {
+        buffers[i].iov_base = blocks[i];
+        buffers[i].iov_len = RING_BLOCK_SIZE;
+    }
+    return buffers;
+}
+
+// Конструктор кольца
+IoRing::IoRing(unsigned entries)
+    : ring_fd(-1),
+      sq_ptr(MAP_FAILED),
+      sq_size(0),
+      cq_ptr(MAP_FAILED),
+      cq_size(0),
+      sqes_ptr(MAP_FAILED),
+      sqes_size(0),
+      to_submit(0),
+      fixed(false)
+{
+    struct io_uring_params params;
+    std::memset(&params, 0, sizeof(params));
+    int fd = io_uring_setup(std::max(entries, 1u), &params);
+
+    // Ядро без io_uring или запрет seccomp - синхронный режим
+    if (fd < 0)
+        return;
+
+    this->sq_size = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    this->cq_size = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+    bool single_mmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+    if (single_mmap)
+        this->sq_size = this->cq_size = std::max(this->sq_size, this->cq_size);
+
+    this->sq_ptr = mmap(nullptr, this->sq_size, PROT_READ | PROT_WRITE,
+                        MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQ_RING);
+    if (this->sq_ptr != MAP_FAILED)
+    {
+        this->cq_ptr = single_mmap
+                           ? this->sq_ptr
+                           : mmap(nullptr, this->cq_size, PROT_READ | PROT_WRITE,
+                                  MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_CQ_RING);
+        this->sqes_size = params.sq_entries * sizeof(struct io_uring_sqe);
+        this->sqes_ptr = mmap(nullptr, this->sqes_size, PROT_READ | PROT_WRITE,
+                              MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQES);
+    }
+    if (this->sq_ptr == MAP_FAILED || this->cq_ptr == MAP_FAILED || this->sqes_ptr == MAP_FAILED)
+    {
+        if (this->sqes_ptr != MAP_FAILED)
+            munmap(this->sqes_ptr, this->sqes_size);
+        if (this->cq_ptr != MAP_FAILED && this->cq_ptr != this->sq_ptr)
+            munmap(this->cq_ptr, this->cq_size);
+        if (this->sq_ptr != MAP_FAILED)
+            munmap(this->sq_ptr, this->sq_size);
+        this->sq_ptr = this->cq_ptr = this->sqes_ptr = MAP_FAILED;
+        ::close(fd);
+        return;
+    }
+
+    char *sq = static_cast<char *>(this->sq_ptr);
+    char *cq = static_cast<char *>(this->cq_ptr);
+    this->sq_tail = reinterpret_cast<unsigned *>(sq + params.sq_off.tail);
+    this->sq_mask = reinterpret_cast<unsigned *>(sq + params.sq_off.ring_mask);
+    this->sq_array = reinterpret_cast<unsigned *>(sq + params.sq_off.array);
+    this->cq_head = reinterpret_cast<unsigned *>(cq + params.cq_off.head);
+    this->cq_tail = reinterpret_cast<unsigned *>(cq + params.cq_off.tail);
+    this->cq_mask = reinterpret_cast<unsigned *>(cq + params.cq_off.ring_mask);
+    this->cqes = cq + params.cq_off.cqes;
+    this->ring_fd = fd;
+}
+
+// Деструктор кольца
+IoRing::~IoRing()
+{
+    if (this->sqes_ptr != MAP_FAILED)
+        munmap(this->sqes_ptr, this->sqes_size);
+    if (this->cq_ptr != MAP_FAILED && this->cq_ptr != this->sq_ptr)
+        munmap(this->cq_ptr, this->cq_size);
+    if (this->sq_ptr != MAP_FAILED)
+        munmap(this->sq_ptr, this->sq_size);
+    if (this->ring_fd >= 0)
+        ::close(this->ring_fd);
+}
+
+bool IoRing::active() const
+{
+    return this->ring_fd >= 0;
+}
+
+// Метод для регистрации буферов в ядре
+void IoRing::registerBuffers(const std::vector<struct iovec> &buffers)
+{
+    this->buffers = buffers;
+
+    // Без регистрации (например, при малом RLIMIT_MEMLOCK) используются READV/WRITEV
+    if (this->active())
+        this->fixed = io_uring_register(this->ring_fd, IORING_REGISTER_BUFFERS,
+                                        this->buffers.data(), this->buffers.size()) == 0;
+}
+
+// Метод для постановки запроса в кольцо отправки
+void IoRing::push(uint8_t opcode, int fd, size_t buffer, size_t length, uint64_t offset, uint64_t tag)
+{
+    unsigned tail = *this->sq_tail;
+    unsigned index = tail & *this->sq_mask;
+    struct io_uring_sqe *sqe = static_cast<struct io_uring_sqe *>(this->sqes_ptr) + index;
+    std::memset(sqe, 0, sizeof(*sqe));
+    sqe->opcode = opcode;
+    sqe->fd = fd;
+    sqe->off = offset;
+    sqe->user_data = tag;
+    if (this->fixed)
+    {
+        sqe->addr = reinterpret_cast<uint64_t>(this->buffers[buffer].iov_base);
+        sqe->len = static_cast<uint32_t>(length);
+        sqe->buf_index = static_cast<uint16_t>(buffer);
+    }
+    else
+    {
+        this->buffers[buffer].iov_len = length;
+        sqe->addr = reinterpret_cast<uint64_t>(&this->buffers[buffer]);
+        sqe->len = 1;
+    }
+    this->sq_array[index] = index;
+
+    // Запрос становится виден ядру только после записи хвоста
+    __atomic_store_n(this->sq_tail, tail + 1, __ATOMIC_RELEASE);
+    ++this->to_submit;
+
+    // Запрос отправляется сразу, завершение забирается позже в wait()
+    int submitted = io_uring_enter(this->ring_fd, this->to_submit, 0, 0);
+    if (submitted > 0)
+        this->to_submit -= std::min<unsigned>(submitted, this->to_submit);
+}
+
+// Метод для постановки чтения в очередь
+void IoRing::read(int fd, size_t buffer, size_t length, uint64_t offset, uint64_t tag)
+{
+    if (!this->active())
+    {
+        ssize_t got = pread(fd, this->buffers[buffer].iov_base, length, offset);
+        this->completed.emplace_back(tag, got < 0 ? -errno : got);
+        return;
+    }
+    this->push(this->fixed ? IORING_OP_READ_FIXED : IORING_OP_READV, fd, buffer, length, offset, tag);
+}
+
+// Метод для постановки записи в очередь
+void IoRing::write(int fd, size_t buffer, size_t length, uint64_t offset, uint64_t tag)
+{
+    if (!this->active())
+    {
+        ssize_t put = pwrite(fd, this->buffers[buffer].iov_base, length, offset);
+        this->completed.emplace_back(tag, put < 0 ? -errno : put);
+        return;
+    }
+    this->push(this->fixed ? IORING_OP_WRITE_FIXED : IORING_OP_WRITEV, fd, buffer, length, offset, tag);
+}
+
+// Метод для ожидания завершения одной операции
+int64_t IoRing::wait(uint64_t &tag)
+{
+    if (!this->active())
+    {
+        if (this->completed.empty())
+            throw IOError("No pending I/O operations", "IoRing.wait()");
+        tag = this->completed.front().first;
+        int64_t result = this->completed.front().second;
+        this->completed.pop_front();
+        return result;
+    }
+
+    for (;;)
+    {
+        unsigned head = *this->cq_head;
+        if (head != __atomic_load_n(this->cq_tail, __ATOMIC_ACQUIRE))
+        {
+            const struct io_uring_cqe *cqe =
+                static_cast<const struct io_uring_cqe *>(this->cqes) + (head & *this->cq_mask);
+            tag = cqe->user_data;
+            int64_t result = cqe->res;
+            __atomic_store_n(this->cq_head, head + 1, __ATOMIC_RELEASE);
+            return result;
+        }
+
+        // Отправка накопленных запросов и ожидание хотя бы одного завершения
+        int submitted = io_uring_enter(this->ring_fd, this->to_submit, 1, IORING_ENTER_GETEVENTS);
+        if (submitted < 0)
+        {
+            if (errno == EINTR || errno == EAGAIN)
+                continue;
+            throw IOError("io_uring_enter failed: " + std::string(std::strerror(errno)), "IoRing.wait()");
+        }
+        this->to_submit -= std::min<unsigned>(submitted, this->to_submit);
+    }
+}
+
+// Конструктор читателя с упреждением
+RingFileReader::RingFileReader(const std::string &path, size_t queue_depth)
+    : fd(::open(path.c_str(), O_RDONLY | O_CLOEXEC)),
+      file_size(0),
+      next_offset(0),
+      current(0),
+      ring(static_cast<unsigned>(std::max<size_t>(queue_depth, 1)))
+{
+    if (this->fd < 0)
+    {
+        throw IOError("Failed to open input file for reading.", "IOManager.read()");
+    }
+
+    struct stat st;
+    if (fstat(this->fd, &st) == 0)
+        this->file_size = st.st_size;
+    posix_fadvise(this->fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+
+    this->memory = allocateBlocks(std::max<size_t>(queue_depth, 1));
+    this->slots.resize(this->memory.size());
+    this->ring.registerBuffers(describeBlocks(this->memory));
+
+    // Чтение первых блоков с упреждением
+    for (size_t i = 0; i < this->slots.size(); ++i)
+        this->submit(i);
+}
+
+// Деструктор читателя
+RingFileReader::~RingFileReader()
+{
+    // Ядро не должно писать в освобождённую память - ожидание незавершённых чтений
+    for (const Slot &slot : this->slots)
+    {
+        if (slot.ready || slot.length == 0)
+            continue;
+        uint64_t tag;
+        try
+        {
+            this->ring.wait(tag);
+        }
+        catch (const IOError &)
+        {
+            break;
+        }
+    }
+    for (char *block : this->memory)
+        free(block);
+    if (this->fd >= 0)
+        ::close(this->fd);
+}
+
+bool RingFileReader::async() const
+{
+    return this->ring.active();
+}
+
+// Метод для постановки чтения блока в очередь
+void RingFileReader::submit(size_t slot)
+{
+    Slot &s = this->slots[slot];
+    s.offset = this->next_offset;
+    s.position = 0;
+    s.length = 0;
+    s.ready = true;
+    if (this->next_offset >= this->file_size)
+        return;
+
+    s.length = std::min<uint64_t>(RING_BLOCK_SIZE, this->file_size - this->next_offset);
+    s.ready = false;
+    this->next_offset += s.length;
+    this->ring.read(this->fd, slot, s.length, s.offset, slot);
+}
+
+// Метод для чтения очередных байтов файла
+bool RingFileReader::read(void *data, size_t length)
+{
+    char *out = static_cast<char *>(data);
+    while (length > 0)
+    {
+        Slot &slot = this->slots[this->current];
+
+        // Завершения приходят в любом порядке - ожидание нужного блока
+        while (!slot.ready)
+        {
+            uint64_t tag;
+            int64_t result = this->ring.wait(tag);
+            Slot &done = this->slots[tag];
+            if (result < 0)
+            {
+                done.ready = true;
+                done.length = 0;
+                throw IOError("Failed to read input file: " + std::string(std::strerror(-result)),
+                              "RingFileReader.read()");
+            }
+
+            // Короткое чтение дочитывается синхронно
+            size_t got = static_cast<size_t>(result);
+            while (got < done.length)
+            {
+                ssize_t more = pread(this->fd, this->memory[tag] + got, done.length - got, done.offset + got);
+                if (more <= 0)
+                    break;
+                got += more;
+            }
+            done.length = got;
+            done.ready = true;
+        }
+
+        if (slot.position == slot.length)
+        {
+            // Файл закончился
+            if (slot.length == 0)
+                return false;
+
+            // Блок выдан полностью - он переиспользуется для следующего чтения
+            this->submit(this->current);
+            this->current = (this->current + 1) % this->slots.size();
+            continue;
+        }
+
+        size_t take = std::min(length, slot.length - slot.position);
+        std::memcpy(out, this->memory[this->current] + slot.position, take);
+        slot.position += take;
+        out += take;
+        length -= take;
+    }
+    return true;
+}
+
+// Конструктор асинхронного писателя
+RingFileWriter::RingFileWriter(const std::string &path, size_t queue_depth)
+    : fd(::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644)),
+      file_offset(0),
+      current(0),
+      filled(0),
+      in_flight(0),
+      failed(false),
+      ring(static_cast<unsigned>(std::max<size_t>(queue_depth, 1)))
+{
+    if (this->fd < 0)
+    {
+        throw IOError("Failed to open output file \"" + path + "\"", "IOManager.write()");
+    }
+
+    this->memory = allocateBlocks(std::max<size_t>(queue_depth, 1));
+    this->pending.assign(this->memory.size(), 0);
+    this->offsets.assign(this->memory.size(), 0);
+    this->ring.registerBuffers(describeBlocks(this->memory));
+}
+
+// Деструктор писателя
+RingFileWriter::~RingFileWriter()
+{
+    try
+    {
+        while (this->in_flight > 0)
+            this->reap();
+    }
+    catch (const IOError &)
+    {
+    }
+    for (char *block : this->memory)
+        free(block);
+    if (this->fd >= 0)
+        ::close(this->fd);
+}
+
+// Метод для ожидания завершения одной записи
+void RingFileWriter::reap()
+{
+    uint64_t tag;
+    int64_t result = this->ring.wait(tag);
+    --this->in_flight;
+
+    // Короткая запись дописывается синхронно
+    size_t length = this->pending[tag];
+    uint64_t offset = this->offsets[tag];
+    if (result >= 0 && static_cast<size_t>(result) < length)
+    {
+        size_t put = static_cast<size_t>(result);
+        while (put < length)
+        {
+            ssize_t more = pwrite(this->fd, this->memory[tag] + put, length - put, offset + put);
+            if (more <= 0)
+                break;
+            put += more;
+        }
+        result = put;
+    }
+    if (result < 0 || static_cast<size_t>(result) != length)
+        this->failed = true;
+    this->pending[tag] = 0;
+}
+
+// Метод для отправки текущего буфера на запись
+void RingFileWriter::flush()
+{
+    if (this->filled == 0)
+        return;
+
+    this->pending[this->current] = this->filled;
+    this->offsets[this->current] = this->file_offset;
+    this->ring.write(this->fd, this->current, this->filled, this->file_offset, this->current);
+    this->file_offset += this->filled;
+    ++this->in_flight;
+
+    // Следующий буфер может быть ещё в обработке
+    this->current = (this->current + 1) % this->memory.size();
+    this->filled = 0;
+    while (this->pending[this->current] != 0)
+        this->reap();
+    if (this->failed)
+    {
+        throw IOError("Failed to write output file", "RingFileWriter.write()");
+    }
+}
+
+// Метод для дозаписи данных
+void RingFileWriter::write(const void *data, size_t length)
+{
+    const char *in = static_cast<const char *>(data);
+    while (length > 0)
+    {
+        size_t take = std::min(length, RING_BLOCK_SIZE - this->filled);
+        std::memcpy(this->memory[this->current] + this->filled, in, take);
+        this->filled += take;
+        in += take;
+        length -= take;
+        if (this->filled == RING_BLOCK_SIZE)
+            this->flush();
+    }
+}
+
+// Метод для завершения записи
+void RingFileWriter::close()
+{
+    this->flush();
+    while (this->in_flight > 0)
+        this->reap();
+    if (this->fd >= 0 && ::close(this->fd) != 0)
+        this->failed = true;
+    this->fd = -1;
+    if (this->failed)
+    {
+        throw IOError("Failed to write output file", "RingFileWriter.close()");
+    }
+}
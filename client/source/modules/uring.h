@@ -0,0 +1,246 @@
+#ifndef URING_H
+#define URING_H
+
+#include <cstdint>
+#include <cstddef>
+#include <deque>
+#include <string>
+#include <utility>
+#include <vector>
+#include <sys/uio.h>
+#include "errors.h"
+
+/**
+* @file uring.h
+* @brief Определения классов для файлового ввода-вывода через io_uring.
+* @details Этот файл содержит определения минимальной обёртки над системными вызовами
+* io_uring и классов для чтения входного файла с упреждением и асинхронной записи
+* результатов через зарегистрированные буферы. Если io_uring недоступен (старое ядро
+* или запрет seccomp), операции выполняются синхронно через pread/pwrite.
+* @date 17.10.2026
+* @version 1.0
+* @authors Косов Р. С.
+* @copyright ИБСТ ПГУ
+*/
+
+/**
+* @brief Кольцо отправки и завершения операций ввода-вывода.
+*/
+class IoRing
+{
+public:
+    /**
+    * @brief Конструктор класса IoRing.
+    * @param entries Максимальное количество операций в обработке.
+    */
+    explicit IoRing(unsigned entries);
+
+    /**
+    * @brief Деструктор класса IoRing.
+    */
+    ~IoRing();
+
+    IoRing(const IoRing &) = delete;
+    IoRing &operator=(const IoRing &) = delete;
+
+    /**
+    * @brief Метод для проверки, используется ли io_uring.
+    * @return false, если операции выполняются через pread/pwrite.
+    */
+    bool active() const;
+
+    /**
+    * @brief Метод для регистрации буферов в ядре.
+    * @details Буферы должны оставаться действительными до уничтожения кольца.
+    * @param buffers Буферы.
+    */
+    void registerBuffers(const std::vector<struct iovec> &buffers);
+
+    /**
+    * @brief Метод для постановки чтения в очередь.
+    * @param fd Дескриптор файла.
+    * @param buffer Номер буфера.
+    * @param length Количество байтов.
+    * @param offset Смещение в файле.
+    * @param tag Метка операции.
+    */
+    void read(int fd, size_t buffer, size_t length, uint64_t offset, uint64_t tag);
+
+    /**
+    * @brief Метод для постановки записи в очередь.
+    * @param fd Дескриптор файла.
+    * @param buffer Номер буфера.
+    * @param length Количество байтов.
+    * @param offset Смещение в файле.
+    * @param tag Метка операции.
+    */
+    void write(int fd, size_t buffer, size_t length, uint64_t offset, uint64_t tag);
+
+    /**
+    * @brief Метод для ожидания завершения одной операции.
+    * @param tag Метка завершённой операции.
+    * @return Результат операции (количество байтов или -errno).
+    * @throw IOError Если ожидание завершилось ошибкой.
+    */
+    int64_t wait(uint64_t &tag);
+
+private:
+    int ring_fd; ///< Дескриптор io_uring (-1 - синхронный режим).
+    void *sq_ptr; ///< Отображение кольца отправки.
+    size_t sq_size; ///< Размер отображения кольца отправки.
+    void *cq_ptr; ///< Отображение кольца завершения.
+    size_t cq_size; ///< Размер отображения кольца завершения.
+    void *sqes_ptr; ///< Отображение массива запросов.
+    size_t sqes_size; ///< Размер отображения массива запросов.
+    unsigned *sq_tail; ///< Хвост кольца отправки.
+    unsigned *sq_mask; ///< Маска кольца отправки.
+    unsigned *sq_array; ///< Массив индексов запросов.
+    unsigned *cq_head; ///< Голова кольца завершения.
+    unsigned *cq_tail; ///< Хвост кольца завершения.
+    unsigned *cq_mask; ///< Маска кольца завершения.
+    void *cqes; ///< Массив завершений.
+    unsigned to_submit; ///< Количество запросов, ещё не переданных ядру.
+    bool fixed; ///< Флаг регистрации буферов в ядре.
+    std::vector<struct iovec> buffers; ///< Буферы операций.
+    std::deque<std::pair<uint64_t, int64_t>> completed; ///< Завершения синхронного режима.
+
+    /**
+    * @brief Метод для постановки запроса в кольцо отправки.
+    * @param opcode Код операции.
+    * @param fd Дескриптор файла.
+    * @param buffer Номер буфера.
+    * @param length Количество байтов.
+    * @param offset Смещение в файле.
+    * @param tag Метка операции.
+    */
+    void push(uint8_t opcode, int fd, size_t buffer, size_t length, uint64_t offset, uint64_t tag);
+};
+
+/**
+* @brief Класс для чтения файла с упреждением.
+* @details Файл читается блоками в кольцо зарегистрированных буферов, в обработке
+* одновременно находится до queue_depth блоков.
+*/
+class RingFileReader
+{
+public:
+    /**
+    * @brief Конструктор класса RingFileReader.
+    * @param path Путь к файлу.
+    * @param queue_depth Количество блоков, читаемых с упреждением.
+    * @throw IOError Если не удалось открыть файл.
+    */
+    RingFileReader(const std::string &path, size_t queue_depth);
+
+    /**
+    * @brief Деструктор класса RingFileReader.
+    */
+    ~RingFileReader();
+
+    RingFileReader(const RingFileReader &) = delete;
+    RingFileReader &operator=(const RingFileReader &) = delete;
+
+    /**
+    * @brief Метод для чтения очередных байтов файла.
+    * @param data Буфер для данных.
+    * @param length Количество байтов.
+    * @return false, если файл закончился раньше.
+    * @throw IOError Если чтение завершилось ошибкой.
+    */
+    bool read(void *data, size_t length);
+
+    /**
+    * @brief Метод для проверки, используется ли io_uring.
+    * @return false, если чтение выполняется через pread.
+    */
+    bool async() const;
+
+private:
+    /**
+    * @brief Блок упреждающего чтения.
+    */
+    struct Slot
+    {
+        uint64_t offset; ///< Смещение блока в файле.
+        size_t length; ///< Количество прочитанных байтов.
+        size_t position; ///< Количество уже выданных байтов.
+        bool ready; ///< Флаг завершения чтения.
+    };
+
+    int fd; ///< Дескриптор файла.
+    uint64_t file_size; ///< Размер файла.
+    uint64_t next_offset; ///< Смещение следующего блока для чтения.
+    std::vector<char *> memory; ///< Память блоков.
+    std::vector<Slot> slots; ///< Блоки.
+    size_t current; ///< Номер текущего блока.
+    IoRing ring; ///< Кольцо операций.
+
+    /**
+    * @brief Метод для постановки чтения блока в очередь.
+    * @param slot Номер блока.
+    */
+    void submit(size_t slot);
+};
+
+/**
+* @brief Класс для асинхронной записи файла.
+* @details Данные накапливаются в зарегистрированных буферах, заполненный буфер
+* записывается асинхронно, пока заполняется следующий.
+*/
+class RingFileWriter
+{
+public:
+    /**
+    * @brief Конструктор класса RingFileWriter.
+    * @param path Путь к файлу.
+    * @param queue_depth Количество буферов записи.
+    * @throw IOError Если не удалось открыть файл.
+    */
+    RingFileWriter(const std::string &path, size_t queue_depth);
+
+    /**
+    * @brief Деструктор класса RingFileWriter.
+    */
+    ~RingFileWriter();
+
+    RingFileWriter(const RingFileWriter &) = delete;
+    RingFileWriter &operator=(const RingFileWriter &) = delete;
+
+    /**
+    * @brief Метод для дозаписи данных.
+    * @param data Данные.
+    * @param length Количество байтов.
+    * @throw IOError Если запись завершилась ошибкой.
+    */
+    void write(const void *data, size_t length);
+
+    /**
+    * @brief Метод для завершения записи.
+    * @throw IOError Если запись завершилась ошибкой.
+    */
+    void close();
+
+private:
+    int fd; ///< Дескриптор файла.
+    uint64_t file_offset; ///< Смещение следующего буфера в файле.
+    std::vector<char *> memory; ///< Память буферов.
+    std::vector<size_t> pending; ///< Длина записи в обработке для каждого буфера (0 - свободен).
+    std::vector<uint64_t> offsets; ///< Смещение записи в обработке для каждого буфера.
+    size_t current; ///< Номер заполняемого буфера.
+    size_t filled; ///< Заполнение текущего буфера.
+    size_t in_flight; ///< Количество записей в обработке.
+    bool failed; ///< Флаг ошибки записи.
+    IoRing ring; ///< Кольцо операций.
+
+    /**
+    * @brief Метод для отправки текущего буфера на запись.
+    */
+    void flush();
+
+    /**
+    * @brief Метод для ожидания завершения одной записи.
+    */
+    void reap();
+};
+
+#endif // URING_H
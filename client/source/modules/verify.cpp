@@ -0,0 +1,175 @@
+#include "verify.h"
+#include "compute.h"
+#include "log.h"
+#include <cmath>
+#include <cstring>
+#include <string>
+#include <type_traits>
+
+// Функция для проверки результата вектора одного типа
+template <typename T>
+static bool matches(const char *values, uint32_t size, uint64_t server, T &local, T &remote)
+{
+    // Значения векторов лежат подряд с начала буфера, поэтому выровнены по типу
+    local = reduceVector(reinterpret_cast<const T *>(values), size);
+    std::memcpy(&remote, &server, sizeof(T));
+
+    // Результаты сравниваются побитово, два NaN считаются совпавшими
+    if (std::memcmp(&local, &remote, sizeof(T)) == 0)
+        return true;
+    return !std::is_integral<T>::value && std::isnan(static_cast<double>(local)) &&
+           std::isnan(static_cast<double>(remote));
+}
+
+// Конструктор
+ResultVerifier::ResultVerifier(double fraction, size_t threads)
+    : threshold(fraction >= 1 ? (uint64_t(1) << 32) : fraction <= 0 ? 0 : static_cast<uint64_t>(fraction * 4294967296.0)),
+      capacity(2 * (threads > 0 ? threads : 1) + 2),
+      closed(false),
+      checked_count(0),
+      mismatch_count(0)
+{
+    for (size_t i = 0; i < (threads > 0 ? threads : 1); ++i)
+        this->workers.emplace_back(&ResultVerifier::work, this);
+}
+
+// Деструктор
+ResultVerifier::~ResultVerifier()
+{
+    this->finish();
+}
+
+bool ResultVerifier::sampled(uint64_t index) const
+{
+    // Номер перемешивается, чтобы отбор не зависел от границ порций
+    uint64_t hash = (index + 1) * 0x9E3779B97F4A7C15ULL;
+    return (hash >> 32) < this->threshold;
+}
+
+// Метод для копирования отобранных векторов порции
+template <typename T>
+VerifySample ResultVerifier::prepare(const BasicVectorView<T> *views, size_t count, uint64_t first_index) const
+{
+    VerifySample sample;
+    sample.type = DataTypeOf<T>::value;
+    for (size_t i = 0; i < count; ++i)
+    {
+        if (!this->sampled(first_index + i))
+            continue;
+        const char *data = reinterpret_cast<const char *>(views[i].data);
+        sample.positions.push_back(static_cast<uint32_t>(i));
+        sample.indices.push_back(first_index + i);
+        sample.sizes.push_back(views[i].size);
+        sample.values.insert(sample.values.end(), data, data + views[i].size * sizeof(T));
+    }
+    return sample;
+}
+
+// Метод для постановки отобранных векторов в очередь проверки
+template <typename T>
+void ResultVerifier::submit(VerifySample sample, const T *results)
+{
+    if (sample.positions.empty())
+        return;
+    sample.results.resize(sample.positions.size(), 0);
+    for (size_t k = 0; k < sample.positions.size(); ++k)
+        std::memcpy(&sample.results[k], results + sample.positions[k], sizeof(T));
+
+    std::unique_lock<std::mutex> lock(this->mutex);
+    this->changed.wait(lock, [this]()
+                       { return this->queue.size() < this->capacity || this->closed; });
+    if (this->closed)
+        return;
+    this->queue.push_back(std::move(sample));
+    this->changed.notify_all();
+}
+
+void ResultVerifier::finish()
+{
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->closed = true;
+    }
+    this->changed.notify_all();
+    for (auto &worker : this->workers)
+        worker.join();
+    this->workers.clear();
+}
+
+uint64_t ResultVerifier::checked() const
+{
+    return this->checked_count.load();
+}
+
+uint64_t ResultVerifier::mismatches() const
+{
+    return this->mismatch_count.load();
+}
+
+// Метод потока проверки
+void ResultVerifier::work()
+{
+    for (;;)
+    {
+        VerifySample sample;
+        {
+            // После закрытия очередь дочитывается до конца
+            std::unique_lock<std::mutex> lock(this->mutex);
+            this->changed.wait(lock, [this]()
+                               { return !this->queue.empty() || this->closed; });
+            if (this->queue.empty())
+                return;
+            sample = std::move(this->queue.front());
+            this->queue.pop_front();
+        }
+        this->changed.notify_all();
+        this->check(sample);
+    }
+}
+
+// Метод для проверки отобранных векторов
+void ResultVerifier::check(const VerifySample &sample)
+{
+    const char *values = sample.values.data();
+    for (size_t k = 0; k < sample.positions.size(); ++k)
+    {
+        bool ok = true;
+        std::string local, remote;
+        switch (sample.type)
+        {
+#define CHECK_TYPE(TYPE, T)                                                                  \
+    case DataType::TYPE:                                                                     \
+    {                                                                                        \
+        T l, r;                                                                              \
+        ok = matches<T>(values, sample.sizes[k], sample.results[k], l, r);                   \
+        if (!ok)                                                                             \
+        {                                                                                    \
+            local = std::to_string(l);                                                       \
+            remote = std::to_string(r);                                                      \
+        }                                                                                    \
+        values += sample.sizes[k] * sizeof(T);                                               \
+        break;                                                                               \
+    }
+            CHECK_TYPE(UINT16, uint16_t)
+            CHECK_TYPE(INT16, int16_t)
+            CHECK_TYPE(UINT32, uint32_t)
+            CHECK_TYPE(INT32, int32_t)
+            CHECK_TYPE(UINT64, uint64_t)
+            CHECK_TYPE(INT64, int64_t)
+            CHECK_TYPE(FLOAT, float)
+            CHECK_TYPE(DOUBLE, double)
+#undef CHECK_TYPE
+        }
+
+        ++this->checked_count;
+        if (!ok && ++this->mismatch_count <= MAX_REPORTED)
+            LOG_WARN("ResultVerifier.check()", "Result of vector " << sample.indices[k] << " differs: server="
+                                                                   << remote << " local=" << local);
+    }
+}
+
+// Явное инстанцирование для поддерживаемых типов данных
+#define INSTANTIATE_VERIFY(T)                                                                              \
+    template VerifySample ResultVerifier::prepare<T>(const BasicVectorView<T> *, size_t, uint64_t) const; \
+    template void ResultVerifier::submit<T>(VerifySample, const T *);
+FOR_EACH_DATA_TYPE(INSTANTIATE_VERIFY)
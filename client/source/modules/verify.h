@@ -0,0 +1,133 @@
+#ifndef VERIFY_H
+#define VERIFY_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "batch.h"
+#include "mapped.h"
+#include "types.h"
+
+/**
+* @file verify.h
+* @brief Определения класса выборочной проверки результатов сервера.
+* @details Доля векторов, отбираемых по номеру с начала передачи, копируется
+* вместе с результатами сервера и пересчитывается локальным вычислителем
+* (compute.h) в фоновых потоках. Отбор по хешу номера детерминирован,
+* поэтому повторный запуск проверяет те же векторы.
+* @date 17.10.2026
+* @version 1.0
+* @authors Косов Р. С.
+* @copyright ИБСТ ПГУ
+*/
+
+/**
+* @brief Отобранные для проверки векторы порции.
+*/
+struct VerifySample
+{
+    DataType type; ///< Тип значений векторов.
+    std::vector<uint32_t> positions; ///< Номера отобранных векторов в порции.
+    std::vector<uint64_t> indices; ///< Номера отобранных векторов с начала передачи.
+    std::vector<uint32_t> sizes; ///< Размеры отобранных векторов.
+    std::vector<char> values; ///< Значения отобранных векторов подряд.
+    std::vector<uint64_t> results; ///< Результаты сервера (биты значения типа в младших байтах).
+};
+
+/**
+* @brief Класс выборочной проверки результатов сервера.
+* @details Методы prepare() и submit() потокобезопасны. Если проверка
+* отстаёт, submit() ждёт освобождения места в очереди.
+*/
+class ResultVerifier
+{
+public:
+    /// Количество выводимых в журнал расхождений.
+    static const uint64_t MAX_REPORTED = 10;
+
+    /**
+    * @brief Конструктор класса ResultVerifier.
+    * @param fraction Доля проверяемых векторов (от 0 до 1).
+    * @param threads Количество потоков проверки.
+    */
+    ResultVerifier(double fraction, size_t threads);
+
+    /**
+    * @brief Деструктор класса ResultVerifier.
+    */
+    ~ResultVerifier();
+
+    ResultVerifier(const ResultVerifier &) = delete;
+    ResultVerifier &operator=(const ResultVerifier &) = delete;
+
+    /**
+    * @brief Метод для проверки, отбирается ли вектор.
+    * @param index Номер вектора с начала передачи.
+    * @return true, если результат вектора проверяется.
+    */
+    bool sampled(uint64_t index) const;
+
+    /**
+    * @brief Метод для копирования отобранных векторов порции.
+    * @param views Представления векторов порции.
+    * @param count Количество векторов.
+    * @param first_index Номер первого вектора порции с начала передачи.
+    * @return Отобранные векторы.
+    */
+    template <typename T>
+    VerifySample prepare(const BasicVectorView<T> *views, size_t count, uint64_t first_index) const;
+
+    /**
+    * @brief Метод для постановки отобранных векторов в очередь проверки.
+    * @param sample Отобранные векторы.
+    * @param results Результаты сервера для всей порции.
+    */
+    template <typename T>
+    void submit(VerifySample sample, const T *results);
+
+    /**
+    * @brief Метод для ожидания проверки всех поставленных векторов и остановки потоков.
+    */
+    void finish();
+
+    /**
+    * @brief Метод для получения количества проверенных результатов.
+    * @return Количество проверенных результатов.
+    */
+    uint64_t checked() const;
+
+    /**
+    * @brief Метод для получения количества расхождений.
+    * @return Количество результатов сервера, не совпавших с локальными.
+    */
+    uint64_t mismatches() const;
+
+private:
+    uint64_t threshold; ///< Порог хеша номера для отбора (из 2^32).
+    size_t capacity; ///< Наибольшая длина очереди.
+    std::deque<VerifySample> queue; ///< Очередь проверки.
+    std::mutex mutex; ///< Мьютекс очереди.
+    std::condition_variable changed; ///< Условие изменения очереди.
+    bool closed; ///< Флаг завершения приёма.
+    std::vector<std::thread> workers; ///< Потоки проверки.
+    std::atomic<uint64_t> checked_count; ///< Количество проверенных результатов.
+    std::atomic<uint64_t> mismatch_count; ///< Количество расхождений.
+
+    /**
+    * @brief Метод потока проверки.
+    */
+    void work();
+
+    /**
+    * @brief Метод для проверки отобранных векторов.
+    * @param sample Отобранные векторы с результатами сервера.
+    */
+    void check(const VerifySample &sample);
+};
+
+#endif // VERIFY_H
@@ -0,0 +1,553 @@
+#include "generator.h"
+#include "../../client/source/modules/container.h"
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <cmath>
+#include <condition_variable>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <memory>
+#include <fstream>
+#include <limits>
+#include <mutex>
+#include <new>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+// Примерный объём одного блока генерации
+static const size_t BLOCK_BYTES = 4 * 1024 * 1024;
+
+// Выравнивание буферов блоков
+static const size_t BUFFER_ALIGN = 4096;
+
+// Генератор начальных состояний (splitmix64)
+static uint64_t splitmix64(uint64_t &state) {
+    uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+static inline uint64_t rotl(uint64_t x, int k) {
+    return (x << k) | (x >> (64 - k));
+}
+
+// Четыре независимые дорожки xoshiro256** - циклы по дорожкам векторизуются
+class Xoshiro4 {
+public:
+    explicit Xoshiro4(uint64_t seed) : buffered(4) {
+        for (int lane = 0; lane < 4; ++lane) {
+            for (int word = 0; word < 4; ++word) {
+                s[word][lane] = splitmix64(seed);
+            }
+        }
+    }
+
+    // Следующие четыре 64-битных значения
+    void next(uint64_t out[4]) {
+        for (int l = 0; l < 4; ++l) {
+            out[l] = rotl(s[1][l] * 5, 7) * 9;
+        }
+        for (int l = 0; l < 4; ++l) {
+            uint64_t t = s[1][l] << 17;
+            s[2][l] ^= s[0][l];
+            s[3][l] ^= s[1][l];
+            s[1][l] ^= s[2][l];
+            s[0][l] ^= s[3][l];
+            s[2][l] ^= t;
+            s[3][l] = rotl(s[3][l], 45);
+        }
+    }
+
+    // Следующее 64-битное значение (по одному из четырёх дорожек)
+    uint64_t next64() {
+        if (buffered == 4) {
+            next(pending);
+            buffered = 0;
+        }
+        return pending[buffered++];
+    }
+
+    // Заполнение области случайными байтами
+    void fill(void *dst, size_t bytes) {
+        unsigned char *p = static_cast<unsigned char *>(dst);
+        uint64_t out[4];
+        while (bytes >= sizeof(out)) {
+            next(out);
+            std::memcpy(p, out, sizeof(out));
+            p += sizeof(out);
+            bytes -= sizeof(out);
+        }
+        if (bytes > 0) {
+            next(out);
+            std::memcpy(p, out, bytes);
+        }
+    }
+
+private:
+    uint64_t s[4][4]; // s[слово состояния][дорожка]
+    uint64_t pending[4]; // Значения для next64()
+    int buffered; // Количество выданных значений из pending
+};
+
+// Функция для заполнения области значениями типа T, равномерными по всему диапазону
+template <typename T>
+static void fill_values(Xoshiro4 &rng, void *dst, size_t n) {
+    rng.fill(dst, n * sizeof(T));
+    if constexpr (std::is_integral<T>::value) {
+        // Случайные биты - равномерно распределённые целые
+        return;
+    } else {
+        // Старшие биты мантиссы переводятся в [0, максимум типа)
+        typedef typename std::conditional<sizeof(T) == 4, uint32_t, uint64_t>::type Bits;
+        const int shift = sizeof(T) == 4 ? 8 : 11;
+        const T scale = std::numeric_limits<T>::max() / static_cast<T>(Bits(1) << (sizeof(Bits) * 8 - shift));
+        unsigned char *p = static_cast<unsigned char *>(dst);
+        for (size_t i = 0; i < n; ++i, p += sizeof(T)) {
+            Bits bits;
+            std::memcpy(&bits, p, sizeof(bits));
+            T value = static_cast<T>(bits >> shift) * scale;
+            std::memcpy(p, &value, sizeof(value));
+        }
+    }
+}
+
+// Равномерное число в [0, 1)
+static inline double next_unit(Xoshiro4 &rng) {
+    return (rng.next64() >> 11) * 0x1.0p-53;
+}
+
+// Равномерное целое в [0, range) (range == 0 - весь 64-битный диапазон)
+static inline uint64_t next_below(Xoshiro4 &rng, uint64_t range) {
+    uint64_t r = rng.next64();
+    if (range == 0) {
+        return r;
+    }
+    return static_cast<uint64_t>((static_cast<unsigned __int128>(r) * range) >> 64);
+}
+
+// Распределение Ципфа на рангах 1..n (метод отбора с инверсией, O(1) на значение)
+class ZipfSampler {
+public:
+    ZipfSampler(double n, double s) : n(n), s(s) {
+        if (!(s > 0)) {
+            throw std::runtime_error("Zipf exponent must be positive");
+        }
+        h_integral_x1 = h_integral(1.5) - 1;
+        h_integral_n = h_integral(n + 0.5);
+        s_div = 2 - h_integral_inverse(h_integral(2.5) - h(2));
+    }
+
+    // Ранг от 1 до n
+    uint64_t sample(Xoshiro4 &rng) const {
+        for (;;) {
+            double u = h_integral_n + next_unit(rng) * (h_integral_x1 - h_integral_n);
+            double x = h_integral_inverse(u);
+            double k = std::floor(x + 0.5);
+            if (k < 1) {
+                k = 1;
+            } else if (k > n) {
+                k = n;
+            }
+            if (k - x <= s_div || u >= h_integral(k + 0.5) - h(k)) {
+                return static_cast<uint64_t>(k);
+            }
+        }
+    }
+
+private:
+    double n, s;
+    double h_integral_x1, h_integral_n, s_div;
+
+    double h(double x) const { return std::exp(-s * std::log(x)); }
+    double h_integral(double x) const {
+        double log_x = std::log(x);
+        return helper2((1 - s) * log_x) * log_x;
+    }
+    double h_integral_inverse(double x) const {
+        double t = std::max(x * (1 - s), -1.0);
+        return std::exp(helper1(t) * x);
+    }
+    static double helper1(double x) {
+        return std::fabs(x) > 1e-8 ? std::log1p(x) / x : 1 - x * (0.5 - x * (1.0 / 3 - 0.25 * x));
+    }
+    static double helper2(double x) {
+        return std::fabs(x) > 1e-8 ? std::expm1(x) / x : 1 + x * 0.5 * (1 + x / 3 * (1 + 0.25 * x));
+    }
+};
+
+// Функция для разбора значения типа T из параметра
+template <typename T>
+static T parse_value(const std::string &text, const char *name) {
+    T value{};
+    auto result = std::from_chars(text.data(), text.data() + text.size(), value);
+    if (result.ec != std::errc() || result.ptr != text.data() + text.size()) {
+        throw std::runtime_error(std::string("Invalid value for ") + name + ": " + text);
+    }
+    return value;
+}
+
+// Генератор значений по выбранному распределению
+template <typename T>
+class ValueSampler {
+public:
+    explicit ValueSampler(const GeneratorOptions &options)
+        : kind(options.distribution), zero_ratio(options.zero_ratio), zipf(1, 1) {
+        if (kind != "uniform" && kind != "zipf" && kind != "constant" && kind != "sorted" && kind != "sparse") {
+            throw std::runtime_error("Unsupported distribution: " + kind);
+        }
+        if (!(zero_ratio >= 0 && zero_ratio <= 1)) {
+            throw std::runtime_error("Zero ratio must be in [0, 1]");
+        }
+
+        // Границы по умолчанию: весь диапазон целого типа, [0, максимум) для плавающей точки
+        T default_min = std::is_integral<T>::value && kind != "zipf" ? std::numeric_limits<T>::lowest() : T(0);
+        min = options.min_value.empty() ? default_min : parse_value<T>(options.min_value, "--min");
+        max = options.max_value.empty() ? std::numeric_limits<T>::max() : parse_value<T>(options.max_value, "--max");
+        constant = parse_value<T>(options.constant_value, "--value");
+        if (min > max) {
+            throw std::runtime_error("--min must not exceed --max");
+        }
+        full_range = options.min_value.empty() && options.max_value.empty() && kind == "uniform";
+
+        if constexpr (std::is_integral<T>::value) {
+            span = static_cast<uint64_t>(static_cast<int64_t>(max)) - static_cast<uint64_t>(static_cast<int64_t>(min));
+            if constexpr (std::is_unsigned<T>::value) {
+                span = static_cast<uint64_t>(max) - static_cast<uint64_t>(min);
+            }
+        }
+        if (kind == "zipf") {
+            double ranks = std::is_integral<T>::value ? static_cast<double>(span) + 1
+                                                      : std::floor(static_cast<double>(max) - static_cast<double>(min)) + 1;
+            zipf = ZipfSampler(ranks, options.zipf_s);
+        }
+    }
+
+    // Заполнение области n значениями (область может быть не выровнена)
+    void fill(Xoshiro4 &rng, void *dst, size_t n, std::vector<T> &scratch) const {
+        if (full_range) {
+            fill_values<T>(rng, dst, n);
+            return;
+        }
+
+        scratch.resize(n);
+        for (size_t i = 0; i < n; ++i) {
+            if (kind == "constant") {
+                scratch[i] = constant;
+            } else if (kind == "zipf") {
+                scratch[i] = offset(zipf.sample(rng) - 1);
+            } else if (kind == "sparse" && next_unit(rng) < zero_ratio) {
+                scratch[i] = T(0);
+            } else {
+                scratch[i] = uniform(rng);
+            }
+        }
+        if (kind == "sorted") {
+            std::sort(scratch.begin(), scratch.end());
+        }
+        std::memcpy(dst, scratch.data(), n * sizeof(T));
+    }
+
+private:
+    std::string kind;
+    double zero_ratio;
+    T min, max, constant;
+    uint64_t span = 0;
+    bool full_range;
+    ZipfSampler zipf;
+
+    // Равномерное значение в [min, max]
+    T uniform(Xoshiro4 &rng) const {
+        if constexpr (std::is_integral<T>::value) {
+            return offset(next_below(rng, span + 1));
+        } else {
+            double u = next_unit(rng);
+            return static_cast<T>(static_cast<double>(min) * (1 - u) + static_cast<double>(max) * u);
+        }
+    }
+
+    // Значение min + k
+    T offset(uint64_t k) const {
+        if constexpr (std::is_integral<T>::value) {
+            return static_cast<T>(static_cast<uint64_t>(static_cast<int64_t>(min)) + k);
+        } else {
+            return static_cast<T>(static_cast<double>(min) + static_cast<double>(k));
+        }
+    }
+};
+
+// Генератор размеров векторов
+class SizeSampler {
+public:
+    explicit SizeSampler(const GeneratorOptions &options)
+        : kind(options.size_distribution), min(options.size_min), max(options.size),
+          zipf(std::max<double>(1, static_cast<double>(options.size) - options.size_min + 1), options.zipf_s) {
+        if (kind != "fixed" && kind != "uniform" && kind != "zipf") {
+            throw std::runtime_error("Unsupported size distribution: " + kind);
+        }
+        if (kind != "fixed" && (min == 0 || min > max)) {
+            throw std::runtime_error("--size-min must be in [1, SIZE]");
+        }
+    }
+
+    uint32_t next(Xoshiro4 &rng) const {
+        if (kind == "uniform") {
+            return min + static_cast<uint32_t>(next_below(rng, static_cast<uint64_t>(max) - min + 1));
+        }
+        if (kind == "zipf") {
+            return min + static_cast<uint32_t>(zipf.sample(rng) - 1);
+        }
+        return max;
+    }
+
+private:
+    std::string kind;
+    uint32_t min, max;
+    ZipfSampler zipf;
+};
+
+// Выровненный буфер блока
+class AlignedBuffer {
+public:
+    AlignedBuffer() : data(nullptr), length(0), capacity(0) {}
+    AlignedBuffer(const AlignedBuffer &) = delete;
+    AlignedBuffer &operator=(const AlignedBuffer &) = delete;
+    ~AlignedBuffer() { std::free(data); }
+
+    // Увеличение буфера до n байтов (содержимое не сохраняется)
+    char *reserve(size_t n) {
+        if (n > capacity) {
+            std::free(data);
+            data = nullptr;
+            capacity = 0;
+            void *mem = nullptr;
+            if (posix_memalign(&mem, BUFFER_ALIGN, n) != 0) {
+                throw std::bad_alloc();
+            }
+            data = static_cast<char *>(mem);
+            capacity = n;
+        }
+        return data;
+    }
+
+    char *data;
+    size_t length;
+
+private:
+    size_t capacity;
+};
+
+// Блок сгенерированных векторов
+struct Block {
+    AlignedBuffer buffer; // Сериализованные записи
+    std::vector<uint32_t> sizes; // Размеры векторов
+    std::vector<size_t> records; // Начала записей в буфере (и конец последней)
+    bool ready = false;
+};
+
+// Функция для сериализации блока векторов в буфер
+template <typename T>
+static void build_block(const GeneratorOptions &options, const ValueSampler<T> &values, const SizeSampler &sizes,
+                        uint64_t first, uint64_t vectors, Block &block,
+                        std::vector<T> &row, std::vector<T> &scratch) {
+    // Зерно блока зависит только от общего зерна и номера первого вектора
+    uint64_t block_state = options.seed ^ (first * 0xD1B54A32D192ED03ULL);
+    Xoshiro4 rng(splitmix64(block_state));
+
+    // Запись: bin - размер | значения, bin2 - только значения, txt - строка размера и строка значений
+    const size_t max_chars = 32;
+    size_t max_record = options.file_type == "txt" ? 12 + static_cast<size_t>(options.size) * max_chars
+                      : options.file_type == "bin" ? sizeof(uint32_t) + static_cast<size_t>(options.size) * sizeof(T)
+                                                   : static_cast<size_t>(options.size) * sizeof(T);
+    char *begin = block.buffer.reserve(vectors * max_record);
+    char *p = begin;
+    block.sizes.clear();
+    block.records.clear();
+
+    for (uint64_t i = 0; i < vectors; ++i) {
+        block.records.push_back(p - begin);
+
+        // Повтор одного из предыдущих векторов блока
+        if (i > 0 && options.repeat_ratio > 0 && next_unit(rng) < options.repeat_ratio) {
+            size_t source = next_below(rng, i);
+            size_t length = block.records[source + 1] - block.records[source];
+            std::memcpy(p, begin + block.records[source], length);
+            p += length;
+            block.sizes.push_back(block.sizes[source]);
+            continue;
+        }
+
+        uint32_t size = sizes.next(rng);
+        block.sizes.push_back(size);
+        if (options.file_type == "txt") {
+            p = std::to_chars(p, p + 12, size).ptr;
+            *p++ = '\n';
+            row.resize(size);
+            values.fill(rng, row.data(), size, scratch);
+            for (uint32_t k = 0; k < size; ++k) {
+                p = std::to_chars(p, p + max_chars, row[k]).ptr;
+                *p++ = ' ';
+            }
+            *p++ = '\n';
+        } else {
+            if (options.file_type == "bin") {
+                std::memcpy(p, &size, sizeof(size));
+                p += sizeof(size);
+            }
+            values.fill(rng, p, size, scratch);
+            p += static_cast<size_t>(size) * sizeof(T);
+        }
+    }
+    block.records.push_back(p - begin);
+    block.buffer.length = p - begin;
+}
+
+// Функция для генерации файла
+template <typename T>
+void generate(const GeneratorOptions &options) {
+    if (options.file_type != "bin" && options.file_type != "bin2" && options.file_type != "txt") {
+        throw std::runtime_error("Unsupported file type: " + options.file_type);
+    }
+    if (!(options.repeat_ratio >= 0 && options.repeat_ratio <= 1)) {
+        throw std::runtime_error("Repeat ratio must be in [0, 1]");
+    }
+    ValueSampler<T> values(options);
+    SizeSampler sizes(options);
+
+    // Количество векторов в блоке подбирается под BLOCK_BYTES (по среднему размеру вектора);
+    // оно не зависит от формата и типа, чтобы при одном зерне файлы bin, bin2 и txt совпадали
+    size_t mean_size = options.size_distribution == "fixed" ? options.size : (options.size_min + options.size) / 2;
+    size_t vector_bytes = mean_size * sizeof(uint64_t) + 4;
+    uint64_t block_vectors = std::max<size_t>(1, BLOCK_BYTES / vector_bytes);
+    uint64_t num_blocks = (options.count + block_vectors - 1) / block_vectors;
+    unsigned threads = std::max(1u, options.threads);
+
+    std::ofstream outfile;
+    std::unique_ptr<BasicContainerWriter<T>> container;
+    if (options.file_type == "bin2") {
+        container.reset(new BasicContainerWriter<T>(options.path));
+    } else {
+        outfile.open(options.path, std::ios::binary);
+        if (!outfile.is_open()) {
+            throw std::runtime_error("Error opening file: " + options.path);
+        }
+        if (options.file_type == "bin") {
+            uint32_t count = static_cast<uint32_t>(options.count);
+            outfile.write(reinterpret_cast<const char *>(&count), sizeof(count));
+        } else {
+            outfile << options.count << "\n";
+        }
+    }
+
+    // Кольцо буферов: блок b генерируется в ячейку b % slots, когда блок b - slots уже записан
+    size_t num_slots = 2 * threads;
+    std::vector<Block> slots(num_slots);
+    std::mutex mutex;
+    std::condition_variable changed;
+    uint64_t written = 0;
+    bool failed = false;
+    std::exception_ptr error;
+    std::atomic<uint64_t> next_block(0);
+
+    auto worker = [&]() {
+        std::vector<T> row, scratch;
+        for (;;) {
+            uint64_t b = next_block++;
+            if (b >= num_blocks) {
+                break;
+            }
+            Block &slot = slots[b % num_slots];
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                changed.wait(lock, [&] { return b < written + num_slots || failed; });
+                if (failed) {
+                    break;
+                }
+            }
+            try {
+                uint64_t first = b * block_vectors;
+                build_block<T>(options, values, sizes, first, std::min(block_vectors, options.count - first),
+                               slot, row, scratch);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (!error) {
+                    error = std::current_exception();
+                }
+                failed = true;
+                changed.notify_all();
+                break;
+            }
+            std::lock_guard<std::mutex> lock(mutex);
+            slot.ready = true;
+            changed.notify_all();
+        }
+    };
+
+    std::vector<std::thread> pool;
+    for (unsigned t = 0; t < threads; ++t) {
+        pool.emplace_back(worker);
+    }
+
+    // Запись блоков строго по порядку
+    try {
+        for (uint64_t b = 0; b < num_blocks; ++b) {
+            Block &slot = slots[b % num_slots];
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                changed.wait(lock, [&] { return slot.ready || failed; });
+                if (failed) {
+                    break;
+                }
+            }
+
+            if (container) {
+                // Значения векторов лежат подряд, начало каждого - из записей блока
+                for (size_t i = 0; i < slot.sizes.size(); ++i) {
+                    const T *vector = reinterpret_cast<const T *>(slot.buffer.data + slot.records[i]);
+                    container->append(vector, slot.sizes[i]);
+                }
+            } else {
+                outfile.write(slot.buffer.data, slot.buffer.length);
+                if (!outfile) {
+                    throw std::runtime_error("Error writing file: " + options.path);
+                }
+            }
+
+            std::lock_guard<std::mutex> lock(mutex);
+            slot.ready = false;
+            written = b + 1;
+            changed.notify_all();
+        }
+    } catch (...) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!error) {
+            error = std::current_exception();
+        }
+        failed = true;
+        changed.notify_all();
+    }
+
+    for (auto &thread : pool) {
+        thread.join();
+    }
+    if (error) {
+        std::rethrow_exception(error);
+    }
+
+    if (container) {
+        container->close();
+    } else {
+        outfile.close();
+        if (!outfile) {
+            throw std::runtime_error("Error writing file: " + options.path);
+        }
+    }
+}
+
+// Явное инстанцирование для поддерживаемых типов данных
+#define INSTANTIATE_GENERATOR(T) template void generate<T>(const GeneratorOptions &);
+FOR_EACH_DATA_TYPE(INSTANTIATE_GENERATOR)
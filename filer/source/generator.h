@@ -0,0 +1,64 @@
+#ifndef FILER_GENERATOR_H
+#define FILER_GENERATOR_H
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+
+/**
+* @file generator.h
+* @brief Определения генератора входных файлов.
+* @details Векторы генерируются блоками в несколько потоков: у каждого блока свой
+* генератор xoshiro256** (четыре независимые дорожки, заполнение векторизуется
+* компилятором), блок сериализуется в выровненный буфер, а буферы записываются
+* в файл по порядку. Содержимое файла зависит только от зерна и параметров
+* распределений, но не от количества потоков.
+* @date 17.10.2026
+* @version 1.0
+* @authors Косов Р. С.
+* @copyright ИБСТ ПГУ
+*/
+
+/**
+* @brief Параметры генерации файла.
+*/
+struct GeneratorOptions
+{
+    std::string path; ///< Путь к выходному файлу.
+    std::string file_type; ///< Формат файла: bin, bin2 или txt.
+    uint64_t count; ///< Количество векторов.
+    uint32_t size; ///< Размер каждого вектора (максимальный при переменном размере).
+    unsigned threads; ///< Количество потоков генерации.
+    uint64_t seed; ///< Зерно генератора.
+
+    std::string distribution = "uniform"; ///< Распределение значений: uniform, zipf, constant, sorted, sparse.
+    std::string min_value; ///< Нижняя граница значений (пустая - по умолчанию для типа).
+    std::string max_value; ///< Верхняя граница значений (пустая - максимум типа).
+    std::string constant_value = "1"; ///< Значение для распределения constant.
+    double zipf_s = 1.1; ///< Показатель распределения Ципфа.
+    double zero_ratio = 0.9; ///< Доля нулей для распределения sparse.
+    double repeat_ratio = 0; ///< Вероятность повтора одного из предыдущих векторов блока.
+
+    std::string size_distribution = "fixed"; ///< Распределение размеров векторов: fixed, uniform, zipf.
+    uint32_t size_min = 1; ///< Минимальный размер вектора для переменного размера.
+};
+
+/**
+* @brief Функция для генерации файла.
+* @details Распределения значений (все, кроме constant, в диапазоне [min, max]):
+* - uniform: равномерное (по умолчанию весь диапазон целого типа или [0, максимум)
+*   для типов с плавающей точкой);
+* - zipf: min + (k - 1), где ранг k распределён по закону Ципфа (min по умолчанию 0);
+* - constant: все значения равны constant_value;
+* - sorted: равномерные значения, упорядоченные по возрастанию внутри вектора;
+* - sparse: ноль с вероятностью zero_ratio, иначе равномерное значение.
+* Размер вектора: fixed - size, uniform - равномерно в [size_min, size],
+* zipf - size_min + (k - 1) с рангом k по закону Ципфа (малые векторы чаще).
+* @tparam T Тип значений векторов.
+* @param options Параметры генерации.
+* @throw std::runtime_error Если параметры некорректны или не удалось записать файл.
+*/
+template <typename T>
+void generate(const GeneratorOptions &options);
+
+#endif // FILER_GENERATOR_H
@@ -0,0 +1,158 @@
+/**
+* @file main.cpp
+* @brief Главный файл локального сервера вычислений.
+* @details Этот файл содержит функцию main, которая разбирает параметры командной строки,
+* загружает базу пользователей и запускает сервер для заданного типа данных.
+* @date 17.10.2026
+* @version 1.0
+* @authors Косов Р. С.
+* @copyright ИБСТ ПГУ
+*/
+
+#include "modules/server.h"
+#include <csignal>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <thread>
+
+/**
+ * @brief Функция для печати справки.
+ */
+void print_help()
+{
+    std::cout << "Usage: server [options]\n"
+              << "Options:\n"
+              << "  -T DATA_TYPE   Type of data (uint16_t, int16_t, uint32_t, int32_t, uint64_t, int64_t, float, double; default: uint32_t)\n"
+              << "  -H HASH_TYPE   Hash function (only SHA1 is supported)\n"
+              << "  -S SALT_TYPE   Salt side (only client is supported)\n"
+              << "  -p PORT        Server port (default: 33333)\n"
+              << "  -b PATH        Path to user database, lines login:password (default: ./vcalc.conf)\n"
+              << "  -w WORKERS     Number of worker threads (default: number of cores)\n"
+              << "  -h             Show this help message and exit\n";
+}
+
+/**
+ * @brief Функция для загрузки базы пользователей.
+ * @param path Путь к файлу базы.
+ * @return База пользователей (логин - пароль).
+ * @throw std::runtime_error Если файл не удалось открыть или он пуст.
+ */
+std::map<std::string, std::string> load_users(const std::string &path)
+{
+    std::ifstream file(path);
+    if (!file.is_open())
+        throw std::runtime_error("Failed to open user database \"" + path + "\"");
+
+    std::map<std::string, std::string> users;
+    std::string line;
+    while (std::getline(file, line))
+    {
+        size_t colon = line.find(':');
+        if (colon == std::string::npos || colon == 0 || colon + 1 == line.size())
+            continue;
+        users[line.substr(0, colon)] = line.substr(colon + 1);
+    }
+
+    if (users.empty())
+        throw std::runtime_error("User database \"" + path + "\" is empty");
+    return users;
+}
+
+/**
+ * @brief Функция для запуска сервера заданного типа данных.
+ * @tparam T Тип значений векторов.
+ * @param port Порт сервера.
+ * @param users База пользователей.
+ * @param workers Количество рабочих потоков.
+ */
+template <typename T>
+void serve(uint16_t port, const std::map<std::string, std::string> &users, size_t workers)
+{
+    Server<T> server(port, users, workers);
+    std::signal(SIGINT, [](int)
+                { Server<T>::stop(); });
+    std::signal(SIGTERM, [](int)
+                { Server<T>::stop(); });
+    server.run();
+}
+
+/**
+ * @brief Главная функция сервера.
+ * @param argc Количество аргументов командной строки.
+ * @param argv Аргументы командной строки.
+ * @return Код завершения программы. 0 - успешное завершение, 1 - ошибка.
+ */
+int main(int argc, char *argv[])
+{
+    std::string data_type = "uint32_t";
+    std::string hash_type = "SHA1";
+    std::string salt_type = "client";
+    std::string users_path = "./vcalc.conf";
+    uint16_t port = 33333;
+    size_t workers = std::thread::hardware_concurrency();
+
+    try
+    {
+        for (int i = 1; i < argc; ++i)
+        {
+            if (std::strcmp(argv[i], "-T") == 0 && i + 1 < argc)
+                data_type = argv[++i];
+            else if (std::strcmp(argv[i], "-H") == 0 && i + 1 < argc)
+                hash_type = argv[++i];
+            else if (std::strcmp(argv[i], "-S") == 0 && i + 1 < argc)
+                salt_type = argv[++i];
+            else if (std::strcmp(argv[i], "-p") == 0 && i + 1 < argc)
+                port = std::stoi(argv[++i]);
+            else if (std::strcmp(argv[i], "-b") == 0 && i + 1 < argc)
+                users_path = argv[++i];
+            else if (std::strcmp(argv[i], "-w") == 0 && i + 1 < argc)
+                workers = std::stoul(argv[++i]);
+            else if (std::strcmp(argv[i], "-h") == 0)
+            {
+                print_help();
+                return 0;
+            }
+            else
+            {
+                print_help();
+                return 1;
+            }
+        }
+
+        if (hash_type != "SHA1")
+            throw std::runtime_error("Unsupported hash type: " + hash_type);
+        if (salt_type != "client")
+            throw std::runtime_error("Unsupported salt type: " + salt_type);
+
+        std::map<std::string, std::string> users = load_users(users_path);
+        std::cout << "Server: port " << port << ", type " << data_type
+                  << ", workers " << workers << std::endl;
+
+        if (data_type == "uint16_t")
+            serve<uint16_t>(port, users, workers);
+        else if (data_type == "int16_t")
+            serve<int16_t>(port, users, workers);
+        else if (data_type == "uint32_t")
+            serve<uint32_t>(port, users, workers);
+        else if (data_type == "int32_t")
+            serve<int32_t>(port, users, workers);
+        else if (data_type == "uint64_t")
+            serve<uint64_t>(port, users, workers);
+        else if (data_type == "int64_t")
+            serve<int64_t>(port, users, workers);
+        else if (data_type == "float")
+            serve<float>(port, users, workers);
+        else if (data_type == "double")
+            serve<double>(port, users, workers);
+        else
+            throw std::runtime_error("Unsupported data type: " + data_type);
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,87 @@
+#ifndef REDUCE_H
+#define REDUCE_H
+
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+/**
+* @file reduce.h
+* @brief Определение операции над вектором, выполняемой сервером.
+* @details Сервер вычисляет сумму значений вектора. Для целых типов сумма считается
+* точно (в расширенном типе) и в конце ограничивается диапазоном типа: при переполнении
+* вверх результат равен максимуму типа, вниз - минимуму. Для типов с плавающей точкой
+* значения складываются по порядку в исходном типе.
+* @date 17.10.2026
+* @version 1.0
+* @authors Косов Р. С.
+* @copyright ИБСТ ПГУ
+*/
+
+/**
+* @brief Накопитель суммы вектора для типа T.
+* @tparam T Тип значений вектора.
+*/
+template <typename T, bool Integral = std::is_integral<T>::value>
+struct Reduce;
+
+/**
+* @brief Накопитель суммы для целых типов (с насыщением).
+* @tparam T Целый тип значений.
+*/
+template <typename T>
+struct Reduce<T, true>
+{
+    __int128 sum; ///< Точная сумма значений.
+
+    Reduce() : sum(0) {}
+
+    /**
+    * @brief Метод для добавления значения.
+    * @param value Значение вектора.
+    */
+    void add(T value)
+    {
+        // Вектор содержит не более 2^32 значений - сумма 64-битных значений помещается в __int128
+        this->sum += value;
+    }
+
+    /**
+    * @brief Метод для получения результата.
+    * @return Сумма, ограниченная диапазоном типа.
+    */
+    T result() const
+    {
+        if (this->sum > static_cast<__int128>(std::numeric_limits<T>::max()))
+            return std::numeric_limits<T>::max();
+        if (this->sum < static_cast<__int128>(std::numeric_limits<T>::min()))
+            return std::numeric_limits<T>::min();
+        return static_cast<T>(this->sum);
+    }
+};
+
+/**
+* @brief Накопитель суммы для типов с плавающей точкой.
+* @tparam T Тип значений с плавающей точкой.
+*/
+template <typename T>
+struct Reduce<T, false>
+{
+    T sum; ///< Сумма значений.
+
+    Reduce() : sum(0) {}
+
+    /**
+    * @brief Метод для добавления значения.
+    * @param value Значение вектора.
+    */
+    void add(T value) { this->sum += value; }
+
+    /**
+    * @brief Метод для получения результата.
+    * @return Сумма значений.
+    */
+    T result() const { return this->sum; }
+};
+
+#endif // REDUCE_H
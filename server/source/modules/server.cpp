@@ -0,0 +1,358 @@
+#include "server.h"
+#include "../../../client/source/modules/crypt.h"
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+#include <thread>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+// Длина соли и хеша SHA1 в шестнадцатеричном виде
+static const size_t SALT_LENGTH = 16;
+static const size_t HASH_LENGTH = 40;
+
+// Размер буфера приёма рабочего потока
+static const size_t RECV_BUFFER_SIZE = 64 * 1024;
+
+// Объём неотправленных результатов, при котором приём приостанавливается
+static const size_t OUT_HIGH_WATER = 1024 * 1024;
+
+template <typename T>
+std::atomic<bool> Server<T>::running(false);
+
+// Конструктор подключения
+template <typename T>
+Connection<T>::Connection(int fd)
+    : fd(fd),
+      stage(AUTH),
+      vectors_left(0),
+      values_left(0),
+      partial_length(0),
+      out_position(0),
+      close_after_flush(false),
+      reading(true) {}
+
+// Конструктор
+template <typename T>
+Server<T>::Server(uint16_t port, const std::map<std::string, std::string> &users, size_t workers)
+    : port(port),
+      users(users),
+      workers(workers > 0 ? workers : 1),
+      listen_fd(-1) {}
+
+// Деструктор
+template <typename T>
+Server<T>::~Server()
+{
+    if (this->listen_fd >= 0)
+        ::close(this->listen_fd);
+}
+
+// Метод для остановки сервера
+template <typename T>
+void Server<T>::stop()
+{
+    running = false;
+}
+
+// Метод для запуска сервера
+template <typename T>
+void Server<T>::run()
+{
+    this->listen_fd = ::socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK, 0);
+    if (this->listen_fd < 0)
+        throw std::runtime_error("Failed to create socket");
+
+    int enable = 1;
+    setsockopt(this->listen_fd, SOL_SOCKET, SO_REUSEADDR, &enable, sizeof(enable));
+
+    struct sockaddr_in addr;
+    std::memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_ANY);
+    addr.sin_port = htons(this->port);
+    if (bind(this->listen_fd, (struct sockaddr *)&addr, sizeof(addr)) < 0)
+        throw std::runtime_error("Failed to bind port " + std::to_string(this->port));
+    if (listen(this->listen_fd, SOMAXCONN) < 0)
+        throw std::runtime_error("Failed to listen on port " + std::to_string(this->port));
+
+    running = true;
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < this->workers; ++i)
+        threads.emplace_back(&Server<T>::worker, this);
+    for (auto &thread : threads)
+        thread.join();
+}
+
+// Метод рабочего потока
+template <typename T>
+void Server<T>::worker()
+{
+    int epoll_fd = epoll_create1(0);
+    if (epoll_fd < 0)
+    {
+        std::cerr << "Error: failed to create epoll instance\n";
+        return;
+    }
+
+    // Слушающий сокет разделяется между потоками, каждое подключение будит один поток
+    struct epoll_event ev;
+    ev.events = EPOLLIN | EPOLLEXCLUSIVE;
+    ev.data.ptr = nullptr;
+    epoll_ctl(epoll_fd, EPOLL_CTL_ADD, this->listen_fd, &ev);
+
+    std::vector<Connection<T> *> connections;
+    struct epoll_event events[256];
+    std::vector<char> buffer(RECV_BUFFER_SIZE);
+
+    auto drop = [&](Connection<T> *conn)
+    {
+        epoll_ctl(epoll_fd, EPOLL_CTL_DEL, conn->fd, nullptr);
+        ::close(conn->fd);
+        connections.erase(std::find(connections.begin(), connections.end(), conn));
+        delete conn;
+    };
+
+    while (running)
+    {
+        int n = epoll_wait(epoll_fd, events, 256, 200);
+        if (n < 0 && errno != EINTR)
+            break;
+
+        for (int i = 0; i < n; ++i)
+        {
+            // Новые подключения
+            if (events[i].data.ptr == nullptr)
+            {
+                while (true)
+                {
+                    int fd = accept4(this->listen_fd, nullptr, nullptr, SOCK_NONBLOCK);
+                    if (fd < 0)
+                        break;
+                    int enable = 1;
+                    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &enable, sizeof(enable));
+
+                    Connection<T> *conn = new Connection<T>(fd);
+                    struct epoll_event cev;
+                    cev.events = EPOLLIN | EPOLLRDHUP;
+                    cev.data.ptr = conn;
+                    epoll_ctl(epoll_fd, EPOLL_CTL_ADD, fd, &cev);
+                    connections.push_back(conn);
+                }
+                continue;
+            }
+
+            Connection<T> *conn = static_cast<Connection<T> *>(events[i].data.ptr);
+            bool alive = true;
+            if (events[i].events & (EPOLLIN | EPOLLRDHUP | EPOLLHUP | EPOLLERR))
+            {
+                // Приём данных блоками в общий буфер потока
+                while (alive && conn->reading)
+                {
+                    ssize_t got = ::recv(conn->fd, buffer.data(), buffer.size(), 0);
+                    if (got > 0)
+                        alive = this->consume(*conn, buffer.data(), got);
+                    else if (got == 0 || (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR))
+                        alive = false;
+                    else if (errno != EINTR)
+                        break;
+
+                    // Приостановка приёма, пока клиент не заберёт результаты
+                    if (conn->out.size() - conn->out_position >= OUT_HIGH_WATER)
+                        conn->reading = false;
+                }
+            }
+            if (alive)
+                alive = this->onWritable(*conn);
+
+            if (!alive)
+            {
+                drop(conn);
+                continue;
+            }
+
+            // Подписка на события в зависимости от состояния буферов
+            struct epoll_event cev;
+            cev.events = EPOLLRDHUP;
+            if (conn->reading)
+                cev.events |= EPOLLIN;
+            if (conn->out_position < conn->out.size())
+                cev.events |= EPOLLOUT;
+            cev.data.ptr = conn;
+            epoll_ctl(epoll_fd, EPOLL_CTL_MOD, conn->fd, &cev);
+        }
+    }
+
+    while (!connections.empty())
+        drop(connections.back());
+    ::close(epoll_fd);
+}
+
+// Метод для отправки накопленных исходящих данных
+template <typename T>
+bool Server<T>::onWritable(Connection<T> &conn)
+{
+    while (conn.out_position < conn.out.size())
+    {
+        ssize_t sent = ::send(
+            conn.fd,
+            conn.out.data() + conn.out_position,
+            conn.out.size() - conn.out_position,
+            MSG_NOSIGNAL);
+        if (sent < 0)
+        {
+            if (errno == EINTR)
+                continue;
+            return errno == EAGAIN || errno == EWOULDBLOCK;
+        }
+        conn.out_position += sent;
+    }
+
+    conn.out.clear();
+    conn.out_position = 0;
+    if (conn.close_after_flush)
+        return false;
+
+    conn.reading = true;
+    return true;
+}
+
+// Метод для разбора принятого блока данных
+template <typename T>
+bool Server<T>::consume(Connection<T> &conn, const char *data, size_t length)
+{
+    size_t pos = 0;
+    while (pos < length)
+    {
+        if (conn.stage == Connection<T>::AUTH)
+        {
+            // Клиент ждёт ответа, поэтому всё принятое до ответа - сообщение аутентификации
+            conn.auth_message.append(data + pos, length - pos);
+            pos = length;
+            if (conn.auth_message.size() <= SALT_LENGTH + HASH_LENGTH)
+                break;
+
+            if (this->authenticate(conn.auth_message))
+            {
+                conn.out.insert(conn.out.end(), {'O', 'K'});
+                conn.stage = Connection<T>::COUNT;
+            }
+            else
+            {
+                conn.out.insert(conn.out.end(), {'E', 'R', 'R'});
+                conn.close_after_flush = true;
+                conn.reading = false;
+                return true;
+            }
+        }
+        else if (conn.stage == Connection<T>::COUNT || conn.stage == Connection<T>::SIZE)
+        {
+            // Сборка 4-байтового заголовка, возможно разорванного между блоками
+            size_t take = std::min(sizeof(uint32_t) - conn.partial_length, length - pos);
+            std::memcpy(conn.partial + conn.partial_length, data + pos, take);
+            conn.partial_length += take;
+            pos += take;
+            if (conn.partial_length < sizeof(uint32_t))
+                break;
+
+            uint32_t value;
+            std::memcpy(&value, conn.partial, sizeof(value));
+            conn.partial_length = 0;
+
+            if (conn.stage == Connection<T>::COUNT)
+            {
+                conn.vectors_left = value;
+                if (value > 0)
+                    conn.stage = Connection<T>::SIZE;
+                continue;
+            }
+
+            conn.values_left = value;
+            conn.acc = Reduce<T>();
+            conn.stage = Connection<T>::DATA;
+        }
+
+        if (conn.stage == Connection<T>::DATA)
+        {
+            // Дополнение значения, разорванного между блоками
+            if (conn.partial_length > 0 && conn.values_left > 0)
+            {
+                size_t take = std::min(sizeof(T) - conn.partial_length, length - pos);
+                std::memcpy(conn.partial + conn.partial_length, data + pos, take);
+                conn.partial_length += take;
+                pos += take;
+                if (conn.partial_length < sizeof(T))
+                    break;
+
+                T value;
+                std::memcpy(&value, conn.partial, sizeof(T));
+                conn.acc.add(value);
+                conn.partial_length = 0;
+                --conn.values_left;
+            }
+
+            // Целые значения обрабатываются прямо из буфера приёма
+            size_t whole = std::min(static_cast<size_t>(conn.values_left), (length - pos) / sizeof(T));
+            for (size_t i = 0; i < whole; ++i)
+            {
+                T value;
+                std::memcpy(&value, data + pos + i * sizeof(T), sizeof(T));
+                conn.acc.add(value);
+            }
+            pos += whole * sizeof(T);
+            conn.values_left -= whole;
+
+            if (conn.values_left > 0)
+            {
+                // Остаток блока - начало следующего значения
+                conn.partial_length = length - pos;
+                std::memcpy(conn.partial, data + pos, conn.partial_length);
+                pos = length;
+                break;
+            }
+
+            // Вектор обработан - результат ставится в очередь на отправку
+            T result = conn.acc.result();
+            const char *bytes = reinterpret_cast<const char *>(&result);
+            conn.out.insert(conn.out.end(), bytes, bytes + sizeof(T));
+            --conn.vectors_left;
+            conn.stage = conn.vectors_left > 0 ? Connection<T>::SIZE : Connection<T>::COUNT;
+        }
+    }
+    return true;
+}
+
+// Метод для проверки сообщения аутентификации
+template <typename T>
+bool Server<T>::authenticate(const std::string &message) const
+{
+    size_t login_length = message.size() - SALT_LENGTH - HASH_LENGTH;
+    std::string login = message.substr(0, login_length);
+    std::string salt = message.substr(login_length, SALT_LENGTH);
+    std::string hash = message.substr(login_length + SALT_LENGTH);
+
+    auto user = this->users.find(login);
+    if (user == this->users.end())
+        return false;
+
+    std::string expected = CryptManager::get_hash(salt, user->second);
+    std::transform(hash.begin(), hash.end(), hash.begin(), ::toupper);
+    return hash == expected;
+}
+
+// Явное инстанцирование для поддерживаемых типов данных
+template class Server<uint16_t>;
+template class Server<int16_t>;
+template class Server<uint32_t>;
+template class Server<int32_t>;
+template class Server<uint64_t>;
+template class Server<int64_t>;
+template class Server<float>;
+template class Server<double>;
@@ -0,0 +1,139 @@
+#ifndef SERVER_H
+#define SERVER_H
+
+#include <cstdint>
+#include <cstddef>
+#include <atomic>
+#include <map>
+#include <string>
+#include <vector>
+#include "reduce.h"
+
+/**
+* @file server.h
+* @brief Определения классов локального сервера вычислений.
+* @details Этот файл содержит определения классов сервера, совместимого по протоколу
+* с клиентом: аутентификация (логин + соль + SHA1-хеш соли и пароля) и обмен
+* векторами и результатами. Каждый рабочий поток обслуживает свой цикл epoll,
+* новые подключения распределяются между потоками ядром (EPOLLEXCLUSIVE).
+* @date 17.10.2026
+* @version 1.0
+* @authors Косов Р. С.
+* @copyright ИБСТ ПГУ
+*/
+
+/**
+* @brief Состояние одного подключения к серверу.
+* @tparam T Тип значений векторов.
+*/
+template <typename T>
+struct Connection
+{
+    /**
+    * @brief Этапы разбора входящего потока.
+    */
+    enum Stage
+    {
+        AUTH,  ///< Ожидание сообщения аутентификации.
+        COUNT, ///< Ожидание количества векторов.
+        SIZE,  ///< Ожидание размера вектора.
+        DATA   ///< Приём значений вектора.
+    };
+
+    int fd; ///< Дескриптор сокета.
+    Stage stage; ///< Текущий этап разбора.
+    std::string auth_message; ///< Накопленное сообщение аутентификации.
+    uint32_t vectors_left; ///< Количество векторов, оставшихся в текущей передаче.
+    uint32_t values_left; ///< Количество значений, оставшихся в текущем векторе.
+    char partial[sizeof(T) > 4 ? sizeof(T) : 4]; ///< Неполное значение или заголовок.
+    size_t partial_length; ///< Длина неполного значения или заголовка.
+    Reduce<T> acc; ///< Накопитель суммы текущего вектора.
+    std::vector<char> out; ///< Буфер исходящих данных.
+    size_t out_position; ///< Количество уже отправленных байтов буфера.
+    bool close_after_flush; ///< Флаг закрытия подключения после отправки буфера.
+    bool reading; ///< Флаг ожидания входящих данных.
+
+    /**
+    * @brief Конструктор структуры Connection.
+    * @param fd Дескриптор сокета.
+    */
+    explicit Connection(int fd);
+};
+
+/**
+* @brief Класс локального сервера вычислений.
+* @tparam T Тип значений векторов (задаётся параметром -T).
+*/
+template <typename T>
+class Server
+{
+public:
+    /**
+    * @brief Конструктор класса Server.
+    * @param port Порт сервера.
+    * @param users База пользователей (логин - пароль).
+    * @param workers Количество рабочих потоков.
+    */
+    Server(uint16_t port, const std::map<std::string, std::string> &users, size_t workers);
+
+    /**
+    * @brief Деструктор класса Server.
+    */
+    ~Server();
+
+    /**
+    * @brief Метод для запуска сервера (блокируется до вызова stop()).
+    * @throw std::runtime_error Если не удалось открыть порт.
+    */
+    void run();
+
+    /**
+    * @brief Метод для остановки сервера (безопасен для вызова из обработчика сигнала).
+    */
+    static void stop();
+
+private:
+    uint16_t port; ///< Порт сервера.
+    std::map<std::string, std::string> users; ///< База пользователей.
+    size_t workers; ///< Количество рабочих потоков.
+    int listen_fd; ///< Дескриптор слушающего сокета.
+
+    static std::atomic<bool> running; ///< Флаг работы сервера.
+
+    /**
+    * @brief Метод рабочего потока: цикл epoll.
+    */
+    void worker();
+
+    /**
+    * @brief Метод для чтения и разбора входящих данных.
+    * @param conn Подключение.
+    * @return false, если подключение нужно закрыть.
+    */
+    bool onReadable(Connection<T> &conn);
+
+    /**
+    * @brief Метод для отправки накопленных исходящих данных.
+    * @param conn Подключение.
+    * @return false, если подключение нужно закрыть.
+    */
+    bool onWritable(Connection<T> &conn);
+
+    /**
+    * @brief Метод для разбора принятого блока данных.
+    * @param conn Подключение.
+    * @param data Принятые данные.
+    * @param length Длина данных.
+    * @return false, если подключение нужно закрыть.
+    */
+    bool consume(Connection<T> &conn, const char *data, size_t length);
+
+    /**
+    * @brief Метод для проверки сообщения аутентификации.
+    * @param message Сообщение: логин, соль (16 символов) и хеш (40 символов).
+    * @return true, если аутентификация успешна.
+    */
+    bool authenticate(const std::string &message) const;
+};
+
+#endif // SERVER_H
@@ -3,9 +3,34 @@
 #include "../../client/source/modules/network.h"
 #include "../../client/source/modules/io.h"
 #include "../../client/source/modules/ui.h"
+#include "../../client/source/modules/pipeline.h"
+#include "../../client/source/modules/shard.h"
+#include "../../client/source/modules/daemon.h"
+#include "../../client/source/modules/manifest.h"
+#include "../../client/source/modules/crc32c.h"
+#include "../../client/source/modules/log.h"
+#include "../../client/source/modules/metrics.h"
+#include "../../client/source/modules/trace.h"
+#include "../../client/source/modules/cache.h"
+#include "../../client/source/modules/incremental.h"
+#include "../../client/source/modules/resume.h"
+#include "../../client/source/modules/compute.h"
+#include "../../client/source/modules/verify.h"
 #include <iostream>
 #include <fstream>
 #include <stdexcept>
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <sstream>
+#include <thread>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <poll.h>
+#include <unistd.h>
 
 /**
  * @file main.cpp
@@ -49,6 +74,27 @@ TEST(GetHash)
     CHECK(hash1 != hash2);
 }
 
+// Тест для пакетной генерации пар соль - хеш
+TEST(GetBatch)
+{
+    SaltHash tokens[4];
+    CryptManager::get_batch("P@ssW0rd", tokens, 4);
+
+    for (size_t i = 0; i < 4; ++i)
+    {
+        std::string salt(tokens[i].salt, SALT_HEX_LENGTH);
+        std::string hash(tokens[i].hash, HASH_HEX_LENGTH);
+
+        // Проверяем, что хеш совпадает с вычисленным по отдельности
+        CHECK_EQUAL(CryptManager::get_hash(salt, "P@ssW0rd"), hash);
+        CHECK(salt.find_first_not_of("0123456789ABCDEF") == std::string::npos);
+    }
+    CHECK(std::memcmp(tokens[0].salt, tokens[1].salt, SALT_HEX_LENGTH) != 0);
+
+    // Известное значение SHA1("abc")
+    CHECK_EQUAL(std::string("A9993E364706816ABA3E25717850C26C9CD0D89D"), CryptManager::get_hash("a", "bc"));
+}
+
 // Тест для конфигурации
 TEST(IOManagerConf)
 {
@@ -72,12 +118,38 @@ TEST(IOManagerRead)
     IOManager ioManager(
         "./config/vclient.conf",
         "./input.bin", "./output.bin");
-    std::vector<std::vector<uint32_t>> data = ioManager.read();
+    VectorBatch data = ioManager.read();
 
     // Проверяем, что данные не пустые
     CHECK(!data.empty());
 }
 
+// Тест для плоской порции векторов
+TEST(VectorBatchLayout)
+{
+    VectorBatch batch({{1, 2, 3}, {}, {4, 5}});
+
+    // Проверяем количество векторов и значений
+    CHECK_EQUAL((size_t)3, batch.size());
+    CHECK_EQUAL((size_t)5, batch.values());
+    CHECK_EQUAL((size_t)20, batch.bytes());
+
+    // Проверяем, что векторы лежат подряд в одном буфере
+    CHECK(batch[0] == std::vector<uint32_t>({1, 2, 3}));
+    CHECK_EQUAL((uint32_t)0, batch[1].size);
+    CHECK(batch[2] == std::vector<uint32_t>({4, 5}));
+    CHECK(batch[0].end() == batch[2].begin());
+
+    // Проверяем, что очистка сохраняет память для повторного использования
+    const uint32_t *arena = batch[0].data;
+    batch.clear();
+    CHECK(batch.empty());
+    uint32_t values[] = {7, 8};
+    batch.push_back(values, 2);
+    CHECK(batch[0].data == arena);
+    CHECK(batch[0] == std::vector<uint32_t>({7, 8}));
+}
+
 // Тест для записи
 TEST(IOManagerWrite)
 {
@@ -137,6 +209,481 @@ TEST(IOManagerWriteFileNotFound)
     CHECK_THROW(ioManager.write({1, 2, 3, 4, 5}), IOError);
 }
 
+// Тест для потокового чтения порциями
+TEST(IOManagerReaderChunks)
+{
+    IOManager ioManager(
+        "./config/vclient.conf",
+        "./input.bin", "./output.bin");
+    VectorBatch data = ioManager.read();
+
+    // Ограничение в один байт - каждый вектор читается отдельной порцией
+    VectorReader reader = ioManager.reader(1);
+    CHECK_EQUAL(data.size(), (size_t)reader.count());
+    CHECK_EQUAL((uint64_t)data.values(), reader.valuesLeft());
+
+    VectorBatch chunk;
+    size_t index = 0;
+    while (reader.next(chunk))
+    {
+        CHECK_EQUAL((size_t)1, chunk.size());
+        CHECK(std::equal(chunk[0].begin(), chunk[0].end(), data[index].begin()));
+        ++index;
+    }
+    CHECK_EQUAL(data.size(), index);
+    CHECK_EQUAL((uint32_t)0, reader.remaining());
+}
+
+// Тест для ошибки неполной потоковой записи
+TEST(IOManagerWriterCountMismatch)
+{
+    IOManager ioManager(
+        "./config/vclient.conf",
+        "./input.bin", "./output.bin");
+    ioManager.write(std::vector<uint32_t>({9}));
+    {
+        ResultWriter writer = ioManager.writer(3);
+        writer.append({1, 2});
+        CHECK_THROW(writer.append({3, 4}), IOError);
+        CHECK_THROW(writer.close(), IOError);
+    }
+
+    // Незавершённая запись удаляет временный файл и не трогает прежний выходной файл
+    std::ifstream part("./output.bin.part");
+    CHECK(!part.is_open());
+    std::ifstream output("./output.bin", std::ios::binary);
+    uint32_t header[2] = {0, 0};
+    output.read(reinterpret_cast<char *>(header), sizeof(header));
+    CHECK_EQUAL((uint32_t)1, header[0]);
+    CHECK_EQUAL((uint32_t)9, header[1]);
+}
+
+// Тест для чтения через отображение в память
+TEST(IOManagerMap)
+{
+    IOManager ioManager(
+        "./config/vclient.conf",
+        "./input.bin", "./output.bin");
+    VectorBatch data = ioManager.read();
+    MappedInput input = ioManager.map();
+    CHECK_EQUAL(data.size(), (size_t)input.count());
+
+    // Проверяем, что представления совпадают с прочитанными векторами
+    MappedChunk chunk;
+    CHECK(input.next(SIZE_MAX, chunk));
+    CHECK_EQUAL(data.size(), chunk.views.size());
+    CHECK_EQUAL(data.bytes() + data.size() * sizeof(uint32_t), chunk.wire_bytes);
+    for (size_t i = 0; i < chunk.views.size(); ++i)
+        CHECK(std::equal(chunk.views[i].begin(), chunk.views[i].end(), data[i].begin()));
+    CHECK(!input.next(SIZE_MAX, chunk));
+}
+
+// Тест для ошибки выхода размера вектора за границы файла
+TEST(IOManagerMapTruncated)
+{
+    // Подготовка файла, в котором размер вектора больше остатка файла
+    std::ofstream test_in("./test.bin", std::ios::binary);
+    uint32_t header[] = {1, 100, 1, 2};
+    test_in.write(reinterpret_cast<const char *>(header), sizeof(header));
+    test_in.close();
+
+    IOManager ioManager(
+        "./config/vclient.conf",
+        "./test.bin", "./output.bin");
+    MappedInput input = ioManager.map();
+    MappedChunk chunk;
+    CHECK_THROW(input.next(SIZE_MAX, chunk), DataDecodeError);
+
+    std::remove("./test.bin");
+}
+
+// Тест для ошибки повреждённого размера вектора при потоковом чтении
+TEST(IOManagerReaderCorruptSize)
+{
+    // Размер вектора в заголовке требует больше памяти, чем осталось в файле
+    std::ofstream test_in("./test.bin", std::ios::binary);
+    uint32_t header[] = {2, 1, 7, 0xFFFFFFFFu, 1};
+    test_in.write(reinterpret_cast<const char *>(header), sizeof(header));
+    test_in.close();
+
+    IOManager ioManager(
+        "./config/vclient.conf",
+        "./test.bin", "./output.bin");
+    VectorReader reader = ioManager.reader(SIZE_MAX);
+    VectorBatch chunk;
+    CHECK_THROW(reader.next(chunk), DataDecodeError);
+
+    // Количество векторов больше, чем может поместиться в файле
+    std::ofstream count_in("./test.bin", std::ios::binary);
+    uint32_t count_header[] = {0x40000000u, 0};
+    count_in.write(reinterpret_cast<const char *>(count_header), sizeof(count_header));
+    count_in.close();
+    CHECK_THROW(ioManager.reader(SIZE_MAX), DataDecodeError);
+
+    std::remove("./test.bin");
+}
+
+// Тест для чтения и записи векторов с 64-битными значениями
+TEST(IOManagerTypedRoundTrip)
+{
+    // Подготовка файла с двумя векторами int64_t
+    std::ofstream test_in("./test.bin", std::ios::binary);
+    uint32_t header[] = {2, 2};
+    int64_t first[] = {-5, 1LL << 40};
+    uint32_t size = 1;
+    int64_t second = -7;
+    test_in.write(reinterpret_cast<const char *>(header), sizeof(header));
+    test_in.write(reinterpret_cast<const char *>(first), sizeof(first));
+    test_in.write(reinterpret_cast<const char *>(&size), sizeof(size));
+    test_in.write(reinterpret_cast<const char *>(&second), sizeof(second));
+    test_in.close();
+
+    IOManager ioManager(
+        "./config/vclient.conf",
+        "./test.bin", "./test_out.bin");
+    BasicVectorBatch<int64_t> data = ioManager.read<int64_t>();
+    CHECK_EQUAL((size_t)2, data.size());
+    CHECK(data[0] == std::vector<int64_t>({-5, 1LL << 40}));
+    CHECK(data[1] == std::vector<int64_t>({-7}));
+
+    // Результаты записываются значениями того же типа
+    ioManager.write(std::vector<int64_t>({-5 + (1LL << 40), -7}));
+    std::ifstream test_out("./test_out.bin", std::ios::binary);
+    uint32_t count;
+    int64_t results[2];
+    test_out.read(reinterpret_cast<char *>(&count), sizeof(count));
+    test_out.read(reinterpret_cast<char *>(results), sizeof(results));
+    CHECK_EQUAL((uint32_t)2, count);
+    CHECK_EQUAL(-5 + (1LL << 40), results[0]);
+    CHECK_EQUAL(-7, results[1]);
+
+    std::remove("./test.bin");
+    std::remove("./test_out.bin");
+}
+
+// Тест для чтения и записи через io_uring (файл больше нескольких блоков упреждения)
+TEST(IOManagerUringRoundTrip)
+{
+    std::ofstream test_in("./test.bin", std::ios::binary);
+    uint32_t num_vectors = 3000;
+    test_in.write(reinterpret_cast<const char *>(&num_vectors), sizeof(num_vectors));
+    std::vector<uint32_t> expected;
+    for (uint32_t v = 0; v < num_vectors; ++v)
+    {
+        uint32_t size = v % 200;
+        std::vector<uint32_t> values(size, v);
+        test_in.write(reinterpret_cast<const char *>(&size), sizeof(size));
+        test_in.write(reinterpret_cast<const char *>(values.data()), size * sizeof(uint32_t));
+        expected.push_back(v * size);
+    }
+    test_in.close();
+
+    IOManager ioManager(
+        "./config/vclient.conf",
+        "./test.bin", "./test_out.bin");
+    ioManager.setBackend(FileBackend::URING, 2);
+
+    // Порции по 4 КБ: размер вектора на границе порции откладывается
+    VectorReader reader = ioManager.reader(4096);
+    ResultWriter writer = ioManager.writer(reader.count());
+    VectorBatch chunk;
+    uint32_t index = 0;
+    while (reader.next(chunk))
+    {
+        std::vector<uint32_t> results;
+        for (size_t i = 0; i < chunk.size(); ++i, ++index)
+        {
+            CHECK_EQUAL(index % 200, chunk[i].size);
+            results.push_back(chunk[i].size > 0 ? chunk[i][0] * chunk[i].size : 0);
+        }
+        writer.append(results);
+    }
+    writer.close();
+    CHECK_EQUAL(num_vectors, index);
+
+    // Выходной файл совпадает с записанным обычным способом
+    std::ifstream test_out("./test_out.bin", std::ios::binary);
+    uint32_t count;
+    std::vector<uint32_t> results(num_vectors);
+    test_out.read(reinterpret_cast<char *>(&count), sizeof(count));
+    test_out.read(reinterpret_cast<char *>(results.data()), results.size() * sizeof(uint32_t));
+    CHECK_EQUAL(num_vectors, count);
+    CHECK(results == expected);
+    CHECK_EQUAL(EOF, test_out.get());
+
+    std::remove("./test.bin");
+    std::remove("./test_out.bin");
+}
+
+// Тест для CRC32C (контрольное значение для "123456789")
+TEST(Crc32c)
+{
+    const char data[] = "123456789";
+    CHECK_EQUAL(0xE3069283u, crc32c(data, 9));
+    CHECK_EQUAL(0xE3069283u, crc32cSoftware(data, 9));
+
+    // Вычисление по частям совпадает с вычислением целиком
+    CHECK_EQUAL(crc32c(data, 9), crc32c(data + 4, 5, crc32c(data, 4)));
+}
+
+// Функция для сравнения ядер всех поддерживаемых наборов инструкций с последовательной суммой
+template <typename T>
+static bool kernelsMatch(const std::vector<T> &values)
+{
+    // Сдвиг на одно значение от начала буфера проверяет невыровненные загрузки
+    std::vector<T> shifted(values.size() + 1);
+    std::copy(values.begin(), values.end(), shifted.begin() + 1);
+    for (size_t size = 0; size <= values.size(); size += 1 + size / 3)
+    {
+        T expected = reduceVector(values.data(), size, SimdLevel::SCALAR);
+        for (SimdLevel level : {SimdLevel::AVX2, SimdLevel::AVX512})
+        {
+            if (!simdSupported(level))
+                continue;
+            if (reduceVector(values.data(), size, level) != expected ||
+                reduceVector(shifted.data() + 1, size, level) != expected)
+                return false;
+        }
+    }
+    return true;
+}
+
+// Тест для локального вычисления: ядра AVX2/AVX-512 совпадают с последовательной суммой, насыщение как на сервере
+TEST(ComputeKernels)
+{
+    std::mt19937_64 random(42);
+    std::vector<uint16_t> u16(300);
+    std::vector<int16_t> i16(300);
+    std::vector<uint32_t> u32(300);
+    std::vector<int32_t> i32(300);
+    std::vector<uint64_t> u64(300);
+    std::vector<int64_t> i64(300);
+    for (size_t i = 0; i < 300; ++i)
+    {
+        uint64_t r = random();
+        u16[i] = static_cast<uint16_t>(r);
+        i16[i] = static_cast<int16_t>(r);
+        u32[i] = static_cast<uint32_t>(r);
+        i32[i] = static_cast<int32_t>(r);
+        u64[i] = r >> (r % 64);
+        i64[i] = static_cast<int64_t>(r) >> (r % 64);
+    }
+    CHECK(kernelsMatch(u16));
+    CHECK(kernelsMatch(i16));
+    CHECK(kernelsMatch(u32));
+    CHECK(kernelsMatch(i32));
+    CHECK(kernelsMatch(u64));
+    CHECK(kernelsMatch(i64));
+
+    // Крайние значения: переносы 64-битных частичных сумм и длинные 16-битные векторы
+    CHECK(kernelsMatch(std::vector<uint64_t>(100, std::numeric_limits<uint64_t>::max())));
+    CHECK(kernelsMatch(std::vector<int64_t>(100, std::numeric_limits<int64_t>::min())));
+    CHECK(kernelsMatch(std::vector<int16_t>(200000, std::numeric_limits<int16_t>::min())));
+    CHECK(kernelsMatch(std::vector<uint16_t>(200000, std::numeric_limits<uint16_t>::max())));
+
+    // Точная сумма ограничивается диапазоном типа, промежуточные переполнения не влияют на результат
+    std::vector<int16_t> small = {32767, 1, -5};
+    CHECK_EQUAL(32763, reduceVector(small.data(), small.size()));
+    std::vector<uint32_t> large(64, 0x80000000u);
+    CHECK_EQUAL(std::numeric_limits<uint32_t>::max(), reduceVector(large.data(), large.size()));
+    std::vector<int64_t> negative(64, std::numeric_limits<int64_t>::min());
+    negative.push_back(std::numeric_limits<int64_t>::max());
+    CHECK_EQUAL(std::numeric_limits<int64_t>::min(), reduceVector(negative.data(), negative.size()));
+    std::vector<uint64_t> balanced(64, std::numeric_limits<uint64_t>::max());
+    CHECK_EQUAL(std::numeric_limits<uint64_t>::max(), reduceVector(balanced.data(), balanced.size()));
+
+    // Значения с плавающей точкой складываются по порядку
+    std::vector<float> floats = {1e8f, 1.0f, -1e8f, 1.0f};
+    CHECK_EQUAL(1.0f, reduceVector(floats.data(), floats.size()));
+}
+
+// Тест для индексированного формата v2: произвольный доступ, чтение через IOManager и повреждение
+TEST(ContainerRoundTrip)
+{
+    BasicContainerWriter<int16_t> writer("./test.bin");
+    std::vector<int16_t> first = {1, -2, 3};
+    std::vector<int16_t> third = {7};
+    writer.append(first.data(), first.size());
+    writer.append(nullptr, 0);
+    writer.append(third.data(), third.size());
+    writer.close();
+    CHECK(isContainerFile("./test.bin"));
+
+    {
+        BasicContainerInput<int16_t> input("./test.bin");
+        CHECK_EQUAL((uint64_t)3, input.count());
+        CHECK(input.view(2) == third);
+        CHECK(input.verify(0));
+        CHECK_THROW(input.view(3), DataDecodeError);
+        CHECK_THROW(BasicContainerInput<int32_t>("./test.bin"), DataDecodeError);
+    }
+
+    // IOManager распознаёт формат по сигнатуре
+    IOManager ioManager(
+        "./config/vclient.conf",
+        "./test.bin", "./test_out.bin");
+    BasicVectorReader<int16_t> reader = ioManager.reader<int16_t>(4);
+    CHECK_EQUAL((uint32_t)3, reader.count());
+    BasicVectorBatch<int16_t> chunk;
+    CHECK(reader.next(chunk));
+    CHECK_EQUAL((size_t)1, chunk.size());
+    CHECK(chunk[0] == first);
+    CHECK(reader.next(chunk));
+    CHECK_EQUAL((size_t)2, chunk.size());
+    CHECK(chunk[1] == third);
+    CHECK(!reader.next(chunk));
+
+    // Повреждённое значение обнаруживается по CRC32C
+    std::fstream corrupt("./test.bin", std::ios::binary | std::ios::in | std::ios::out);
+    corrupt.seekp(sizeof(ContainerHeader));
+    corrupt.put(9);
+    corrupt.close();
+    BasicContainerInput<int16_t> input("./test.bin");
+    CHECK(!input.verify(0));
+    CHECK_THROW(input.read(0, SIZE_MAX, SIZE_MAX, chunk), DataDecodeError);
+
+    std::remove("./test.bin");
+}
+
+// Тест для чтения текстового формата
+TEST(TextInputRead)
+{
+    // Размер 0 допускает пустую строку значений, в конце строк - пробелы и '\r'
+    std::ofstream text_file("./test.txt", std::ios::binary);
+    text_file << "3\n2\n-5 7 \n0\n\n3\r\n1\t-2  30000\r\n";
+    text_file.close();
+    CHECK(isTextFile("./test.txt"));
+
+    int16_t values[3];
+    const char line[] = "4 -5 6";
+    CHECK(parseTextValues<int16_t>(line, line + 6, values, 3));
+    CHECK_EQUAL(-5, values[1]);
+    CHECK(!parseTextValues<int16_t>(line, line + 6, values, 2));
+    CHECK(!parseTextValues<uint16_t>(line, line + 6, reinterpret_cast<uint16_t *>(values), 3));
+    const char bad[] = "1 2x 3";
+    CHECK(!parseTextValues<int16_t>(bad, bad + 6, values, 3));
+
+    // IOManager распознаёт формат по первым строкам
+    IOManager ioManager(
+        "./config/vclient.conf",
+        "./test.txt", "./test_out.bin");
+    BasicVectorReader<int16_t> reader = ioManager.reader<int16_t>(4);
+    CHECK_EQUAL((uint32_t)3, reader.count());
+    BasicVectorBatch<int16_t> chunk;
+    CHECK(reader.next(chunk));
+    CHECK_EQUAL((size_t)2, chunk.size());
+    CHECK(chunk[0] == std::vector<int16_t>({-5, 7}));
+    CHECK_EQUAL((uint32_t)0, chunk[1].size);
+    CHECK(reader.next(chunk));
+    CHECK(chunk[0] == std::vector<int16_t>({1, -2, 30000}));
+    CHECK(!reader.next(chunk));
+
+    // Значение вне диапазона типа и обрыв файла
+    text_file.open("./test.txt", std::ios::binary);
+    text_file << "2\n1\n70000\n";
+    text_file.close();
+    BasicTextInput<int16_t> overflow("./test.txt");
+    CHECK_THROW(overflow.read(SIZE_MAX, SIZE_MAX, chunk), DataDecodeError);
+    BasicTextInput<int32_t> truncated("./test.txt");
+    BasicVectorBatch<int32_t> wide_chunk;
+    CHECK_THROW(truncated.read(SIZE_MAX, SIZE_MAX, wide_chunk), DataDecodeError);
+
+    // Двоичный файл не принимается за текстовый
+    std::ofstream binary_file("./test.txt", std::ios::binary);
+    uint32_t header[] = {1, 1, 42};
+    binary_file.write(reinterpret_cast<const char *>(header), sizeof(header));
+    binary_file.close();
+    CHECK(!isTextFile("./test.txt"));
+    std::remove("./test.txt");
+}
+
+// Тест для журнала с уровнями
+TEST(LoggerLevels)
+{
+    CHECK(parseLogLevel("warn") == LogLevel::WARN);
+    CHECK_THROW(parseLogLevel("verbose"), ArgsDecodeError);
+
+    FILE *out = std::tmpfile();
+    Logger::instance().setOutput(out, out);
+    Logger::setLevel(LogLevel::WARN);
+
+    // Отключённый уровень не вычисляет сообщение
+    int formatted = 0;
+    LOG_INFO("LoggerLevels", "hidden " << ++formatted);
+    CHECK_EQUAL(0, formatted);
+    std::vector<int> values = {1, 2, 3};
+    LOG_ERROR("LoggerLevels", "shown " << ++formatted << " " << logSample(values.begin(), values.end(), 2));
+    CHECK_EQUAL(1, formatted);
+    LOG_WARN("LoggerLevels", std::string(Logger::MESSAGE_SIZE + 10, 'x'));
+    Logger::instance().flush();
+
+    Logger::setLevel(LogLevel::INFO);
+    Logger::instance().setOutput(stdout, stderr);
+    std::rewind(out);
+    char text[1024] = {};
+    size_t length = std::fread(text, 1, sizeof(text) - 1, out);
+    std::fclose(out);
+    std::string written(text, length);
+    CHECK(written.find("hidden") == std::string::npos);
+    CHECK(written.find("Log: \"LoggerLevels\"\nshown 1 {1, 2, ...}\n") != std::string::npos);
+    CHECK(written.find(std::string(Logger::MESSAGE_SIZE - 3, 'x') + "...\n") != std::string::npos);
+}
+
+// Тест для кольцевого буфера приёма с переходом через границу
+TEST(RecvRingWrap)
+{
+    RecvRing ring(16);
+    uint32_t results[4];
+
+    // Заполняем 12 байт и забираем два результата
+    size_t length;
+    char *space = ring.space(length);
+    CHECK_EQUAL((size_t)16, length);
+    uint32_t first[] = {1, 2, 3};
+    std::memcpy(space, first, sizeof(first));
+    ring.commit(sizeof(first));
+    CHECK_EQUAL((size_t)2, ring.pop(results, 2));
+    CHECK_EQUAL((uint32_t)2, results[1]);
+
+    // Частичный результат не извлекается до поступления остальных байтов
+    space = ring.space(length);
+    CHECK_EQUAL((size_t)4, length);
+    uint32_t second[] = {4, 5};
+    std::memcpy(space, second, 4);
+    ring.commit(4);
+    space = ring.space(length);
+    std::memcpy(space, second + 1, 2);
+    ring.commit(2);
+    CHECK_EQUAL((size_t)2, ring.pop(results, 4));
+    CHECK_EQUAL((uint32_t)3, results[0]);
+    CHECK_EQUAL((uint32_t)4, results[1]);
+    CHECK_EQUAL((size_t)2, ring.readable());
+}
+
+// Тест для ограниченной очереди конвейера
+TEST(BoundedQueueClose)
+{
+    BoundedQueue<int> queue(2);
+    CHECK(queue.push(1));
+    CHECK(queue.push(2));
+
+    // После закрытия оставшиеся элементы извлекаются, новые не добавляются
+    queue.close();
+    CHECK(!queue.push(3));
+    int item = 0;
+    CHECK(queue.pop(item));
+    CHECK_EQUAL(1, item);
+    CHECK(queue.pop(item));
+    CHECK_EQUAL(2, item);
+    CHECK(!queue.pop(item));
+
+    // При сбросе оставшиеся элементы не извлекаются
+    BoundedQueue<int> discarded(2);
+    discarded.push(1);
+    discarded.close(true);
+    CHECK(!discarded.pop(item));
+}
+
 // Тест для установки соединения
 TEST(NetworkManagerConnect)
 {
@@ -167,12 +714,870 @@ TEST(NetworkManagerCalc)
     netManager.conn();
     netManager.auth("user", "P@ssW0rd");
 
-    std::vector<std::vector<uint32_t>> data = {{1, 2, 3}, {4, 5, 6}};
+    VectorBatch data({{1, 2, 3}, {4, 5, 6}});
     std::vector<uint32_t> results = netManager.calc(data);
 
     // Проверяем, что результаты не пустые
     CHECK(!results.empty());
+
+    // Проверяем, что вся порция отправлена одним вызовом sendmsg
+    CHECK_EQUAL((uint64_t)1, netManager.stats().send_calls);
+    CHECK_EQUAL((uint64_t)(4 + 2 * 4 + 6 * 4), netManager.stats().bytes_sent);
+    netManager.close();
+}
+
+// Тест для гистограммы длительностей
+TEST(LatencyHistogramPercentiles)
+{
+    // Малые значения хранятся точно, остальные - с погрешностью не более 1/32
+    CHECK_EQUAL((uint64_t)63, LatencyHistogram::bucketUpper(LatencyHistogram::bucketOf(63)));
+    for (uint64_t value : {(uint64_t)64, (uint64_t)1000, (uint64_t)123456789, UINT64_MAX})
+    {
+        uint64_t upper = LatencyHistogram::bucketUpper(LatencyHistogram::bucketOf(value));
+        CHECK(upper >= value);
+        CHECK(upper - value <= value / 32);
+    }
+
+    LatencyHistogram hist;
+    for (uint64_t value = 1; value <= 1000; ++value)
+        hist.record(value * 1000);
+    CHECK_EQUAL((uint64_t)1000, hist.count());
+    CHECK_EQUAL((uint64_t)1000, hist.min());
+    CHECK_EQUAL((uint64_t)1000000, hist.max());
+    CHECK_CLOSE(500000.0, (double)hist.percentile(0.5), 500000.0 / 32);
+    CHECK_CLOSE(990000.0, (double)hist.percentile(0.99), 990000.0 / 32);
+    CHECK_EQUAL((uint64_t)1000000, hist.percentile(1.0));
+}
+
+// Тест для метрик фаз и времени оборота векторов
+TEST(MetricsCalcPhases)
+{
+    Metrics &metrics = Metrics::instance();
+    metrics.reset();
+    Metrics::enable(true);
+
+    NetworkManager netManager("127.0.0.1", 33333);
+    netManager.conn();
+    netManager.auth("user", "P@ssW0rd");
+    VectorBatch data({{1, 2, 3}, {4, 5, 6}, {7}});
+    netManager.calc(data);
+    netManager.close();
+    Metrics::enable(false);
+
+    CHECK_EQUAL((uint64_t)1, metrics.histogram(Phase::CONN).count());
+    CHECK_EQUAL((uint64_t)1, metrics.histogram(Phase::AUTH).count());
+    CHECK_EQUAL((uint64_t)3, metrics.vectors(Phase::CALC_SEND));
+    CHECK_EQUAL((uint64_t)(4 + 3 * 4 + 7 * 4), metrics.bytes(Phase::CALC_SEND));
+    CHECK_EQUAL((uint64_t)3, metrics.rtt().count());
+    CHECK(metrics.rtt().min() > 0);
+
+    // Снимки содержат все фазы
+    std::string json = metrics.toJson();
+    CHECK(json.find("\"calc_recv\": {\"bytes\": ") != std::string::npos);
+    CHECK(json.find("\"vector_rtt_ns\": {\"count\": 3") != std::string::npos);
+    std::string prom = metrics.toPrometheus();
+    CHECK(prom.find("vclient_vector_rtt_seconds_count 3\n") != std::string::npos);
+    CHECK(prom.find("vclient_phase_vectors_total{phase=\"calc_send\"} 3\n") != std::string::npos);
+
+    // Без включения метрик таймеры ничего не учитывают
+    metrics.reset();
+    PhaseTimer timer(Phase::READ);
+    timer.stop(1, 1);
+    CHECK_EQUAL((uint64_t)0, metrics.histogram(Phase::READ).count());
+}
+
+// Тест для записи временной шкалы
+TEST(TraceTimeline)
+{
+    Tracer &tracer = Tracer::instance();
+    tracer.reset();
+    Tracer::enable(true);
+
+    // Обмен выполняется в отдельном потоке - у него своя дорожка
+    std::thread session([]
+                        {
+        Tracer::instance().nameThread("session");
+        NetworkManager netManager("127.0.0.1", 33333);
+        netManager.conn();
+        netManager.auth("user", "P@ssW0rd");
+        VectorBatch data({{1, 2, 3}, {4, 5, 6}, {7}});
+        netManager.calc(data);
+        netManager.close(); });
+    session.join();
+    {
+        TraceSpan span("outer", "test");
+    }
+    Tracer::enable(false);
+
+    // conn, auth, hash_batch, calc_send, calc_recv и outer
+    CHECK_EQUAL((uint64_t)6, tracer.count());
+    CHECK_EQUAL((uint64_t)0, tracer.dropped());
+    std::string json = tracer.toJson();
+    CHECK(json.find("\"traceEvents\": [") != std::string::npos);
+    CHECK(json.find("\"args\": {\"name\": \"session\"}") != std::string::npos);
+    CHECK(json.find("{\"name\": \"calc_send\", \"cat\": \"net\", \"ph\": \"X\"") != std::string::npos);
+    CHECK(json.find("\"args\": {\"bytes\": 44, \"vectors\": 3}") != std::string::npos);
+    CHECK(json.find("{\"name\": \"outer\", \"cat\": \"test\"") != std::string::npos);
+
+    // Без включения записи интервалы не сохраняются
+    tracer.reset();
+    {
+        TraceSpan span("skipped", "test");
+    }
+    PhaseTimer timer(Phase::READ);
+    timer.stop(1, 1);
+    CHECK_EQUAL((uint64_t)0, tracer.count());
+}
+
+// Тест для конвейерной обработки
+TEST(NetworkManagerPipeline)
+{
+    IOManager ioManager(
+        "./config/vclient.conf",
+        "./input.bin", "./pipeline.bin");
+    NetworkManager netManager("127.0.0.1", 33333);
+    netManager.conn();
+    netManager.auth("user", "P@ssW0rd");
+
+    // Ограничение памяти вынуждает отправлять каждый вектор отдельной порцией
+    Pipeline pipeline(ioManager, netManager, 1, 2, false);
+    pipeline.run();
+    netManager.close();
+
+    // Проверяем, что результаты совпадают с последовательной обработкой
+    NetworkManager seqManager("127.0.0.1", 33333);
+    seqManager.conn();
+    seqManager.auth("user", "P@ssW0rd");
+    std::vector<uint32_t> expected = seqManager.calc(ioManager.read());
+    seqManager.close();
+
+    std::ifstream output("./pipeline.bin", std::ios::binary);
+    uint32_t count = 0;
+    output.read(reinterpret_cast<char *>(&count), sizeof(count));
+    std::vector<uint32_t> results(count);
+    output.read(reinterpret_cast<char *>(results.data()), count * sizeof(uint32_t));
+    output.close();
+    CHECK(expected == results);
+
+    std::remove("./pipeline.bin");
+}
+
+// Тест для дискового кеша результатов
+TEST(ResultCacheStoreFind)
+{
+    std::remove("./cache.bin");
+    uint32_t a[] = {1, 2, 3};
+    uint32_t b[] = {3, 2, 1};
+    CacheKey keys[2] = {
+        ResultCache::key(DataType::UINT32, a, sizeof(a)),
+        ResultCache::key(DataType::UINT32, b, sizeof(b))};
+    uint64_t stored[2] = {6, 7};
+    uint64_t results[2];
+    bool found[2];
+
+    // Ключ зависит от типа значений и порядка байтов
+    CacheKey other = ResultCache::key(DataType::INT32, a, sizeof(a));
+    CHECK(other.hi != keys[0].hi || other.lo != keys[0].lo);
+    CHECK(keys[0].hi != keys[1].hi || keys[0].lo != keys[1].lo);
+    {
+        ResultCache cache("./cache.bin", 1 << 20);
+        CHECK_EQUAL((size_t)0, cache.find(keys, 2, results, found));
+        cache.store(keys, stored, 2);
+        CHECK_EQUAL((size_t)2, cache.find(keys, 2, results, found));
+        CHECK_EQUAL((uint64_t)6, results[0]);
+        CHECK_EQUAL((uint64_t)7, results[1]);
+
+        // Файл занят - второй экземпляр не открывается
+        CHECK_THROW(ResultCache busy("./cache.bin", 1 << 20), IOError);
+    }
+
+    // Записи сохраняются между запусками и при смене ограничения размера
+    {
+        ResultCache cache("./cache.bin", 1 << 16);
+        CHECK_EQUAL((uint64_t)2, cache.size());
+        CHECK_EQUAL((size_t)2, cache.find(keys, 2, results, found));
+        CHECK_EQUAL((uint64_t)7, results[1]);
+    }
+
+    // Маленькая таблица вытесняет старые записи и сохраняет новые
+    {
+        ResultCache cache("./cache.bin", 4096);
+        CHECK_EQUAL((uint64_t)ResultCache::MIN_SLOTS, cache.capacity());
+        CacheKey last;
+        for (uint32_t i = 0; i < 1000; ++i)
+        {
+            last = ResultCache::key(DataType::UINT32, &i, sizeof(i));
+            uint64_t value = i;
+            cache.store(&last, &value, 1);
+        }
+        CHECK(cache.size() <= cache.capacity());
+        CHECK(cache.evictions() > 0);
+        CHECK_EQUAL((size_t)1, cache.find(&last, 1, results, found));
+        CHECK_EQUAL((uint64_t)999, results[0]);
+    }
+    std::remove("./cache.bin");
+}
+
+// Тест для обмена с кешем результатов
+TEST(NetworkManagerCache)
+{
+    std::remove("./cache.bin");
+    ResultCache cache("./cache.bin", 1 << 20);
+    VectorBatch first({{1, 2, 3}, {4, 5, 6}});
+    VectorBatch second({{4, 5, 6}, {10, 20}, {1, 2, 3}, {}});
+
+    NetworkManager netManager("127.0.0.1", 33333);
+    netManager.setCache(&cache);
+    netManager.conn();
+    netManager.auth("user", "P@ssW0rd");
+    std::vector<uint32_t> results = netManager.calc(first);
+    CHECK(results == std::vector<uint32_t>({6, 15}));
+
+    // Серверу уходят только новые векторы, порядок результатов сохраняется
+    results = netManager.calc(second);
+    CHECK(results == std::vector<uint32_t>({15, 30, 6, 0}));
+    CHECK_EQUAL((uint64_t)2, cache.hits());
+    CHECK_EQUAL((uint64_t)4, cache.misses());
+
+    // Порция, целиком найденная в кеше, не требует обмена
+    uint64_t sent = netManager.stats().bytes_sent;
+    results = netManager.calc(first);
+    CHECK(results == std::vector<uint32_t>({6, 15}));
+    CHECK_EQUAL((uint64_t)0, netManager.stats().bytes_sent);
+    CHECK(sent > 0);
     netManager.close();
+
+    // Конвейер с кешем даёт те же результаты, что и без него
+    IOManager ioManager(
+        "./config/vclient.conf",
+        "./input.bin", "./pipeline.bin");
+    for (int pass = 0; pass < 2; ++pass)
+    {
+        NetworkManager pipeManager("127.0.0.1", 33333);
+        pipeManager.setCache(&cache);
+        pipeManager.conn();
+        pipeManager.auth("user", "P@ssW0rd");
+        Pipeline pipeline(ioManager, pipeManager, 1, 2, false);
+        pipeline.run();
+        pipeManager.close();
+
+        NetworkManager seqManager("127.0.0.1", 33333);
+        seqManager.conn();
+        seqManager.auth("user", "P@ssW0rd");
+        std::vector<uint32_t> expected = seqManager.calc(ioManager.read());
+        seqManager.close();
+
+        std::ifstream output("./pipeline.bin", std::ios::binary);
+        uint32_t count = 0;
+        output.read(reinterpret_cast<char *>(&count), sizeof(count));
+        std::vector<uint32_t> piped(count);
+        output.read(reinterpret_cast<char *>(piped.data()), count * sizeof(uint32_t));
+        CHECK(expected == piped);
+    }
+
+    std::remove("./pipeline.bin");
+    std::remove("./cache.bin");
+}
+
+// Тест для устранения повторов внутри порции
+TEST(NetworkManagerDedup)
+{
+    VectorBatch batch({{1, 2, 3}, {4, 5, 6}, {1, 2, 3}, {1, 2}, {4, 5, 6}, {1, 2, 3}, {}, {}});
+
+    NetworkManager netManager("127.0.0.1", 33333);
+    netManager.setDedup(true);
+    netManager.conn();
+    netManager.auth("user", "P@ssW0rd");
+
+    // Результат каждого различного вектора раздаётся всем повторам
+    std::vector<uint32_t> results = netManager.calc(batch);
+    CHECK(results == std::vector<uint32_t>({6, 15, 6, 3, 15, 6, 0, 0}));
+    CHECK_EQUAL((uint64_t)8, netManager.dedupStats().vectors);
+    CHECK_EQUAL((uint64_t)4, netManager.dedupStats().unique);
+
+    // Векторы с общим префиксом, но разной длины различаются
+    results = netManager.calc(VectorBatch({{7}, {7, 0}, {7}}));
+    CHECK(results == std::vector<uint32_t>({7, 7, 7}));
+    CHECK_EQUAL((uint64_t)2, netManager.dedupStats().unique);
+    netManager.close();
+
+    // Конвейер с устранением повторов и кешем даёт те же результаты, что и без них
+    std::remove("./cache.bin");
+    ResultCache cache("./cache.bin", 1 << 20);
+    IOManager ioManager(
+        "./config/vclient.conf",
+        "./input.bin", "./pipeline.bin");
+    NetworkManager pipeManager("127.0.0.1", 33333);
+    pipeManager.setDedup(true);
+    pipeManager.setCache(&cache);
+    pipeManager.conn();
+    pipeManager.auth("user", "P@ssW0rd");
+    Pipeline pipeline(ioManager, pipeManager, 1, 2, false);
+    pipeline.run();
+    pipeManager.close();
+
+    NetworkManager seqManager("127.0.0.1", 33333);
+    seqManager.conn();
+    seqManager.auth("user", "P@ssW0rd");
+    std::vector<uint32_t> expected = seqManager.calc(ioManager.read());
+    seqManager.close();
+
+    std::ifstream output("./pipeline.bin", std::ios::binary);
+    uint32_t count = 0;
+    output.read(reinterpret_cast<char *>(&count), sizeof(count));
+    std::vector<uint32_t> piped(count);
+    output.read(reinterpret_cast<char *>(piped.data()), count * sizeof(uint32_t));
+    CHECK(expected == piped);
+
+    std::remove("./pipeline.bin");
+    std::remove("./cache.bin");
+}
+
+// Тест для инкрементальной обработки с файлом отпечатков
+TEST(IncrementalCalcRerun)
+{
+    auto writeInput = [](const std::vector<uint32_t> &words)
+    {
+        std::ofstream test_in("./incr_in.bin", std::ios::binary);
+        test_in.write(reinterpret_cast<const char *>(words.data()), words.size() * sizeof(uint32_t));
+    };
+    auto readOutput = []()
+    {
+        std::ifstream output("./incr_out.bin", std::ios::binary);
+        uint32_t count = 0;
+        output.read(reinterpret_cast<char *>(&count), sizeof(count));
+        std::vector<uint32_t> results(count);
+        output.read(reinterpret_cast<char *>(results.data()), count * sizeof(uint32_t));
+        return results;
+    };
+    auto runOnce = []()
+    {
+        IOManager ioManager(
+            "./config/vclient.conf",
+            "./incr_in.bin", "./incr_out.bin");
+        NetworkManager netManager("127.0.0.1", 33333);
+        netManager.conn();
+        netManager.auth("user", "P@ssW0rd");
+        IncrementalCalc incremental(ioManager, netManager, "./incr_out.bin", 8, false);
+        incremental.run();
+        netManager.close();
+        return incremental.stats();
+    };
+    std::remove("./incr_out.bin");
+    std::remove("./incr_out.bin.vcinc");
+
+    // Первый запуск отправляет все векторы
+    writeInput({4, 3, 1, 2, 3, 2, 4, 5, 1, 7, 3, 10, 20, 30});
+    IncrementalStats stats = runOnce();
+    CHECK_EQUAL((uint64_t)4, stats.sent);
+    CHECK(!stats.in_place);
+    CHECK(readOutput() == std::vector<uint32_t>({6, 9, 7, 60}));
+
+    // Без изменений ничего не отправляется
+    stats = runOnce();
+    CHECK_EQUAL((uint64_t)0, stats.sent);
+    CHECK_EQUAL((uint64_t)0, stats.changed);
+    CHECK(stats.in_place);
+
+    // Изменённый вектор отправляется, выходной файл дописывается на месте
+    writeInput({4, 3, 1, 2, 3, 2, 4, 5, 1, 8, 3, 10, 20, 30});
+    stats = runOnce();
+    CHECK_EQUAL((uint64_t)1, stats.sent);
+    CHECK_EQUAL((uint64_t)1, stats.changed);
+    CHECK(stats.in_place);
+    CHECK(readOutput() == std::vector<uint32_t>({6, 9, 8, 60}));
+
+    // Переставленные векторы находятся по хешу, новые отправляются
+    writeInput({5, 2, 4, 5, 3, 1, 2, 3, 1, 8, 3, 10, 20, 30, 1, 100});
+    stats = runOnce();
+    CHECK_EQUAL((uint64_t)3, stats.changed);
+    CHECK_EQUAL((uint64_t)2, stats.moved);
+    CHECK_EQUAL((uint64_t)1, stats.sent);
+    CHECK(!stats.in_place);
+    CHECK(readOutput() == std::vector<uint32_t>({9, 6, 8, 60, 100}));
+
+    // Повреждённый файл отпечатков не используется
+    {
+        std::fstream sidecar("./incr_out.bin.vcinc", std::ios::binary | std::ios::in | std::ios::out);
+        sidecar.seekp(64 + 16);
+        sidecar.put('\x7f');
+    }
+    stats = runOnce();
+    CHECK_EQUAL((uint64_t)5, stats.sent);
+    CHECK(readOutput() == std::vector<uint32_t>({9, 6, 8, 60, 100}));
+
+    std::remove("./incr_in.bin");
+    std::remove("./incr_out.bin");
+    std::remove("./incr_out.bin.vcinc");
+}
+
+// Функция прокси к серверу, обрывающего первые dropped соединений после drop_after байтов от клиента
+static void runDroppingProxy(int listener, size_t drop_after, int dropped, int connections)
+{
+    for (int c = 0; c < connections; ++c)
+    {
+        int client = accept(listener, nullptr, nullptr);
+        if (client < 0)
+            return;
+        int server = socket(AF_INET, SOCK_STREAM, 0);
+        sockaddr_in addr = {};
+        addr.sin_family = AF_INET;
+        addr.sin_port = htons(33333);
+        inet_pton(AF_INET, "127.0.0.1", &addr.sin_addr);
+        connect(server, reinterpret_cast<sockaddr *>(&addr), sizeof(addr));
+
+        pollfd fds[2] = {{client, POLLIN, 0}, {server, POLLIN, 0}};
+        size_t forwarded = 0;
+        bool open = true;
+        char buffer[4096];
+        while (open && poll(fds, 2, -1) > 0)
+        {
+            for (int k = 0; k < 2 && open; ++k)
+            {
+                if (fds[k].revents == 0)
+                    continue;
+                ssize_t n = recv(fds[k].fd, buffer, sizeof(buffer), 0);
+                if (n <= 0 || (k == 0 && c < dropped && forwarded + n > drop_after))
+                {
+                    open = false;
+                    break;
+                }
+                send(fds[1 - k].fd, buffer, n, MSG_NOSIGNAL);
+                if (k == 0)
+                    forwarded += n;
+            }
+        }
+        close(client);
+        close(server);
+    }
+}
+
+// Функция для открытия слушающего сокета на свободном локальном порту
+static int listenLocal(uint16_t &port)
+{
+    int listener = socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in addr = {};
+    addr.sin_family = AF_INET;
+    inet_pton(AF_INET, "127.0.0.1", &addr.sin_addr);
+    bind(listener, reinterpret_cast<sockaddr *>(&addr), sizeof(addr));
+    listen(listener, 4);
+    socklen_t length = sizeof(addr);
+    getsockname(listener, reinterpret_cast<sockaddr *>(&addr), &length);
+    port = ntohs(addr.sin_port);
+    return listener;
+}
+
+// Тест для продолжения обработки после обрыва соединения
+TEST(ResumableCalcReconnect)
+{
+    // 300 векторов по 10 значений, порции по 10 векторов
+    {
+        std::ofstream test_in("./resume_in.bin", std::ios::binary);
+        uint32_t count = 300;
+        test_in.write(reinterpret_cast<const char *>(&count), sizeof(count));
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            uint32_t vector[11] = {10};
+            for (uint32_t j = 1; j <= 10; ++j)
+                vector[j] = i * j;
+            test_in.write(reinterpret_cast<const char *>(vector), sizeof(vector));
+        }
+    }
+    IOManager ioManager(
+        "./config/vclient.conf",
+        "./resume_in.bin", "./resume_out.bin");
+    NetworkManager seqManager("127.0.0.1", 33333);
+    seqManager.conn();
+    seqManager.auth("user", "P@ssW0rd");
+    std::vector<uint32_t> expected = seqManager.calc(ioManager.read());
+    seqManager.close();
+
+    auto readOutput = []()
+    {
+        std::ifstream output("./resume_out.bin", std::ios::binary);
+        uint32_t count = 0;
+        output.read(reinterpret_cast<char *>(&count), sizeof(count));
+        std::vector<uint32_t> results(count);
+        output.read(reinterpret_cast<char *>(results.data()), count * sizeof(uint32_t));
+        return results;
+    };
+    std::array<std::string, 2> credentials = {"user", "P@ssW0rd"};
+    std::remove("./resume_out.bin");
+
+    // Соединение, закрытое вместо ответа на аутентификацию, не считается успешным входом
+    uint16_t port;
+    int listener = listenLocal(port);
+    std::thread proxy(runDroppingProxy, listener, 0, 1, 1);
+    NetworkManager closedManager("127.0.0.1", port);
+    closedManager.conn();
+    CHECK_THROW(closedManager.auth("user", "P@ssW0rd"), AuthError);
+    closedManager.close();
+    proxy.join();
+    close(listener);
+
+    // Первое соединение обрывается, порция отправляется заново после переподключения
+    listener = listenLocal(port);
+    proxy = std::thread(runDroppingProxy, listener, 3000, 1, 2);
+    NetworkManager netManager("127.0.0.1", port);
+    ResumableCalc resumable(ioManager, netManager, credentials,
+                            "./resume_in.bin", "./resume_out.bin", 400, false, 3);
+    resumable.run();
+    netManager.close();
+    proxy.join();
+    close(listener);
+
+    CHECK_EQUAL((uint64_t)1, resumable.stats().reconnects);
+    CHECK_EQUAL((uint64_t)30, resumable.stats().checkpoints);
+    CHECK(readOutput() == expected);
+    CHECK(!std::ifstream("./resume_out.bin.part").good());
+    CHECK(!std::ifstream("./resume_out.bin.ckpt").good());
+
+    // Без попыток переподключения запуск прерывается, выходной файл не появляется
+    std::remove("./resume_out.bin");
+    listener = listenLocal(port);
+    proxy = std::thread(runDroppingProxy, listener, 3000, 1, 1);
+    NetworkManager dropManager("127.0.0.1", port);
+    ResumableCalc interrupted(ioManager, dropManager, credentials,
+                              "./resume_in.bin", "./resume_out.bin", 400, false, 0);
+    CHECK_THROW(interrupted.run(), NetworkError);
+    dropManager.close();
+    proxy.join();
+    close(listener);
+    CHECK(!std::ifstream("./resume_out.bin").good());
+    uint64_t checkpoints = interrupted.stats().checkpoints;
+    CHECK(checkpoints > 0);
+
+    // Следующий запуск продолжает с контрольной точки
+    NetworkManager nextManager("127.0.0.1", 33333);
+    ResumableCalc next(ioManager, nextManager, credentials,
+                       "./resume_in.bin", "./resume_out.bin", 400, false, 0);
+    next.run();
+    nextManager.close();
+    CHECK_EQUAL(checkpoints * 10, next.stats().resumed_from);
+    CHECK(readOutput() == expected);
+
+    std::remove("./resume_in.bin");
+    std::remove("./resume_out.bin");
+}
+
+// Тест для локального вычисления и выборочной проверки: результаты совпадают с сервером
+TEST(LocalEngineVerifier)
+{
+    IOManager ioManager(
+        "./config/vclient.conf",
+        "./input.bin", "./output.bin");
+    VectorBatch data = ioManager.read();
+
+    NetworkManager netManager("127.0.0.1", 33333);
+    netManager.conn();
+    netManager.auth("user", "P@ssW0rd");
+    std::vector<uint32_t> expected = netManager.calc(data);
+
+    // Несколько потоков делят порцию по количеству значений
+    LocalEngine engine(4);
+    CHECK(engine.calc(data) == expected);
+    CHECK(LocalEngine(1).calc(data) == expected);
+
+    // При доле 1 проверяются все результаты, при доле 0 - ни одного
+    ResultVerifier verifier(1.0, 2);
+    netManager.setVerifier(&verifier);
+    CHECK(netManager.calc(data) == expected);
+    CHECK(netManager.calc(VectorBatch({{0xFFFFFFFFu, 1}, {}})) == std::vector<uint32_t>({0xFFFFFFFFu, 0}));
+    netManager.setVerifier(nullptr);
+    netManager.close();
+    verifier.finish();
+    CHECK_EQUAL((uint64_t)(data.size() + 2), verifier.checked());
+    CHECK_EQUAL((uint64_t)0, verifier.mismatches());
+    CHECK(!ResultVerifier(0.0, 1).sampled(0));
+
+    // Неверный результат сервера обнаруживается
+    ResultVerifier strict(1.0, 1);
+    std::vector<uint32_t> values = {1, 2, 3};
+    BasicVectorView<uint32_t> view = {values.data(), 3};
+    std::vector<uint32_t> wrong = {7};
+    strict.submit(strict.prepare(&view, 1, 0), wrong.data());
+    strict.finish();
+    CHECK_EQUAL((uint64_t)1, strict.mismatches());
+}
+
+// Тест для распределения векторов между сессиями
+TEST(ShardedCalcSessionCount)
+{
+    // 10 векторов порциями по 3: порции 0,2 - сессия 0; порции 1,3 - сессия 1
+    CHECK_EQUAL((uint32_t)6, ShardedCalc::sessionCount(10, 3, 2, 0));
+    CHECK_EQUAL((uint32_t)4, ShardedCalc::sessionCount(10, 3, 2, 1));
+
+    // Сессиям без порций не достаётся векторов
+    CHECK_EQUAL((uint32_t)2, ShardedCalc::sessionCount(2, 4, 3, 0));
+    CHECK_EQUAL((uint32_t)0, ShardedCalc::sessionCount(2, 4, 3, 2));
+}
+
+// Тест для восстановления порядка результатов
+TEST(ReorderBufferOrder)
+{
+    ReorderBuffer reorder(4);
+    CHECK(reorder.push(2, {3}));
+    CHECK(reorder.push(0, {1}));
+    CHECK(reorder.push(1, {2}));
+
+    std::vector<uint32_t> results;
+    for (uint32_t i = 1; i <= 3; ++i)
+    {
+        CHECK(reorder.pop(results));
+        CHECK_EQUAL((size_t)1, results.size());
+        CHECK_EQUAL(i, results[0]);
+    }
+
+    reorder.abort();
+    CHECK(!reorder.pop(results));
+}
+
+// Тест для обработки через несколько подключений
+TEST(NetworkManagerSharded)
+{
+    IOManager ioManager(
+        "./config/vclient.conf",
+        "./input.bin", "./sharded.bin");
+    ShardedCalc sharded(ioManager, "127.0.0.1", 33333, ioManager.conf(), 2, 1, SIZE_MAX, 2, false);
+    sharded.run();
+
+    // Проверяем, что результаты совпадают с последовательной обработкой
+    NetworkManager seqManager("127.0.0.1", 33333);
+    seqManager.conn();
+    seqManager.auth("user", "P@ssW0rd");
+    std::vector<uint32_t> expected = seqManager.calc(ioManager.read());
+    seqManager.close();
+
+    std::ifstream output("./sharded.bin", std::ios::binary);
+    uint32_t count = 0;
+    output.read(reinterpret_cast<char *>(&count), sizeof(count));
+    std::vector<uint32_t> results(count);
+    output.read(reinterpret_cast<char *>(results.data()), count * sizeof(uint32_t));
+    output.close();
+    CHECK(expected == results);
+
+    // Порции больше ограничения памяти отправляются частями в свою сессию
+    ShardedCalc limited(ioManager, "127.0.0.1", 33333, ioManager.conf(), 2, 4, 1, 2, false);
+    limited.run();
+    output.open("./sharded.bin", std::ios::binary);
+    output.read(reinterpret_cast<char *>(&count), sizeof(count));
+    results.assign(count, 0);
+    output.read(reinterpret_cast<char *>(results.data()), count * sizeof(uint32_t));
+    output.close();
+    CHECK(expected == results);
+
+    std::remove("./sharded.bin");
+}
+
+// Тест для обработки заданий демоном с заранее открытыми сессиями
+TEST(SessionDaemonJobs)
+{
+    IOManager ioManager(
+        "./config/vclient.conf",
+        "./input.bin", "./output.bin");
+    SessionDaemon daemon("./config/vclient.conf", "127.0.0.1", 33333, ioManager.conf(), "./test.sock", 2, 1024);
+    std::thread daemon_thread([&]
+                              { daemon.run(); });
+
+    // Подключение к Unix-сокету демона (с ожиданием его запуска)
+    struct sockaddr_un addr;
+    std::memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    std::strcpy(addr.sun_path, "./test.sock");
+    int fd = -1;
+    for (int attempt = 0; attempt < 100 && fd < 0; ++attempt)
+    {
+        fd = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (connect(fd, (struct sockaddr *)&addr, sizeof(addr)) < 0)
+        {
+            close(fd);
+            fd = -1;
+            usleep(10000);
+        }
+    }
+    CHECK(fd >= 0);
+
+    // Несколько заданий подряд и одно с ошибкой
+    std::string jobs = "./input.bin ./daemon1.bin\n./input.bin ./daemon2.bin\n./missing.bin ./daemon3.bin\n";
+    send(fd, jobs.data(), jobs.size(), 0);
+    std::string replies;
+    char buffer[256];
+    while (std::count(replies.begin(), replies.end(), '\n') < 3)
+    {
+        ssize_t got = recv(fd, buffer, sizeof(buffer), 0);
+        if (got <= 0)
+            break;
+        replies.append(buffer, got);
+    }
+    close(fd);
+    SessionDaemon::stop();
+    daemon_thread.join();
+
+    std::istringstream lines(replies);
+    std::string line;
+    std::getline(lines, line);
+    CHECK_EQUAL(0u, line.find("OK "));
+    std::getline(lines, line);
+    CHECK_EQUAL(0u, line.find("OK "));
+    std::getline(lines, line);
+    CHECK_EQUAL(0u, line.find("ERR "));
+
+    // Проверяем, что результаты совпадают с последовательной обработкой
+    NetworkManager seqManager("127.0.0.1", 33333);
+    seqManager.conn();
+    seqManager.auth("user", "P@ssW0rd");
+    std::vector<uint32_t> expected = seqManager.calc(ioManager.read());
+    seqManager.close();
+
+    std::ifstream output("./daemon2.bin", std::ios::binary);
+    uint32_t count = 0;
+    output.read(reinterpret_cast<char *>(&count), sizeof(count));
+    std::vector<uint32_t> results(count);
+    output.read(reinterpret_cast<char *>(results.data()), count * sizeof(uint32_t));
+    output.close();
+    CHECK(expected == results);
+
+    std::remove("./daemon1.bin");
+    std::remove("./daemon2.bin");
+    std::remove("./daemon3.bin");
+}
+
+// Тест для повтора задания демона, сессию которого сервер закрыл в пуле
+TEST(SessionDaemonRetry)
+{
+    IOManager ioManager(
+        "./config/vclient.conf",
+        "./input.bin", "./output.bin");
+
+    // Прокси обрывает первое соединение сразу после аутентификации, третье остаётся в пуле
+    uint16_t port;
+    int listener = listenLocal(port);
+    std::thread proxy(runDroppingProxy, listener, 4 + SALT_HEX_LENGTH + HASH_HEX_LENGTH, 1, 3);
+    SessionDaemon daemon("./config/vclient.conf", "127.0.0.1", port, ioManager.conf(), "./retry.sock", 1, 1024);
+    std::thread daemon_thread([&]
+                              { daemon.run(); });
+
+    // Подключение к Unix-сокету демона (с ожиданием его запуска)
+    struct sockaddr_un addr;
+    std::memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    std::strcpy(addr.sun_path, "./retry.sock");
+    int fd = -1;
+    for (int attempt = 0; attempt < 100 && fd < 0; ++attempt)
+    {
+        fd = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (connect(fd, (struct sockaddr *)&addr, sizeof(addr)) < 0)
+        {
+            close(fd);
+            fd = -1;
+            usleep(10000);
+        }
+    }
+    CHECK(fd >= 0);
+
+    std::string job = "./input.bin ./daemon_retry.bin\n";
+    send(fd, job.data(), job.size(), 0);
+    std::string reply;
+    char buffer[256];
+    while (reply.find('\n') == std::string::npos)
+    {
+        ssize_t got = recv(fd, buffer, sizeof(buffer), 0);
+        if (got <= 0)
+            break;
+        reply.append(buffer, got);
+    }
+    close(fd);
+    SessionDaemon::stop();
+    daemon_thread.join();
+    proxy.join();
+    close(listener);
+
+    NetworkManager seqManager("127.0.0.1", 33333);
+    seqManager.conn();
+    seqManager.auth("user", "P@ssW0rd");
+    std::vector<uint32_t> expected = seqManager.calc(ioManager.read());
+    seqManager.close();
+
+    std::ifstream output("./daemon_retry.bin", std::ios::binary);
+    uint32_t count = 0;
+    output.read(reinterpret_cast<char *>(&count), sizeof(count));
+    std::vector<uint32_t> results(count);
+    output.read(reinterpret_cast<char *>(results.data()), count * sizeof(uint32_t));
+    output.close();
+    CHECK_EQUAL(0u, reply.find("OK "));
+    CHECK(expected == results);
+
+    std::remove("./daemon_retry.bin");
+}
+
+// Тест для перехвата заданий из чужой очереди
+TEST(WorkStealingQueuesSteal)
+{
+    WorkStealingQueues queues(2);
+    queues.push(0, 1);
+    queues.push(0, 2);
+    queues.push(0, 3);
+
+    // Владелец берёт задания с начала, второй поток перехватывает с конца
+    size_t job;
+    CHECK(queues.pop(0, job));
+    CHECK_EQUAL((size_t)1, job);
+    CHECK(queues.pop(1, job));
+    CHECK_EQUAL((size_t)3, job);
+    CHECK(queues.pop(1, job));
+    CHECK_EQUAL((size_t)2, job);
+    CHECK(!queues.pop(0, job));
+    CHECK_EQUAL((uint64_t)2, queues.steals());
+}
+
+// Тест для обработки заданий манифеста
+TEST(ManifestRunnerJobs)
+{
+    std::ofstream manifest("./test_manifest.txt");
+    manifest << "# input output\n\n"
+             << "./input.bin ./manifest1.bin\n"
+             << "./input.bin ./manifest2.bin\n"
+             << "./missing.bin ./manifest3.bin\n";
+    manifest.close();
+
+    std::vector<ManifestJob> jobs = readManifest("./test_manifest.txt");
+    CHECK_EQUAL((size_t)3, jobs.size());
+
+    IOManager ioManager(
+        "./config/vclient.conf",
+        "./input.bin", "./output.bin");
+    ManifestRunner runner("./config/vclient.conf", "127.0.0.1", 33333, ioManager.conf(), jobs, 2, 1024);
+    CHECK_EQUAL((size_t)1, runner.run());
+
+    // Проверяем, что результаты совпадают с последовательной обработкой
+    NetworkManager seqManager("127.0.0.1", 33333);
+    seqManager.conn();
+    seqManager.auth("user", "P@ssW0rd");
+    std::vector<uint32_t> expected = seqManager.calc(ioManager.read());
+    seqManager.close();
+
+    auto checkOutputs = [&]()
+    {
+        for (const char *path : {"./manifest1.bin", "./manifest2.bin"})
+        {
+            std::ifstream output(path, std::ios::binary);
+            uint32_t count = 0;
+            output.read(reinterpret_cast<char *>(&count), sizeof(count));
+            std::vector<uint32_t> results(count);
+            output.read(reinterpret_cast<char *>(results.data()), count * sizeof(uint32_t));
+            CHECK(expected == results);
+            std::remove(path);
+        }
+    };
+    checkOutputs();
+
+    // Один поток выполняет все задания отдельными вычислениями в одной сессии
+    ManifestRunner single("./config/vclient.conf", "127.0.0.1", 33333, ioManager.conf(), jobs, 1, 1024);
+    CHECK_EQUAL((size_t)1, single.run());
+    checkOutputs();
+
+    std::remove("./manifest3.bin");
+    std::remove("./test_manifest.txt");
 }
 
 // Тест для ошибки соединения
@@ -204,7 +1609,7 @@ TEST(NetworkManagerClose)
 // Тест для проверки корректной обработки параметров
 TEST(UserInterfaceCorrectArgs)
 {
-    const char *argv[] = {"vclient", "-a", "192.168.0.1", "-p", "8080", "-i", "input.bin", "-o", "output.bin", "-c", "config.conf"};
+    const char *argv[] = {"vclient", "-a", "192.168.0.1", "-p", "8080", "-i", "input.bin", "-o", "output.bin", "-c", "config.conf", "-m", "4096", "-t", "double"};
     int argc = sizeof(argv) / sizeof(argv[0]);
 
     UserInterface ui(argc, const_cast<char **>(argv));
@@ -215,6 +1620,8 @@ TEST(UserInterfaceCorrectArgs)
     CHECK_EQUAL(std::string("input.bin"), ui.getInputPath());
     CHECK_EQUAL(std::string("output.bin"), ui.getOutputPath());
     CHECK_EQUAL(std::string("config.conf"), ui.getConfigPath());
+    CHECK_EQUAL((size_t)4096, ui.getMemoryLimit());
+    CHECK(ui.getDataType() == DataType::DOUBLE);
 }
 
 // Тест для проверки отсутствия обязательного параметра input
@@ -262,6 +1669,126 @@ TEST(UserInterfaceMissingConfigValue)
     CHECK_THROW(UserInterface ui(argc, const_cast<char **>(argv)), ArgsDecodeError);
 }
 
+// Тест для проверки отсутствия значения для параметра memory
+TEST(UserInterfaceMissingMemoryValue)
+{
+    const char *argv[] = {"vclient", "-m"};
+    int argc = sizeof(argv) / sizeof(argv[0]);
+
+    CHECK_THROW(UserInterface ui(argc, const_cast<char **>(argv)), ArgsDecodeError);
+}
+
+// Тест для проверки несовместимых режимов обработки
+TEST(UserInterfaceConnectionsConflict)
+{
+    const char *argv[] = {"vclient", "-i", "input.bin", "-o", "output.bin", "--connections", "2", "--mmap"};
+    int argc = sizeof(argv) / sizeof(argv[0]);
+
+    CHECK_THROW(UserInterface ui(argc, const_cast<char **>(argv)), ArgsDecodeError);
+}
+
+// Тест для проверки неподдерживаемого типа значений
+TEST(UserInterfaceUnsupportedType)
+{
+    const char *argv[] = {"vclient", "-i", "input.bin", "-o", "output.bin", "--type", "int8_t"};
+    int argc = sizeof(argv) / sizeof(argv[0]);
+
+    CHECK_THROW(UserInterface ui(argc, const_cast<char **>(argv)), ArgsDecodeError);
+}
+
+// Тест для проверки уровня журнала
+TEST(UserInterfaceLogLevel)
+{
+    const char *argv[] = {"vclient", "-i", "input.bin", "-o", "output.bin", "--log-level", "off"};
+    int argc = sizeof(argv) / sizeof(argv[0]);
+
+    UserInterface ui(argc, const_cast<char **>(argv));
+    CHECK(ui.getLogLevel() == LogLevel::OFF);
+    CHECK(!Logger::enabled(LogLevel::ERROR));
+    Logger::setLevel(LogLevel::INFO);
+
+    const char *bad_argv[] = {"vclient", "-i", "input.bin", "-o", "output.bin", "--log-level", "loud"};
+    CHECK_THROW(UserInterface bad_ui(argc, const_cast<char **>(bad_argv)), ArgsDecodeError);
+}
+
+// Тест для проверки пути временной шкалы
+TEST(UserInterfaceTrace)
+{
+    const char *argv[] = {"vclient", "-i", "input.bin", "-o", "output.bin", "--trace", "trace.json"};
+    int argc = sizeof(argv) / sizeof(argv[0]);
+
+    UserInterface ui(argc, const_cast<char **>(argv));
+    CHECK_EQUAL("trace.json", ui.getTracePath());
+
+    const char *bad_argv[] = {"vclient", "-i", "input.bin", "-o", "output.bin", "--trace"};
+    CHECK_THROW(UserInterface bad_ui(argc - 1, const_cast<char **>(bad_argv)), ArgsDecodeError);
+}
+
+// Тест для проверки параметров кеша результатов
+TEST(UserInterfaceCache)
+{
+    const char *argv[] = {"vclient", "-i", "input.bin", "-o", "output.bin", "--cache", "cache.bin", "--cache-size", "4096"};
+    int argc = sizeof(argv) / sizeof(argv[0]);
+
+    UserInterface ui(argc, const_cast<char **>(argv));
+    CHECK_EQUAL("cache.bin", ui.getCachePath());
+
+    const char *bad_argv[] = {"vclient", "-i", "input.bin", "-o", "output.bin", "--cache"};
+    CHECK_THROW(UserInterface bad_ui(6, const_cast<char **>(bad_argv)), ArgsDecodeError);
+}
+
+// Тест для проверки флага устранения повторов
+TEST(UserInterfaceDedup)
+{
+    const char *argv[] = {"vclient", "-i", "input.bin", "-o", "output.bin", "--dedup"};
+    int argc = sizeof(argv) / sizeof(argv[0]);
+
+    UserInterface ui(argc, const_cast<char **>(argv));
+    CHECK(ui.getDedupFlag());
+
+    UserInterface plain_ui(argc - 1, const_cast<char **>(argv));
+    CHECK(!plain_ui.getDedupFlag());
+}
+
+// Тест для проверки флага инкрементальной обработки
+TEST(UserInterfaceIncremental)
+{
+    const char *argv[] = {"vclient", "-i", "input.bin", "-o", "output.bin", "--incremental", "--pipeline"};
+    int argc = sizeof(argv) / sizeof(argv[0]);
+
+    UserInterface ui(argc - 1, const_cast<char **>(argv));
+    CHECK(ui.getIncrementalFlag());
+    CHECK_THROW(UserInterface bad_ui(argc, const_cast<char **>(argv)), ArgsDecodeError);
+}
+
+// Тест для проверки параметров обработки с контрольными точками
+TEST(UserInterfaceResume)
+{
+    const char *argv[] = {"vclient", "-i", "input.bin", "-o", "output.bin", "--resume", "--retries", "9", "--mmap"};
+    int argc = sizeof(argv) / sizeof(argv[0]);
+
+    UserInterface ui(argc - 1, const_cast<char **>(argv));
+    CHECK_EQUAL(9u, ui.getRetries());
+    CHECK_THROW(UserInterface bad_ui(argc, const_cast<char **>(argv)), ArgsDecodeError);
+}
+
+// Тест для проверки параметров локального вычисления и выборочной проверки
+TEST(UserInterfaceLocal)
+{
+    const char *argv[] = {"vclient", "-i", "input.bin", "-o", "output.bin", "--local", "--mmap", "--dedup"};
+    int argc = sizeof(argv) / sizeof(argv[0]);
+
+    UserInterface ui(argc - 1, const_cast<char **>(argv));
+    CHECK(ui.getLocalFlag());
+    CHECK_THROW(UserInterface bad_ui(argc, const_cast<char **>(argv)), ArgsDecodeError);
+
+    const char *verify_argv[] = {"vclient", "-i", "input.bin", "-o", "output.bin", "--verify-sample", "0.25", "--pipeline"};
+    UserInterface verify_ui(8, const_cast<char **>(verify_argv));
+    CHECK_CLOSE(0.25, verify_ui.getVerifySample(), 1e-9);
+    verify_argv[6] = "1.5";
+    CHECK_THROW(UserInterface bad_verify_ui(8, const_cast<char **>(verify_argv)), ArgsDecodeError);
+}
+
 // Тест для проверки неизвестного параметра
 TEST(UserInterfaceUnknownParam)
 {